@@ -0,0 +1,303 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "BatchedGTPaseIntegrator.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+/**
+ * Parse a number field of a data file, allowing surrounding white space.
+ *
+ * @param rField the field
+ * @param rFileName the file, for the error message
+ * @param lineNumber the line of the field, for the error message
+ * @return the number
+ */
+double ParseNumberField(const std::string& rField, const std::string& rFileName, unsigned lineNumber)
+{
+    char* p_end;
+    double value = std::strtod(rField.c_str(), &p_end);
+    bool parsed = (p_end != rField.c_str());
+    while (*p_end == ' ' || *p_end == '\t' || *p_end == '\r')
+    {
+        p_end++;
+    }
+    if (!parsed || *p_end != '\0')
+    {
+        std::stringstream message;
+        message << rFileName << " line " << lineNumber << ": " << rField << " is not a number";
+        EXCEPTION(message.str());
+    }
+    return value;
+}
+}
+
+AreaSignal::AreaSignal(double mean, double amplitude, double period)
+    : mMean(mean),
+      mAmplitude(amplitude),
+      mPeriod(period),
+      mLastInterval(0)
+{
+    assert(period > 0.0);
+}
+
+AreaSignal AreaSignal::LoadOneCellData(const std::string& rFileName)
+{
+    std::ifstream file(rFileName.c_str());
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open " + rFileName);
+    }
+
+    // Rows are "time<tab>,cell_id,area,target_area,..."
+    AreaSignal signal(0.0);
+    std::string line;
+    unsigned line_number = 0;
+    double sum = 0.0;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::vector<std::string> fields;
+        std::stringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, ','))
+        {
+            if (field.find_first_not_of(" \t") != std::string::npos)
+            {
+                fields.push_back(field);
+            }
+        }
+        if (fields.size() < 3)
+        {
+            continue;
+        }
+        signal.mTimes.push_back(ParseNumberField(fields[0], rFileName, line_number));
+        signal.mAreas.push_back(ParseNumberField(fields[2], rFileName, line_number));
+        sum += signal.mAreas.back();
+    }
+    if (signal.mTimes.empty())
+    {
+        EXCEPTION("No area data in " + rFileName);
+    }
+    signal.mMean = sum/signal.mAreas.size();
+    return signal;
+}
+
+double AreaSignal::GetArea(double time) const
+{
+    if (mTimes.empty())
+    {
+        return mAmplitude == 0.0 ? mMean : mMean + mAmplitude*sin(2.0*M_PI*time/mPeriod);
+    }
+    if (time <= mTimes.front())
+    {
+        return mAreas.front();
+    }
+    if (time >= mTimes.back())
+    {
+        return mAreas.back();
+    }
+    if (mLastInterval + 1 >= mTimes.size() || time < mTimes[mLastInterval])
+    {
+        mLastInterval = 0;
+    }
+    while (time > mTimes[mLastInterval + 1])
+    {
+        mLastInterval++;
+    }
+    double t0 = mTimes[mLastInterval];
+    double t1 = mTimes[mLastInterval + 1];
+    double s = t1 > t0 ? (time - t0)/(t1 - t0) : 0.0;
+    return mAreas[mLastInterval] + s*(mAreas[mLastInterval + 1] - mAreas[mLastInterval]);
+}
+
+double AreaSignal::GetMean() const
+{
+    return mMean;
+}
+
+unsigned BatchedGTPaseIntegrator::AddSignal(const AreaSignal& rSignal)
+{
+    mSignals.push_back(rSignal);
+    return mSignals.size() - 1;
+}
+
+unsigned BatchedGTPaseIntegrator::AddInstance(const GTPaseParameters& rParameters, unsigned signalIndex, double initialG, double initialTargetArea)
+{
+    assert(signalIndex < mSignals.size());
+    mBeta.push_back(rParameters.mBeta);
+    mBasalRate.push_back(rParameters.mBasalRate);
+    mFeedbackStrength.push_back(rParameters.mFeedbackStrength);
+    mTargetAreaRate.push_back(rParameters.mTargetAreaRate);
+    mTargetAreaScale.push_back(rParameters.mTargetAreaScale);
+    mTargetAreaReduction.push_back(rParameters.mTargetAreaReduction);
+    mHalfSaturation.push_back(rParameters.mHalfSaturation);
+    mTimeScale.push_back(rParameters.mTimeScale);
+    mSignalIndices.push_back(signalIndex);
+    mG.push_back(initialG);
+    mTargetArea.push_back(initialTargetArea);
+    return mG.size() - 1;
+}
+
+unsigned BatchedGTPaseIntegrator::GetNumInstances() const
+{
+    return mG.size();
+}
+
+void BatchedGTPaseIntegrator::EvaluateStage(const double* pG, const double* pTargetArea, const double* pArea,
+                                            double* __restrict__ pDG, double* __restrict__ pDTargetArea) const
+{
+    unsigned num_instances = mBeta.size();
+    for (unsigned i=0; i<num_instances; i++)
+    {
+        EvaluateGTPaseKinetics(mBeta[i], mBasalRate[i], mFeedbackStrength[i], mTargetAreaRate[i], mTargetAreaScale[i],
+                               mTargetAreaReduction[i], mHalfSaturation[i], mTimeScale[i], pG[i], pTargetArea[i], pArea[i],
+                               pDG[i], pDTargetArea[i]);
+    }
+}
+
+void BatchedGTPaseIntegrator::Solve(double endTime, double dt, double transientTime)
+{
+    unsigned num_instances = mG.size();
+    unsigned num_signals = mSignals.size();
+    unsigned num_steps = (unsigned)(endTime/dt + 0.5);
+
+    mMinG.assign(num_instances, 0.0);
+    mMaxG.assign(num_instances, 0.0);
+    mFirstMaximumTime.assign(num_instances, 0.0);
+    mLastMaximumTime.assign(num_instances, 0.0);
+    mNumMaxima.assign(num_instances, 0);
+    if (num_instances == 0)
+    {
+        return;
+    }
+
+    // Stage work arrays, one entry per instance
+    std::vector<double> g_stage(num_instances), target_area_stage(num_instances);
+    std::vector<double> k_g(num_instances), k_target_area(num_instances);
+    std::vector<double> sum_g(num_instances), sum_target_area(num_instances);
+    std::vector<double> previous_g(mG), previous_previous_g(mG);
+
+    // Areas of each signal at the start, middle and end of the step
+    std::vector<double> signal_areas(3*num_signals);
+    std::vector<double> areas(3*num_instances);
+
+    const double stage_weights[4] = {1.0, 2.0, 2.0, 1.0};
+    const double stage_offsets[4] = {0.0, 0.5, 0.5, 1.0};
+    const unsigned stage_area_index[4] = {0, 1, 1, 2};
+
+    bool measuring = false;
+    for (unsigned step=0; step<num_steps; step++)
+    {
+        double time = step*dt;
+
+        for (unsigned s=0; s<num_signals; s++)
+        {
+            signal_areas[3*s] = mSignals[s].GetArea(time);
+            signal_areas[3*s + 1] = mSignals[s].GetArea(time + 0.5*dt);
+            signal_areas[3*s + 2] = mSignals[s].GetArea(time + dt);
+        }
+        for (unsigned i=0; i<num_instances; i++)
+        {
+            unsigned s = mSignalIndices[i];
+            areas[i] = signal_areas[3*s];
+            areas[num_instances + i] = signal_areas[3*s + 1];
+            areas[2*num_instances + i] = signal_areas[3*s + 2];
+        }
+
+        for (unsigned i=0; i<num_instances; i++)
+        {
+            g_stage[i] = mG[i];
+            target_area_stage[i] = mTargetArea[i];
+            sum_g[i] = 0.0;
+            sum_target_area[i] = 0.0;
+        }
+
+        for (unsigned stage=0; stage<4; stage++)
+        {
+            const double* p_area = &areas[stage_area_index[stage]*num_instances];
+            EvaluateStage(&g_stage[0], &target_area_stage[0], p_area, &k_g[0], &k_target_area[0]);
+            double weight = stage_weights[stage];
+            double next_offset = stage < 3 ? stage_offsets[stage + 1]*dt : 0.0;
+            for (unsigned i=0; i<num_instances; i++)
+            {
+                sum_g[i] += weight*k_g[i];
+                sum_target_area[i] += weight*k_target_area[i];
+                g_stage[i] = mG[i] + next_offset*k_g[i];
+                target_area_stage[i] = mTargetArea[i] + next_offset*k_target_area[i];
+            }
+        }
+
+        for (unsigned i=0; i<num_instances; i++)
+        {
+            previous_previous_g[i] = previous_g[i];
+            previous_g[i] = mG[i];
+            mG[i] += dt*sum_g[i]/6.0;
+            mTargetArea[i] += dt*sum_target_area[i]/6.0;
+        }
+
+        // Measure after the transient; a maximum is detected one step late, at the previous time
+        double new_time = time + dt;
+        if (new_time >= transientTime)
+        {
+            for (unsigned i=0; i<num_instances; i++)
+            {
+                if (!measuring)
+                {
+                    mMinG[i] = mG[i];
+                    mMaxG[i] = mG[i];
+                }
+                mMinG[i] = std::min(mMinG[i], mG[i]);
+                mMaxG[i] = std::max(mMaxG[i], mG[i]);
+                if (measuring && previous_g[i] > previous_previous_g[i] && previous_g[i] >= mG[i])
+                {
+                    if (mNumMaxima[i] == 0)
+                    {
+                        mFirstMaximumTime[i] = time;
+                    }
+                    mLastMaximumTime[i] = time;
+                    mNumMaxima[i]++;
+                }
+            }
+            measuring = true;
+        }
+    }
+}
+
+double BatchedGTPaseIntegrator::GetG(unsigned instance) const
+{
+    return mG[instance];
+}
+
+double BatchedGTPaseIntegrator::GetTargetArea(unsigned instance) const
+{
+    return mTargetArea[instance];
+}
+
+double BatchedGTPaseIntegrator::GetAmplitude(unsigned instance) const
+{
+    return mMinG.empty() ? 0.0 : 0.5*(mMaxG[instance] - mMinG[instance]);
+}
+
+double BatchedGTPaseIntegrator::GetPeriod(unsigned instance) const
+{
+    if (mNumMaxima.empty() || mNumMaxima[instance] < 2)
+    {
+        return 0.0;
+    }
+    return (mLastMaximumTime[instance] - mFirstMaximumTime[instance])/(mNumMaxima[instance] - 1);
+}
@@ -0,0 +1,214 @@
+#ifndef BATCHEDGTPASEINTEGRATOR_HPP_
+#define BATCHEDGTPASEINTEGRATOR_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <string>
+#include <vector>
+
+#include "GTPaseKinetics.hpp"
+
+/**
+ * A prescribed cell area time series: constant, sinusoidal, or a trace
+ * (linearly interpolated, held constant beyond its ends).
+ */
+class AreaSignal
+{
+private:
+
+    /** The mean (or constant) area. */
+    double mMean;
+
+    /** The amplitude of the sinusoid, 0 for a constant. */
+    double mAmplitude;
+
+    /** The period of the sinusoid. */
+    double mPeriod;
+
+    /** The times of the trace, if any. */
+    std::vector<double> mTimes;
+
+    /** The areas of the trace, if any. */
+    std::vector<double> mAreas;
+
+    /** Index of the trace interval used last, as traces are read forwards in time. */
+    mutable unsigned mLastInterval;
+
+public:
+
+    /**
+     * Constructor for a constant or sinusoidal signal, mean + amplitude*sin(2*pi*t/period).
+     *
+     * @param mean the mean area
+     * @param amplitude the amplitude (default 0, constant)
+     * @param period the period (default 1)
+     */
+    AreaSignal(double mean, double amplitude=0.0, double period=1.0);
+
+    /**
+     * Load the area of one cell from a OneCellData.csv written by OneCellGTPaseWriter.
+     * A time or area field that is not a number is an error.
+     *
+     * @param rFileName the path of the file
+     * @return the signal
+     */
+    static AreaSignal LoadOneCellData(const std::string& rFileName);
+
+    /**
+     * @param time the time
+     * @return the area at that time
+     */
+    double GetArea(double time) const;
+
+    /** @return the mean area (of the trace, if any). */
+    double GetMean() const;
+};
+
+/**
+ * Integrates many independent ODESRN instances at once, each driven by a
+ * prescribed area signal instead of the vertex mechanics.
+ *
+ * The state and every parameter are stored as one array over all instances,
+ * and every RK4 stage is a single loop over instances calling the by-value
+ * EvaluateGTPaseKinetics() on elements of those arrays. That form writes the
+ * integer powers as multiplications, so results agree with ODESRN to rounding
+ * rather than bit for bit. With g++ -O3 the
+ * stage loop and the RK4 update loops are vectorized (checked with
+ * -fopt-info-vec); only the gather of the signal areas stays scalar. After a
+ * transient, the amplitude (half the range of G) and the period (mean time
+ * between successive maxima of G) are accumulated for each instance.
+ */
+class BatchedGTPaseIntegrator
+{
+private:
+
+    /** The area signals. */
+    std::vector<AreaSignal> mSignals;
+
+    /** The signal of each instance. */
+    std::vector<unsigned> mSignalIndices;
+
+    /** Beta of each instance. The parameters are stored one array per field, see GTPaseParameters. */
+    std::vector<double> mBeta;
+
+    /** The basal activation rate of each instance. */
+    std::vector<double> mBasalRate;
+
+    /** The feedback strength of each instance. */
+    std::vector<double> mFeedbackStrength;
+
+    /** The target area relaxation rate of each instance. */
+    std::vector<double> mTargetAreaRate;
+
+    /** The target area scale of each instance. */
+    std::vector<double> mTargetAreaScale;
+
+    /** The target area reduction of each instance. */
+    std::vector<double> mTargetAreaReduction;
+
+    /** The half saturation level of each instance. */
+    std::vector<double> mHalfSaturation;
+
+    /** The time scale of each instance. */
+    std::vector<double> mTimeScale;
+
+    /** G of each instance. */
+    std::vector<double> mG;
+
+    /** The target area of each instance. */
+    std::vector<double> mTargetArea;
+
+    /** The smallest G after the transient. */
+    std::vector<double> mMinG;
+
+    /** The largest G after the transient. */
+    std::vector<double> mMaxG;
+
+    /** The time of the first maximum of G after the transient. */
+    std::vector<double> mFirstMaximumTime;
+
+    /** The time of the last maximum of G after the transient. */
+    std::vector<double> mLastMaximumTime;
+
+    /** The number of maxima of G after the transient. */
+    std::vector<unsigned> mNumMaxima;
+
+    /**
+     * Evaluate the kinetics of every instance at one RK4 stage.
+     *
+     * The outputs are __restrict__ as they never overlap the inputs. Without
+     * that, g++ needs a run-time overlap check of each output against every
+     * input array, more than it allows (vect-max-version-for-alias-checks),
+     * and leaves the loop scalar.
+     *
+     * @param pG G of each instance
+     * @param pTargetArea the target area of each instance
+     * @param pArea the area of each instance
+     * @param pDG filled with dG/dt of each instance
+     * @param pDTargetArea filled with d(target area)/dt of each instance
+     */
+    void EvaluateStage(const double* pG, const double* pTargetArea, const double* pArea,
+                       double* __restrict__ pDG, double* __restrict__ pDTargetArea) const;
+
+public:
+
+    /**
+     * Add an area signal.
+     *
+     * @param rSignal the signal
+     * @return the index of the signal
+     */
+    unsigned AddSignal(const AreaSignal& rSignal);
+
+    /**
+     * Add an instance.
+     *
+     * @param rParameters the kinetic parameters
+     * @param signalIndex the index of its area signal
+     * @param initialG the initial G
+     * @param initialTargetArea the initial target area
+     * @return the index of the instance
+     */
+    unsigned AddInstance(const GTPaseParameters& rParameters, unsigned signalIndex, double initialG, double initialTargetArea);
+
+    /** @return the number of instances. */
+    unsigned GetNumInstances() const;
+
+    /**
+     * Integrate all instances from t=0 with the classical RK4 method.
+     *
+     * @param endTime the end time
+     * @param dt the time step
+     * @param transientTime the time after which the amplitude and period are measured
+     */
+    void Solve(double endTime, double dt, double transientTime);
+
+    /**
+     * @param instance the instance
+     * @return the final G
+     */
+    double GetG(unsigned instance) const;
+
+    /**
+     * @param instance the instance
+     * @return the final target area
+     */
+    double GetTargetArea(unsigned instance) const;
+
+    /**
+     * @param instance the instance
+     * @return half the range of G after the transient
+     */
+    double GetAmplitude(unsigned instance) const;
+
+    /**
+     * @param instance the instance
+     * @return the mean time between maxima of G after the transient, or 0 if there were fewer than two
+     */
+    double GetPeriod(unsigned instance) const;
+};
+
+#endif /*BATCHEDGTPASEINTEGRATOR_HPP_*/
@@ -0,0 +1,98 @@
+#ifndef GTPASEKINETICS_HPP_
+#define GTPASEKINETICS_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cmath>
+
+/**
+ * The parameters of the GTPase / target area kinetics of one cell.
+ */
+struct GTPaseParameters
+{
+    /** Bifurcation parameter: strength of the area-dependent activation. */
+    double mBeta;
+    /** Basal activation rate. */
+    double mBasalRate;
+    /** Strength of the positive feedback of G on its own activation. */
+    double mFeedbackStrength;
+    /** Relaxation rate of the target area. */
+    double mTargetAreaRate;
+    /** Target area with no active GTPase. */
+    double mTargetAreaScale;
+    /** Maximal fractional reduction of the target area by G. */
+    double mTargetAreaReduction;
+    /** Level of G at which the target area reduction is half maximal. */
+    double mHalfSaturation;
+    /** Time scale of both equations. */
+    double mTimeScale;
+};
+
+/**
+ * Evaluate the right-hand side of the GTPase and target area equations, with
+ * each parameter passed by value so that a loop over arrays of parameters
+ * (see BatchedGTPaseIntegrator) can be vectorized once this is inlined.
+ * The integer powers are written as multiplications, as pow() is a library
+ * call that the compiler does not expand without -ffast-math. These round
+ * differently from pow() in the last bits, so this form is only used by the
+ * batched screen; ODESRN uses the overload below.
+ *
+ * @param beta see GTPaseParameters::mBeta
+ * @param basalRate see GTPaseParameters::mBasalRate
+ * @param feedbackStrength see GTPaseParameters::mFeedbackStrength
+ * @param targetAreaRate see GTPaseParameters::mTargetAreaRate
+ * @param targetAreaScale see GTPaseParameters::mTargetAreaScale
+ * @param targetAreaReduction see GTPaseParameters::mTargetAreaReduction
+ * @param halfSaturation see GTPaseParameters::mHalfSaturation
+ * @param timeScale see GTPaseParameters::mTimeScale
+ * @param g the GTPase concentration G
+ * @param targetArea the target area
+ * @param area the cell area
+ * @param rDG filled with dG/dt
+ * @param rDTargetArea filled with d(target area)/dt
+ */
+inline void EvaluateGTPaseKinetics(double beta, double basalRate, double feedbackStrength, double targetAreaRate,
+                                   double targetAreaScale, double targetAreaReduction, double halfSaturation,
+                                   double timeScale, double g, double targetArea, double area,
+                                   double& rDG, double& rDTargetArea)
+{
+    double g2 = g*g;
+    double g4 = g2*g2;
+    double area2 = area*area;
+    double area8 = area2*area2*area2*area2;
+    double area10 = area8*area2;
+    double target_area2 = targetArea*targetArea;
+    double target_area8 = target_area2*target_area2*target_area2*target_area2;
+    double target_area10 = target_area8*target_area2;
+    double half_saturation2 = halfSaturation*halfSaturation;
+    double half_saturation4 = half_saturation2*half_saturation2;
+    rDG = ((basalRate + beta*(area10/(target_area10 + area10)) + feedbackStrength*(g4/(1 + g4)))*(2 - g) - g)*timeScale;
+    rDTargetArea = (-targetAreaRate*(targetArea - targetAreaScale*
+                    (1 - targetAreaReduction*(g4/(half_saturation4 + g4)))))*timeScale;
+}
+
+/**
+ * Evaluate the right-hand side of the GTPase and target area equations.
+ *
+ * @param rParameters the parameters of the cell
+ * @param g the GTPase concentration G
+ * @param targetArea the target area
+ * @param area the cell area
+ * @param rDG filled with dG/dt
+ * @param rDTargetArea filled with d(target area)/dt
+ */
+inline void EvaluateGTPaseKinetics(const GTPaseParameters& rParameters, double g, double targetArea, double area,
+                                   double& rDG, double& rDTargetArea)
+{
+    double g4 = pow(g, 4);
+    double area10 = pow(area, 10);
+    rDG = ((rParameters.mBasalRate + rParameters.mBeta*(area10/(pow(targetArea, 10) + area10))
+            + rParameters.mFeedbackStrength*(g4/(1 + g4)))*(2 - g) - g)*rParameters.mTimeScale;
+    rDTargetArea = (-rParameters.mTargetAreaRate*(targetArea - rParameters.mTargetAreaScale*
+                    (1 - rParameters.mTargetAreaReduction*(g4/(pow(rParameters.mHalfSaturation, 4) + g4)))))*rParameters.mTimeScale;
+}
+
+#endif /*GTPASEKINETICS_HPP_*/
@@ -0,0 +1,128 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "GTPaseParameterTable.hpp"
+#include "Exception.hpp"
+#include <cassert>
+
+namespace
+{
+/** The names of the parameters, indexed by GTPaseParameterTable::Parameter. */
+const char* PARAMETER_NAMES[GTPaseParameterTable::NUM_PARAMETERS] =
+{
+    "beta", "basal_rate", "feedback_strength", "target_area_rate",
+    "target_area_scale", "target_area_reduction", "half_saturation", "time_scale"
+};
+
+/** The default values, indexed by GTPaseParameterTable::Parameter. */
+const double DEFAULT_VALUES[GTPaseParameterTable::NUM_PARAMETERS] =
+{
+    0.2, 0.1, 1.5, 0.1, 1.15, 0.75, 0.3, 0.25
+};
+}
+
+GTPaseParameterTable* GTPaseParameterTable::mpInstance = NULL;
+
+GTPaseParameterTable::GTPaseParameterTable()
+{
+    Reset();
+}
+
+GTPaseParameterTable* GTPaseParameterTable::Instance()
+{
+    if (mpInstance == NULL)
+    {
+        mpInstance = new GTPaseParameterTable();
+    }
+    return mpInstance;
+}
+
+void GTPaseParameterTable::Destroy()
+{
+    delete mpInstance;
+    mpInstance = NULL;
+}
+
+void GTPaseParameterTable::Reset()
+{
+    for (unsigned p=0; p<NUM_PARAMETERS; p++)
+    {
+        mValues[p].assign(1, DEFAULT_VALUES[p]);
+    }
+}
+
+void GTPaseParameterTable::SetGlobalValue(Parameter parameter, double value)
+{
+    assert(parameter < NUM_PARAMETERS);
+    mValues[parameter].assign(mValues[parameter].size(), value);
+}
+
+void GTPaseParameterTable::SetCellValue(Parameter parameter, unsigned cellId, double value)
+{
+    assert(parameter < NUM_PARAMETERS);
+    unsigned slot = cellId + 1;
+    if (slot >= mValues[0].size())
+    {
+        // Keep all arrays the same length, new slots taking the global values
+        for (unsigned p=0; p<NUM_PARAMETERS; p++)
+        {
+            mValues[p].resize(slot + 1, mValues[p][0]);
+        }
+    }
+    mValues[parameter][slot] = value;
+}
+
+double GTPaseParameterTable::GetValue(Parameter parameter, unsigned slot) const
+{
+    assert(parameter < NUM_PARAMETERS);
+    return slot < mValues[parameter].size() ? mValues[parameter][slot] : mValues[parameter][0];
+}
+
+void GTPaseParameterTable::GetParameters(unsigned slot, GTPaseParameters& rParameters) const
+{
+    if (slot >= mValues[0].size())
+    {
+        slot = 0;
+    }
+    rParameters.mBeta = mValues[BETA][slot];
+    rParameters.mBasalRate = mValues[BASAL_RATE][slot];
+    rParameters.mFeedbackStrength = mValues[FEEDBACK_STRENGTH][slot];
+    rParameters.mTargetAreaRate = mValues[TARGET_AREA_RATE][slot];
+    rParameters.mTargetAreaScale = mValues[TARGET_AREA_SCALE][slot];
+    rParameters.mTargetAreaReduction = mValues[TARGET_AREA_REDUCTION][slot];
+    rParameters.mHalfSaturation = mValues[HALF_SATURATION][slot];
+    rParameters.mTimeScale = mValues[TIME_SCALE][slot];
+}
+
+const std::vector<double>& GTPaseParameterTable::rGetValues(Parameter parameter) const
+{
+    assert(parameter < NUM_PARAMETERS);
+    return mValues[parameter];
+}
+
+unsigned GTPaseParameterTable::GetNumSlots() const
+{
+    return mValues[0].size();
+}
+
+GTPaseParameterTable::Parameter GTPaseParameterTable::GetParameterFromName(const std::string& rName)
+{
+    unsigned p = 0;
+    while (p < NUM_PARAMETERS && rName != PARAMETER_NAMES[p])
+    {
+        p++;
+    }
+    if (p == NUM_PARAMETERS)
+    {
+        EXCEPTION("Unknown GTPase parameter " + rName);
+    }
+    return (Parameter)p;
+}
+
+std::string GTPaseParameterTable::GetParameterName(Parameter parameter)
+{
+    assert(parameter < NUM_PARAMETERS);
+    return PARAMETER_NAMES[parameter];
+}
@@ -0,0 +1,118 @@
+#ifndef GTPASEPARAMETERTABLE_HPP_
+#define GTPASEPARAMETERTABLE_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <string>
+#include <vector>
+
+#include "GTPaseKinetics.hpp"
+
+/**
+ * Singleton holding the parameters of ODESRN, globally or per cell.
+ *
+ * Each parameter is one dense array indexed by slot: slot 0 holds the global
+ * value and slot (cell ID + 1) the value for that cell. Cells beyond the end
+ * of the arrays use the global values. Setting a global value overwrites it
+ * for every cell, so global values should be set before per-cell ones.
+ *
+ * The defaults are the values formerly hard-coded in ODESRN.
+ */
+class GTPaseParameterTable
+{
+public:
+
+    /** The parameters, used to index the arrays. */
+    enum Parameter
+    {
+        BETA = 0,
+        BASAL_RATE,
+        FEEDBACK_STRENGTH,
+        TARGET_AREA_RATE,
+        TARGET_AREA_SCALE,
+        TARGET_AREA_REDUCTION,
+        HALF_SATURATION,
+        TIME_SCALE,
+        NUM_PARAMETERS
+    };
+
+private:
+
+    /** The single instance. */
+    static GTPaseParameterTable* mpInstance;
+
+    /** One dense array of values per parameter, indexed by slot. */
+    std::vector<double> mValues[NUM_PARAMETERS];
+
+    /** Private constructor; use Instance(). */
+    GTPaseParameterTable();
+
+public:
+
+    /** @return the single instance, created with the default values if needed. */
+    static GTPaseParameterTable* Instance();
+
+    /** Destroy the single instance. */
+    static void Destroy();
+
+    /** Restore the default global values and remove all per-cell values. */
+    void Reset();
+
+    /**
+     * Set the global value of a parameter, for all cells.
+     *
+     * @param parameter the parameter
+     * @param value the value
+     */
+    void SetGlobalValue(Parameter parameter, double value);
+
+    /**
+     * Set the value of a parameter for one cell.
+     *
+     * @param parameter the parameter
+     * @param cellId the cell ID
+     * @param value the value
+     */
+    void SetCellValue(Parameter parameter, unsigned cellId, double value);
+
+    /**
+     * @param parameter the parameter
+     * @param slot the slot (0 for the global value, cell ID + 1 for a cell)
+     * @return the value
+     */
+    double GetValue(Parameter parameter, unsigned slot) const;
+
+    /**
+     * Gather the parameters of one slot.
+     *
+     * @param slot the slot (0 for the global values, cell ID + 1 for a cell)
+     * @param rParameters filled with the values
+     */
+    void GetParameters(unsigned slot, GTPaseParameters& rParameters) const;
+
+    /**
+     * @param parameter the parameter
+     * @return the dense array of values of the parameter, indexed by slot
+     */
+    const std::vector<double>& rGetValues(Parameter parameter) const;
+
+    /** @return the number of slots, including the global slot. */
+    unsigned GetNumSlots() const;
+
+    /**
+     * @param rName the name of a parameter, as used in scenario files (e.g. "beta")
+     * @return the parameter
+     */
+    static Parameter GetParameterFromName(const std::string& rName);
+
+    /**
+     * @param parameter the parameter
+     * @return the name of the parameter, as used in scenario files
+     */
+    static std::string GetParameterName(Parameter parameter);
+};
+
+#endif /*GTPASEPARAMETERTABLE_HPP_*/
@@ -0,0 +1,98 @@
+/*
+ * Rho GTPase Simulation
+ * Author: MoHan Zhang <mohan_z@hotmail.com>
+ * Last Modified: July 11, 2017
+ * Do not reproduce this code without permission.
+ */
+
+#include "ODESRN.hpp"
+#include "OdeSystemInformation.hpp"
+#include "GTPaseParameterTable.hpp"
+#include "FixedSizePool.hpp"
+
+namespace
+{
+/**
+ * @return the pool of all ODESRN systems. It is never destroyed, so that
+ *     systems still owned by cells at exit can be deleted safely.
+ */
+FixedSizePool& GetSystemPool()
+{
+    static FixedSizePool* p_pool = new FixedSizePool(sizeof(ODESRN));
+    return *p_pool;
+}
+}
+
+ODESRN::ODESRN()
+    : AbstractOdeSystem(3),
+      mParameterSlot(0)
+{
+    mpSystemInfo = OdeSystemInformation<ODESRN>::Instance();
+    GTPaseParameterTable::Instance()->GetParameters(mParameterSlot, mParameters);
+}
+
+void ODESRN::SetParameterSlot(unsigned parameterSlot)
+{
+    mParameterSlot = parameterSlot;
+    GTPaseParameterTable::Instance()->GetParameters(mParameterSlot, mParameters);
+}
+
+unsigned ODESRN::GetParameterSlot() const
+{
+    return mParameterSlot;
+}
+
+void ODESRN::EvaluateYDerivatives(double time, const std::vector<double>& rY,
+                                  std::vector<double>& rDY)
+{
+    // GTPase and target area eqns
+    EvaluateGTPaseKinetics(mParameters, rY[0], rY[1], rY[2], rDY[0], rDY[1]);
+	// Dummy eqn to get access to cell area, initially equal to 0.866025
+	rDY[2] = 0;
+}
+
+void* ODESRN::operator new(std::size_t size)
+{
+    if (size != sizeof(ODESRN))
+    {
+        return ::operator new(size);
+    }
+    return GetSystemPool().Allocate();
+}
+
+void ODESRN::operator delete(void* pSystem, std::size_t size)
+{
+    if (size != sizeof(ODESRN))
+    {
+        ::operator delete(pSystem);
+        return;
+    }
+    GetSystemPool().Deallocate(pSystem);
+}
+
+void ODESRN::ReservePool(unsigned numSystems)
+{
+    GetSystemPool().Reserve(numSystems);
+}
+
+template<>
+void OdeSystemInformation<ODESRN>::Initialise()
+{
+    this->mVariableNames.push_back("G");
+    this->mVariableUnits.push_back("dimensionless");
+    this->mInitialConditions.push_back(1);
+
+    this->mVariableNames.push_back("TARGET AREA");
+    this->mVariableUnits.push_back("dimensionless");
+    this->mInitialConditions.push_back(0.8);
+	
+    this->mVariableNames.push_back("AREA");
+    this->mVariableUnits.push_back("dimensionless");
+    this->mInitialConditions.push_back(0.8);
+
+    this->mInitialised = true;
+}
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+CHASTE_CLASS_EXPORT(ODESRN)
@@ -0,0 +1,98 @@
+#ifndef ODESRN_HPP_
+#define ODESRN_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Author: MoHan Zhang <mohan_z@hotmail.com>
+ * Last Modified: July 11, 2017
+ * Do not reproduce this code without permission.
+ */
+
+#include <cstddef>
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractOdeSystem.hpp"
+#include "GTPaseKinetics.hpp"
+
+/**
+ * Rho GTPase ODE system coupled to cell area.
+ *
+ * The state variables are the GTPase concentration G, the cell target area
+ * and the cell area (a dummy variable whose value is set each time step by
+ * ODEParameterAreaModifier).
+ *
+ * The kinetic parameters are kept in GTPaseParameterTable at mParameterSlot
+ * (0 for the global values, cell ID + 1 for per-cell values), which
+ * ODESrnModel sets from its cell before every solve. SetParameterSlot() copies
+ * them into mParameters, so the right-hand side does not look them up on
+ * every evaluation; changes to the table take effect at the next call.
+ */
+class ODESRN : public AbstractOdeSystem
+{
+private:
+    friend class boost::serialization::access;
+
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractOdeSystem>(*this);
+        archive & mParameterSlot;
+
+        // The parameters themselves are not archived
+        SetParameterSlot(mParameterSlot);
+    }
+
+    /** The slot of GTPaseParameterTable holding this system's parameters. */
+    unsigned mParameterSlot;
+
+    /** The parameters of mParameterSlot, copied from GTPaseParameterTable by SetParameterSlot(). */
+    GTPaseParameters mParameters;
+
+public:
+    ODESRN();
+
+    /**
+     * Set mParameterSlot and copy the parameters of that slot from GTPaseParameterTable.
+     *
+     * @param parameterSlot the slot of GTPaseParameterTable to use
+     */
+    void SetParameterSlot(unsigned parameterSlot);
+
+    /** @return mParameterSlot */
+    unsigned GetParameterSlot() const;
+
+    void EvaluateYDerivatives(double time, const std::vector<double>& rY,
+                              std::vector<double>& rDY);
+
+    /**
+     * Class-specific allocation from a FixedSizePool shared by all
+     * ODESRN systems. Objects of derived classes use the global operator new.
+     *
+     * @param size the size of the object
+     * @return the memory for the object
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory of an object allocated with operator new().
+     *
+     * @param pSystem the memory of the object
+     * @param size the size of the object
+     */
+    static void operator delete(void* pSystem, std::size_t size);
+
+    /**
+     * Make sure that numSystems more systems can be created without further
+     * heap allocations, see FixedSizePool::Reserve().
+     *
+     * @param numSystems the number of systems
+     */
+    static void ReservePool(unsigned numSystems);
+};
+
+#include "SerializationExportWrapper.hpp"
+CHASTE_CLASS_EXPORT(ODESRN)
+
+#endif /*ODESRN_HPP_*/
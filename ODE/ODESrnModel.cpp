@@ -0,0 +1,147 @@
+/*
+ * Rho GTPase Simulation
+ * Author: MoHan Zhang <mohan_z@hotmail.com>
+ * Last Modified: July 11, 2017
+ * Do not reproduce this code without permission.
+ */
+
+#include "ODESrnModel.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "GTPaseProfiler.hpp"
+#include "FixedSizePool.hpp"
+
+namespace
+{
+/**
+ * @return the pool of all ODESrnModels. It is never destroyed, so that
+ *     models still owned by cells at exit can be deleted safely.
+ */
+FixedSizePool& GetModelPool()
+{
+    static FixedSizePool* p_pool = new FixedSizePool(sizeof(ODESrnModel));
+    return *p_pool;
+}
+}
+
+ODESrnModel::ODESrnModel(boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver)
+    : AbstractOdeSrnModel(3, pOdeSolver)
+{
+	// ODE solver
+    if (!mpOdeSolver)
+    {
+        mpOdeSolver = CellCycleModelOdeSolver<ODESrnModel, RungeKutta4IvpOdeSolver>::Instance();
+        mpOdeSolver->Initialise();
+    }
+    SetDt(0.01);
+
+    assert(mpOdeSolver->IsSetUp());
+}
+
+AbstractSrnModel* ODESrnModel::CreateSrnModel()
+{
+    // Daughters use the same solver and time step as their parent
+    ODESrnModel* p_model = new ODESrnModel(mpOdeSolver);
+    p_model->SetDt(GetDt());
+
+    p_model->SetOdeSystem(new ODESRN);
+
+    return AbstractOdeSrnModel::CreateSrnModel(p_model);
+}
+
+void ODESrnModel::Initialise()
+{
+    AbstractOdeSrnModel::Initialise(new ODESRN);
+}
+
+void ODESrnModel::SimulateToCurrentTime()
+{
+    GTPASE_PROFILE_SCOPE(SRN_SOLVE);
+
+    double previous_time = mLastTime;
+
+    // Copy this cell's kinetic parameters once per solve; set here so that daughter and restored cells pick up their own slot
+    static_cast<ODESRN*>(mpOdeSystem)->SetParameterSlot(mpCell->GetCellId() + 1);
+
+    // run the ODE simulation as needed
+    AbstractOdeSrnModel::SimulateToCurrentTime();
+
+    std::vector<double>& r_state = mpOdeSystem->rGetStateVariables();
+
+    /* Output the ODE system variable to {{{CellData}}}. */
+    mpCell->GetCellData()->SetItem("G",r_state[0]);
+	mpCell->GetCellData()->SetItem("target area",r_state[1]);
+	mpCell->GetCellData()->SetItem("AREA",r_state[2]);
+
+    // Accumulate once per solve, i.e. once per time step, so repeated calls at the same time are not counted twice
+    if (mLastTime > previous_time)
+    {
+        mGStatistics.Add(r_state[0]);
+        mTargetAreaStatistics.Add(r_state[1]);
+    }
+}
+
+void ODESrnModel::ResetForDivision()
+{
+	AbstractOdeSrnModel::ResetForDivision();
+    std::vector<double> init_conds = mpOdeSystem->GetInitialConditions();
+    for (unsigned i=0; i<2; i++)
+    {
+        mpOdeSystem->rGetStateVariables()[i] = init_conds[i];
+    }
+}
+
+const RunningStatistics& ODESrnModel::rGetGStatistics() const
+{
+    return mGStatistics;
+}
+
+const RunningStatistics& ODESrnModel::rGetTargetAreaStatistics() const
+{
+    return mTargetAreaStatistics;
+}
+
+void ODESrnModel::RestoreState(const double* pStateVariables, double lastTime,
+                               const RunningStatistics& rGStatistics, const RunningStatistics& rTargetAreaStatistics)
+{
+    assert(mpOdeSystem != NULL);
+    std::vector<double>& r_state = mpOdeSystem->rGetStateVariables();
+    for (unsigned i=0; i<r_state.size(); i++)
+    {
+        r_state[i] = pStateVariables[i];
+    }
+    SetLastTime(lastTime);
+    SetSimulatedToTime(lastTime);
+    mGStatistics = rGStatistics;
+    mTargetAreaStatistics = rTargetAreaStatistics;
+}
+
+void* ODESrnModel::operator new(std::size_t size)
+{
+    if (size != sizeof(ODESrnModel))
+    {
+        return ::operator new(size);
+    }
+    return GetModelPool().Allocate();
+}
+
+void ODESrnModel::operator delete(void* pModel, std::size_t size)
+{
+    if (size != sizeof(ODESrnModel))
+    {
+        ::operator delete(pModel);
+        return;
+    }
+    GetModelPool().Deallocate(pModel);
+}
+
+void ODESrnModel::ReservePool(unsigned numModels)
+{
+    GetModelPool().Reserve(numModels);
+}
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+CHASTE_CLASS_EXPORT(ODESrnModel)
+#include "CellCycleModelOdeSolverExportWrapper.hpp"
+EXPORT_CELL_CYCLE_MODEL_ODE_SOLVER(ODESrnModel)
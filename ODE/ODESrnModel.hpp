@@ -0,0 +1,112 @@
+#ifndef ODESRNMODEL_HPP_
+#define ODESRNMODEL_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Author: MoHan Zhang <mohan_z@hotmail.com>
+ * Last Modified: July 11, 2017
+ * Do not reproduce this code without permission.
+ */
+
+#include <cstddef>
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+
+#include "AbstractOdeSrnModel.hpp"
+#include "ODESRN.hpp"
+#include "RunningStatistics.hpp"
+
+/**
+ * SRN model wrapping ODESRN. After each solve the state variables are copied
+ * to CellData as "G", "target area" and "AREA", and the running statistics of
+ * G and target area are updated.
+ */
+class ODESrnModel : public AbstractOdeSrnModel
+{
+private:
+
+    friend class boost::serialization::access;
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractOdeSrnModel>(*this);
+        archive & mGStatistics;
+        archive & mTargetAreaStatistics;
+    }
+
+    /** Running mean, variance and extremes of G, updated every time step. */
+    RunningStatistics mGStatistics;
+
+    /** Running mean, variance and extremes of the target area, updated every time step. */
+    RunningStatistics mTargetAreaStatistics;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pOdeSolver an optional cell-cycle model ODE solver; by default
+     *     the shared RungeKutta4IvpOdeSolver instance is used. The time step
+     *     is 0.01 in either case and can be changed with SetDt().
+     */
+    ODESrnModel(boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver = boost::shared_ptr<AbstractCellCycleModelOdeSolver>());
+
+    AbstractSrnModel* CreateSrnModel();
+
+    void Initialise();
+
+    void SimulateToCurrentTime();
+
+    void ResetForDivision();
+
+    /** @return the running statistics of G. */
+    const RunningStatistics& rGetGStatistics() const;
+
+    /** @return the running statistics of the target area. */
+    const RunningStatistics& rGetTargetAreaStatistics() const;
+
+    /**
+     * Restore the state of an initialised model, e.g. from a TissueCheckpoint.
+     *
+     * @param pStateVariables pointer to the values of the state variables
+     * @param lastTime the time to which the ODEs had been solved
+     * @param rGStatistics the running statistics of G
+     * @param rTargetAreaStatistics the running statistics of the target area
+     */
+    void RestoreState(const double* pStateVariables, double lastTime,
+                      const RunningStatistics& rGStatistics, const RunningStatistics& rTargetAreaStatistics);
+
+    /**
+     * Class-specific allocation from a FixedSizePool shared by all
+     * ODESrnModels. Objects of derived classes use the global operator new.
+     *
+     * @param size the size of the object
+     * @return the memory for the object
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory of an object allocated with operator new().
+     *
+     * @param pModel the memory of the object
+     * @param size the size of the object
+     */
+    static void operator delete(void* pModel, std::size_t size);
+
+    /**
+     * Make sure that numModels more models can be created without further
+     * heap allocations, see FixedSizePool::Reserve().
+     *
+     * @param numModels the number of models
+     */
+    static void ReservePool(unsigned numModels);
+};
+
+#include "SerializationExportWrapper.hpp"
+CHASTE_CLASS_EXPORT(ODESrnModel)
+#include "CellCycleModelOdeSolverExportWrapper.hpp"
+EXPORT_CELL_CYCLE_MODEL_ODE_SOLVER(ODESrnModel)
+
+#endif /*ODESRNMODEL_HPP_*/
@@ -0,0 +1,129 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ *
+ * Batched single-cell screening: integrates ODESRN for every beta of a grid
+ * against prescribed area signals, without any mechanics, and writes the
+ * period, amplitude and final state of each instance.
+ *
+ * Usage: GTPaseBatchScreen [key=value ...]
+ *   beta_min, beta_max, num_beta     beta grid (default 0 to 1, 101 points)
+ *   signal                           constant, sinusoid or trace (default constant)
+ *   area_min, area_max, num_area     mean area grid for constant and sinusoid (default 0.5 to 1.5, 101 points)
+ *   area_amplitude, area_period      sinusoid amplitude and period (default 0.1 and 100)
+ *   trace_file                       OneCellData.csv whose area drives every instance (signal=trace)
+ *   end_time, dt, transient_time     integration settings (default 2500, 0.01, 500)
+ *   initial_g, initial_target_area   initial state (default 0.5 and 0.8)
+ *   output_file                      output file (default batch_screen.csv)
+ *   any GTPaseParameterTable name    other kinetic parameters
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Exception.hpp"
+#include "CommandLineOptions.hpp"
+#include "BatchedGTPaseIntegrator.hpp"
+#include "GTPaseParameterTable.hpp"
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        CommandLineOptions options(argc, argv);
+
+        double beta_min = options.GetDouble("beta_min", 0.0);
+        double beta_max = options.GetDouble("beta_max", 1.0);
+        unsigned num_beta = options.GetUnsigned("num_beta", 101);
+        std::string signal_type = options.GetString("signal", "constant");
+        double area_min = options.GetDouble("area_min", 0.5);
+        double area_max = options.GetDouble("area_max", 1.5);
+        unsigned num_area = options.GetUnsigned("num_area", 101);
+        double area_amplitude = options.GetDouble("area_amplitude", 0.1);
+        double area_period = options.GetDouble("area_period", 100.0);
+        std::string trace_file = options.GetString("trace_file", "");
+        double end_time = options.GetDouble("end_time", 2500.0);
+        double dt = options.GetDouble("dt", 0.01);
+        double transient_time = options.GetDouble("transient_time", 500.0);
+        double initial_g = options.GetDouble("initial_g", 0.5);
+        double initial_target_area = options.GetDouble("initial_target_area", 0.8);
+        std::string output_file = options.GetString("output_file", "batch_screen.csv");
+        if (num_beta < 1 || num_area < 1 || dt <= 0.0)
+        {
+            EXCEPTION("num_beta and num_area must be positive, and dt must be positive");
+        }
+        if (!(area_period > 0.0))
+        {
+            EXCEPTION("area_period must be positive");
+        }
+
+        GTPaseParameterTable* p_table = GTPaseParameterTable::Instance();
+        std::vector<std::string> parameter_names = options.GetRemainingKeys();
+        for (unsigned i=0; i<parameter_names.size(); i++)
+        {
+            p_table->SetGlobalValue(GTPaseParameterTable::GetParameterFromName(parameter_names[i]),
+                                    options.GetDouble(parameter_names[i], 0.0));
+        }
+        GTPaseParameters parameters;
+        p_table->GetParameters(0, parameters);
+
+        BatchedGTPaseIntegrator integrator;
+        std::vector<double> instance_betas;
+        std::vector<double> signal_means;
+        if (signal_type == "trace")
+        {
+            if (trace_file.empty())
+            {
+                EXCEPTION("signal=trace needs trace_file");
+            }
+            num_area = 1;
+            AreaSignal trace = AreaSignal::LoadOneCellData(trace_file);
+            integrator.AddSignal(trace);
+            signal_means.push_back(trace.GetMean());
+        }
+        else if (signal_type == "constant" || signal_type == "sinusoid")
+        {
+            for (unsigned a=0; a<num_area; a++)
+            {
+                double area = num_area > 1 ? area_min + (area_max - area_min)*a/(num_area - 1) : area_min;
+                integrator.AddSignal(AreaSignal(area, signal_type == "sinusoid" ? area_amplitude : 0.0, area_period));
+                signal_means.push_back(area);
+            }
+        }
+        else
+        {
+            EXCEPTION("Unknown signal " + signal_type);
+        }
+
+        for (unsigned a=0; a<num_area; a++)
+        {
+            for (unsigned b=0; b<num_beta; b++)
+            {
+                parameters.mBeta = num_beta > 1 ? beta_min + (beta_max - beta_min)*b/(num_beta - 1) : beta_min;
+                integrator.AddInstance(parameters, a, initial_g, initial_target_area);
+                instance_betas.push_back(parameters.mBeta);
+            }
+        }
+
+        integrator.Solve(end_time, dt, transient_time);
+
+        std::ofstream output(output_file.c_str());
+        output << "# Beta,Mean_Area,Signal,Period,Amplitude,Final_G,Final_Target_Area\n";
+        for (unsigned i=0; i<integrator.GetNumInstances(); i++)
+        {
+            output << instance_betas[i] << "," << signal_means[i/num_beta] << "," << signal_type
+                   << "," << integrator.GetPeriod(i) << "," << integrator.GetAmplitude(i)
+                   << "," << integrator.GetG(i) << "," << integrator.GetTargetArea(i) << "\n";
+        }
+
+        std::cout << integrator.GetNumInstances() << " instances written to " << output_file << "\n";
+        return 0;
+    }
+    catch (const Exception& e)
+    {
+        std::cerr << e.GetMessage() << "\n";
+        return 1;
+    }
+}
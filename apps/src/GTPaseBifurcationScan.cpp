@@ -0,0 +1,303 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ *
+ * Single-cell bifurcation scanner for the ODESRN kinetics with the cell area
+ * clamped, over a grid of (beta, area).
+ *
+ * For each point the fixed points of the (G, target area) system are found
+ * by eliminating the target area (its nullcline is explicit in G) and
+ * bracketing the roots of dG/dt in G in [0, 2], then refining them by
+ * bisection. Each fixed point is classified from the trace and determinant
+ * of its Jacobian. Along beta, fixed point branches are continued by nearest
+ * G, and a sign change of the trace with a positive determinant is reported
+ * as a Hopf bifurcation, with the linear period 2*pi/sqrt(det) there.
+ * The area rows are independent. They are shared between threads only when
+ * the scanner is compiled with OpenMP enabled (e.g. -fopenmp); otherwise
+ * they are scanned one after another.
+ *
+ * Usage: GTPaseBifurcationScan [key=value ...]
+ *   beta_min, beta_max, num_beta    beta grid (default 0 to 1, 201 points)
+ *   area_min, area_max, num_area    clamped area grid (default 0.5 to 1.5, 101 points)
+ *   output_prefix                   output file prefix (default "bifurcation")
+ *   any GTPaseParameterTable name   other kinetic parameters (e.g. feedback_strength=1.5)
+ *
+ * Writes [prefix]_fixed_points.csv and [prefix]_hopf.csv.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Exception.hpp"
+#include "CommandLineOptions.hpp"
+#include "GTPaseKinetics.hpp"
+#include "GTPaseParameterTable.hpp"
+
+namespace
+{
+/** Number of intervals used to bracket the roots of dG/dt in G. */
+const unsigned NUM_BRACKETS = 2000;
+
+/** One fixed point of the clamped-area system. */
+struct FixedPoint
+{
+    /** The GTPase concentration. */
+    double mG;
+    /** The target area. */
+    double mTargetArea;
+    /** The trace of the Jacobian. */
+    double mTrace;
+    /** The determinant of the Jacobian. */
+    double mDeterminant;
+};
+
+/** A Hopf bifurcation found between two beta grid points. */
+struct HopfPoint
+{
+    /** The clamped area. */
+    double mArea;
+    /** The interpolated beta. */
+    double mBeta;
+    /** The interpolated G of the fixed point. */
+    double mG;
+    /** The linear period 2*pi/sqrt(det). */
+    double mPeriod;
+    /** Whether the fixed point becomes unstable with increasing beta. */
+    bool mLosesStability;
+};
+
+/** @return the target area on its nullcline for a given G. */
+double TargetAreaNullcline(const GTPaseParameters& rParameters, double g)
+{
+    double g4 = pow(g, 4);
+    return rParameters.mTargetAreaScale*(1 - rParameters.mTargetAreaReduction*(g4/(pow(rParameters.mHalfSaturation, 4) + g4)));
+}
+
+/** @return dG/dt on the target area nullcline. */
+double ReducedRate(const GTPaseParameters& rParameters, double g, double area)
+{
+    double dg, dtarget_area;
+    EvaluateGTPaseKinetics(rParameters, g, TargetAreaNullcline(rParameters, g), area, dg, dtarget_area);
+    return dg;
+}
+
+/** Fill the trace and determinant of the Jacobian of a fixed point, by central differences. */
+void ComputeJacobian(const GTPaseParameters& rParameters, double area, FixedPoint& rPoint)
+{
+    const double h = 1e-7;
+    double dg_plus, dt_plus, dg_minus, dt_minus;
+
+    EvaluateGTPaseKinetics(rParameters, rPoint.mG + h, rPoint.mTargetArea, area, dg_plus, dt_plus);
+    EvaluateGTPaseKinetics(rParameters, rPoint.mG - h, rPoint.mTargetArea, area, dg_minus, dt_minus);
+    double j00 = (dg_plus - dg_minus)/(2*h);
+    double j10 = (dt_plus - dt_minus)/(2*h);
+
+    EvaluateGTPaseKinetics(rParameters, rPoint.mG, rPoint.mTargetArea + h, area, dg_plus, dt_plus);
+    EvaluateGTPaseKinetics(rParameters, rPoint.mG, rPoint.mTargetArea - h, area, dg_minus, dt_minus);
+    double j01 = (dg_plus - dg_minus)/(2*h);
+    double j11 = (dt_plus - dt_minus)/(2*h);
+
+    rPoint.mTrace = j00 + j11;
+    rPoint.mDeterminant = j00*j11 - j01*j10;
+}
+
+/** @return all fixed points for one (beta, area), in increasing G. */
+std::vector<FixedPoint> FindFixedPoints(const GTPaseParameters& rParameters, double area)
+{
+    std::vector<FixedPoint> points;
+    double g_low = 0.0;
+    double f_low = ReducedRate(rParameters, g_low, area);
+    for (unsigned i=1; i<=NUM_BRACKETS; i++)
+    {
+        double g_high = 2.0*i/NUM_BRACKETS;
+        double f_high = ReducedRate(rParameters, g_high, area);
+        if ((f_low <= 0.0) != (f_high <= 0.0))
+        {
+            double a = g_low, b = g_high, f_a = f_low;
+            for (unsigned iteration=0; iteration<60; iteration++)
+            {
+                double mid = 0.5*(a + b);
+                double f_mid = ReducedRate(rParameters, mid, area);
+                if ((f_mid <= 0.0) == (f_a <= 0.0))
+                {
+                    a = mid;
+                    f_a = f_mid;
+                }
+                else
+                {
+                    b = mid;
+                }
+            }
+            FixedPoint point;
+            point.mG = 0.5*(a + b);
+            point.mTargetArea = TargetAreaNullcline(rParameters, point.mG);
+            ComputeJacobian(rParameters, area, point);
+            points.push_back(point);
+        }
+        g_low = g_high;
+        f_low = f_high;
+    }
+    return points;
+}
+
+/** @return "stable_node", "stable_focus", "unstable_node", "unstable_focus" or "saddle". */
+std::string Classify(const FixedPoint& rPoint)
+{
+    if (rPoint.mDeterminant < 0.0)
+    {
+        return "saddle";
+    }
+    bool is_focus = rPoint.mTrace*rPoint.mTrace < 4.0*rPoint.mDeterminant;
+    if (rPoint.mTrace < 0.0)
+    {
+        return is_focus ? "stable_focus" : "stable_node";
+    }
+    return is_focus ? "unstable_focus" : "unstable_node";
+}
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        CommandLineOptions options(argc, argv);
+
+        std::string output_prefix = options.GetString("output_prefix", "bifurcation");
+        double beta_min = options.GetDouble("beta_min", 0.0);
+        double beta_max = options.GetDouble("beta_max", 1.0);
+        unsigned num_beta = options.GetUnsigned("num_beta", 201);
+        double area_min = options.GetDouble("area_min", 0.5);
+        double area_max = options.GetDouble("area_max", 1.5);
+        unsigned num_area = options.GetUnsigned("num_area", 101);
+        if (num_beta < 2 || num_area < 1)
+        {
+            EXCEPTION("num_beta must be at least 2 and num_area at least 1");
+        }
+
+        // Whatever is left must be a kinetic parameter
+        GTPaseParameterTable* p_table = GTPaseParameterTable::Instance();
+        std::vector<std::string> parameter_names = options.GetRemainingKeys();
+        for (unsigned i=0; i<parameter_names.size(); i++)
+        {
+            p_table->SetGlobalValue(GTPaseParameterTable::GetParameterFromName(parameter_names[i]),
+                                    options.GetDouble(parameter_names[i], 0.0));
+        }
+        GTPaseParameters base_parameters;
+        p_table->GetParameters(0, base_parameters);
+
+        std::vector<std::vector<std::vector<FixedPoint> > > fixed_points(num_area, std::vector<std::vector<FixedPoint> >(num_beta));
+        std::vector<std::vector<HopfPoint> > hopf_points(num_area);
+
+#ifdef _OPENMP
+        std::cout << "Scanning " << num_area << " area rows on up to " << omp_get_max_threads() << " threads\n";
+        #pragma omp parallel for schedule(dynamic)
+#else
+        std::cout << "Scanning " << num_area << " area rows serially (built without OpenMP)\n";
+#endif
+        for (int a=0; a<(int)num_area; a++)
+        {
+            double area = num_area > 1 ? area_min + (area_max - area_min)*a/(num_area - 1) : area_min;
+            GTPaseParameters parameters = base_parameters;
+            for (unsigned b=0; b<num_beta; b++)
+            {
+                parameters.mBeta = beta_min + (beta_max - beta_min)*b/(num_beta - 1);
+                fixed_points[a][b] = FindFixedPoints(parameters, area);
+
+                if (b == 0)
+                {
+                    continue;
+                }
+
+                // Continue each branch to the nearest fixed point at the previous beta and look for a trace sign change
+                const std::vector<FixedPoint>& r_previous = fixed_points[a][b-1];
+                const std::vector<FixedPoint>& r_current = fixed_points[a][b];
+                for (unsigned i=0; i<r_current.size(); i++)
+                {
+                    unsigned nearest = r_previous.size();
+                    double nearest_distance = 0.05;
+                    for (unsigned j=0; j<r_previous.size(); j++)
+                    {
+                        double distance = fabs(r_current[i].mG - r_previous[j].mG);
+                        if (distance < nearest_distance)
+                        {
+                            nearest = j;
+                            nearest_distance = distance;
+                        }
+                    }
+                    if (nearest == r_previous.size())
+                    {
+                        continue;
+                    }
+
+                    const FixedPoint& r_old = r_previous[nearest];
+                    const FixedPoint& r_new = r_current[i];
+                    if ((r_old.mTrace < 0.0) != (r_new.mTrace < 0.0) && r_old.mDeterminant > 0.0 && r_new.mDeterminant > 0.0)
+                    {
+                        double s = r_old.mTrace/(r_old.mTrace - r_new.mTrace);
+                        double previous_beta = beta_min + (beta_max - beta_min)*(b - 1)/(num_beta - 1);
+                        HopfPoint hopf;
+                        hopf.mArea = area;
+                        hopf.mBeta = previous_beta + s*(parameters.mBeta - previous_beta);
+                        hopf.mG = r_old.mG + s*(r_new.mG - r_old.mG);
+                        double determinant = r_old.mDeterminant + s*(r_new.mDeterminant - r_old.mDeterminant);
+                        hopf.mPeriod = 2.0*M_PI/sqrt(determinant);
+                        hopf.mLosesStability = r_new.mTrace > 0.0;
+                        hopf_points[a].push_back(hopf);
+                    }
+                }
+            }
+        }
+
+        std::string fixed_points_file = output_prefix + "_fixed_points.csv";
+        std::ofstream fixed_points_stream(fixed_points_file.c_str());
+        fixed_points_stream << "# Beta,Area,G,Target_Area,Trace,Determinant,Type\n";
+        unsigned num_fixed_points = 0;
+        for (unsigned a=0; a<num_area; a++)
+        {
+            double area = num_area > 1 ? area_min + (area_max - area_min)*a/(num_area - 1) : area_min;
+            for (unsigned b=0; b<num_beta; b++)
+            {
+                double beta = beta_min + (beta_max - beta_min)*b/(num_beta - 1);
+                for (unsigned i=0; i<fixed_points[a][b].size(); i++)
+                {
+                    const FixedPoint& r_point = fixed_points[a][b][i];
+                    fixed_points_stream << beta << "," << area << "," << r_point.mG << "," << r_point.mTargetArea
+                                        << "," << r_point.mTrace << "," << r_point.mDeterminant << "," << Classify(r_point) << "\n";
+                    num_fixed_points++;
+                }
+            }
+        }
+
+        std::string hopf_file = output_prefix + "_hopf.csv";
+        std::ofstream hopf_stream(hopf_file.c_str());
+        hopf_stream << "# Area,Beta,G,Period,Loses_Stability\n";
+        unsigned num_hopf = 0;
+        for (unsigned a=0; a<num_area; a++)
+        {
+            for (unsigned i=0; i<hopf_points[a].size(); i++)
+            {
+                const HopfPoint& r_hopf = hopf_points[a][i];
+                hopf_stream << r_hopf.mArea << "," << r_hopf.mBeta << "," << r_hopf.mG << "," << r_hopf.mPeriod
+                            << "," << r_hopf.mLosesStability << "\n";
+                num_hopf++;
+            }
+        }
+
+        std::cout << num_fixed_points << " fixed points written to " << fixed_points_file << ", "
+                  << num_hopf << " Hopf points written to " << hopf_file << "\n";
+        return 0;
+    }
+    catch (const Exception& e)
+    {
+        std::cerr << e.GetMessage() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ *
+ * Golden-trajectory comparator: compares the per-cell G, area and target
+ * area trajectories (cell_data.xml) and topology statistics
+ * (topology_data.csv) of a candidate run against a reference run, and exits
+ * with status 0 if every value is within tolerance, 1 if not and 2 on error.
+ *
+ * Usage: GTPaseCompareRuns reference_directory candidate_directory [key=value ...]
+ *   [quantity]_abs, [quantity]_rel   tolerances, for quantity G, area, target_area or topology
+ *                                    (default 1e-6 and 1e-5)
+ *   report_file                      also write the report to this file
+ *
+ * A file missing from both runs (writer switched off) is skipped; a file
+ * missing from only one of them is an error, and so is comparing no file at
+ * all (e.g. a mistyped directory).
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Exception.hpp"
+#include "CommandLineOptions.hpp"
+#include "TrajectoryComparison.hpp"
+
+namespace
+{
+/** @return whether the file can be opened for reading. */
+bool FileExists(const std::string& rFileName)
+{
+    std::ifstream file(rFileName.c_str());
+    return file.is_open();
+}
+
+/**
+ * @param rReferenceFile the reference file
+ * @param rCandidateFile the candidate file
+ * @return whether both files exist; false if neither does
+ */
+bool BothExist(const std::string& rReferenceFile, const std::string& rCandidateFile)
+{
+    bool reference_exists = FileExists(rReferenceFile);
+    bool candidate_exists = FileExists(rCandidateFile);
+    if (reference_exists != candidate_exists)
+    {
+        EXCEPTION("Only one of " + rReferenceFile + " and " + rCandidateFile + " exists");
+    }
+    if (!reference_exists)
+    {
+        std::cout << "Skipping " << rReferenceFile << ": not in either run\n";
+    }
+    return reference_exists;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        if (argc < 3)
+        {
+            std::cerr << "Usage: GTPaseCompareRuns reference_directory candidate_directory [key=value ...]\n";
+            return 2;
+        }
+        std::string reference_directory = std::string(argv[1]) + "/";
+        std::string candidate_directory = std::string(argv[2]) + "/";
+
+        CommandLineOptions options(argc, argv, 3);
+        std::string report_file = options.GetString("report_file", "");
+
+        TrajectoryComparison comparison;
+        const char* quantities[] = {"G", "area", "target_area", "topology"};
+        for (unsigned q=0; q<4; q++)
+        {
+            std::string quantity = quantities[q];
+            double absolute = options.GetDouble(quantity + "_abs", comparison.GetAbsoluteTolerance(quantity));
+            double relative = options.GetDouble(quantity + "_rel", comparison.GetRelativeTolerance(quantity));
+            comparison.SetTolerance(quantity, absolute, relative);
+        }
+        options.CheckAllUsed();
+
+        unsigned num_files_compared = 0;
+        if (BothExist(reference_directory + "cell_data.xml", candidate_directory + "cell_data.xml"))
+        {
+            comparison.CompareCellData(reference_directory + "cell_data.xml", candidate_directory + "cell_data.xml");
+            num_files_compared++;
+        }
+        if (BothExist(reference_directory + "topology_data.csv", candidate_directory + "topology_data.csv"))
+        {
+            comparison.CompareTopology(reference_directory + "topology_data.csv", candidate_directory + "topology_data.csv");
+            num_files_compared++;
+        }
+        if (num_files_compared == 0)
+        {
+            EXCEPTION("Neither " + reference_directory + " nor " + candidate_directory + " has any file to compare");
+        }
+
+        comparison.WriteReport(std::cout);
+        if (!report_file.empty())
+        {
+            std::ofstream report(report_file.c_str());
+            comparison.WriteReport(report);
+        }
+        return comparison.Passed() ? 0 : 1;
+    }
+    catch (const Exception& e)
+    {
+        std::cerr << e.GetMessage() << "\n";
+        return 2;
+    }
+}
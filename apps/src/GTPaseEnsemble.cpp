@@ -0,0 +1,374 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ *
+ * Ensemble runner: runs many independent GTPaseSimulation jobs in parallel.
+ *
+ * Every job is a separate GTPaseSimulation process, so each has its own
+ * SimulationTime, RandomNumberGenerator and ODE solver singletons. Jobs are
+ * taken from a shared list by whichever worker slot frees up first, and a job
+ * is only started when its estimated memory fits in the memory budget
+ * alongside the jobs already running (a single job is always allowed).
+ *
+ * Usage: GTPaseEnsemble base_scenario [options]
+ *   --jobs-file FILE       one job per line, as whitespace separated key=value overrides
+ *   --replicas N           run every job with seeds 1..N (default 1; without a
+ *                          jobs file, N jobs of the base scenario)
+ *   --workers N            maximum concurrent jobs (default: number of cores)
+ *   --memory-budget-mb M   total memory budget (default: 80% of MemAvailable)
+ *   --memory-per-cell-kb K estimated memory per cell (default 16)
+ *   --simulator PATH       GTPaseSimulation executable (default: next to this one)
+ *
+ * Numeric options must be positive; anything else is rejected before any job runs.
+ *
+ * Job i writes to [output_directory]/job_[i]; ensemble_index.csv in the
+ * output directory lists every job with its exit status, wall time, peak
+ * resident memory and overrides, and is rewritten as jobs complete.
+ */
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Exception.hpp"
+#include "OutputFileHandler.hpp"
+#include "ScenarioConfig.hpp"
+
+namespace
+{
+/** Fixed memory estimate of one job in MB, on top of the per-cell estimate. */
+const double BASE_MEMORY_PER_JOB_MB = 100.0;
+
+/** One job of the ensemble. */
+struct EnsembleJob
+{
+    /** The key=value overrides of the job. */
+    std::vector<std::string> mOverrides;
+    /** The estimated memory of the job in MB. */
+    double mMemoryMb;
+    /** The exit status, or -1 if not finished. */
+    int mExitStatus;
+    /** The wall-clock time taken, in seconds. */
+    double mWallSeconds;
+    /** The peak resident memory of the job, in KB. */
+    long mMaxRssKb;
+    /** The wall-clock time at which the job started. */
+    double mStartTime;
+};
+
+/** @return the wall-clock time in seconds. */
+double WallClockSeconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + 1e-6*now.tv_usec;
+}
+
+/** @return 80% of MemAvailable in MB, or 4096 if it cannot be read. */
+double DefaultMemoryBudgetMb()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    double value;
+    std::string unit;
+    while (meminfo >> key >> value >> unit)
+    {
+        if (key == "MemAvailable:")
+        {
+            return 0.8*value/1024.0;
+        }
+    }
+    return 4096.0;
+}
+
+/**
+ * Parse the value of a command line option as a positive integer.
+ *
+ * @param rOption the option, for error messages
+ * @param rValue the value
+ * @return the integer
+ */
+unsigned ParsePositiveUnsigned(const std::string& rOption, const std::string& rValue)
+{
+    char* p_end;
+    errno = 0;
+    unsigned long value = std::strtoul(rValue.c_str(), &p_end, 10);
+    if (rValue.empty() || *p_end != '\0' || rValue.find('-') != std::string::npos
+        || errno == ERANGE || value > UINT_MAX)
+    {
+        EXCEPTION(rOption + " is not a positive integer: " + rValue);
+    }
+    if (value == 0)
+    {
+        EXCEPTION(rOption + " must be positive");
+    }
+    return value;
+}
+
+/**
+ * Parse the value of a command line option as a positive, finite number.
+ *
+ * @param rOption the option, for error messages
+ * @param rValue the value
+ * @return the number
+ */
+double ParsePositiveDouble(const std::string& rOption, const std::string& rValue)
+{
+    char* p_end;
+    errno = 0;
+    double value = std::strtod(rValue.c_str(), &p_end);
+    if (rValue.empty() || *p_end != '\0' || errno == ERANGE || !(value > 0.0 && value <= DBL_MAX))
+    {
+        EXCEPTION(rOption + " is not a positive number: " + rValue);
+    }
+    return value;
+}
+
+/** Write the index of all jobs. */
+void WriteIndex(const std::string& rFileName, const std::string& rOutputDirectory, const std::vector<EnsembleJob>& rJobs)
+{
+    std::ofstream index(rFileName.c_str());
+    index << "# Job,Exit_Status,Wall_Seconds,Max_RSS_KB,Output_Directory,Overrides\n";
+    for (unsigned i=0; i<rJobs.size(); i++)
+    {
+        const EnsembleJob& r_job = rJobs[i];
+        if (r_job.mExitStatus < 0)
+        {
+            continue;
+        }
+        index << i << "," << r_job.mExitStatus << "," << r_job.mWallSeconds << "," << r_job.mMaxRssKb
+              << "," << rOutputDirectory << "/job_" << i << ",";
+        for (unsigned j=0; j<r_job.mOverrides.size(); j++)
+        {
+            index << (j > 0 ? " " : "") << r_job.mOverrides[j];
+        }
+        index << "\n";
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        if (argc < 2)
+        {
+            std::cerr << "Usage: GTPaseEnsemble base_scenario [--jobs-file FILE] [--replicas N] [--workers N]"
+                      << " [--memory-budget-mb M] [--memory-per-cell-kb K] [--simulator PATH]\n";
+            return 1;
+        }
+
+        std::string base_scenario = argv[1];
+        std::string jobs_file;
+        unsigned num_replicas = 1;
+        long num_cores = sysconf(_SC_NPROCESSORS_ONLN);
+        unsigned num_workers = num_cores > 0 ? num_cores : 1;
+        double memory_budget_mb = DefaultMemoryBudgetMb();
+        double memory_per_cell_kb = 16.0;
+        std::string simulator = argv[0];
+        simulator = simulator.substr(0, simulator.find_last_of('/') + 1) + "GTPaseSimulation";
+
+        for (int i=2; i<argc; i++)
+        {
+            std::string option = argv[i];
+            if (i + 1 == argc)
+            {
+                EXCEPTION("Missing value for " + option);
+            }
+            std::string value = argv[++i];
+            if (option == "--jobs-file")
+            {
+                jobs_file = value;
+            }
+            else if (option == "--replicas")
+            {
+                num_replicas = ParsePositiveUnsigned(option, value);
+            }
+            else if (option == "--workers")
+            {
+                num_workers = ParsePositiveUnsigned(option, value);
+            }
+            else if (option == "--memory-budget-mb")
+            {
+                memory_budget_mb = ParsePositiveDouble(option, value);
+            }
+            else if (option == "--memory-per-cell-kb")
+            {
+                memory_per_cell_kb = ParsePositiveDouble(option, value);
+            }
+            else if (option == "--simulator")
+            {
+                simulator = value;
+            }
+            else
+            {
+                EXCEPTION("Unknown option " + option);
+            }
+        }
+        ScenarioConfig base_config;
+        base_config.ReadFile(base_scenario);
+        std::string output_directory = base_config.GetString("output_directory");
+
+        // Parameter points: one per line of the jobs file, or just the base scenario
+        std::vector<std::vector<std::string> > points;
+        if (jobs_file.empty())
+        {
+            points.push_back(std::vector<std::string>());
+        }
+        else
+        {
+            std::ifstream file(jobs_file.c_str());
+            if (!file.is_open())
+            {
+                EXCEPTION("Could not open jobs file " + jobs_file);
+            }
+            std::string line;
+            while (std::getline(file, line))
+            {
+                std::string::size_type comment = line.find('#');
+                if (comment != std::string::npos)
+                {
+                    line.erase(comment);
+                }
+                std::istringstream words(line);
+                std::vector<std::string> overrides;
+                std::string word;
+                while (words >> word)
+                {
+                    overrides.push_back(word);
+                }
+                if (!overrides.empty())
+                {
+                    points.push_back(overrides);
+                }
+            }
+        }
+
+        // Expand into jobs, validating every override and estimating memory before anything runs
+        std::vector<EnsembleJob> jobs;
+        for (unsigned p=0; p<points.size(); p++)
+        {
+            for (unsigned r=0; r<num_replicas; r++)
+            {
+                EnsembleJob job;
+                job.mOverrides = points[p];
+                if (num_replicas > 1)
+                {
+                    std::stringstream seed;
+                    seed << "seed=" << r + 1;
+                    job.mOverrides.push_back(seed.str());
+                }
+                std::stringstream job_directory;
+                job_directory << "output_directory=" << output_directory << "/job_" << jobs.size();
+                job.mOverrides.push_back(job_directory.str());
+
+                ScenarioConfig config = base_config;
+                for (unsigned j=0; j<job.mOverrides.size(); j++)
+                {
+                    config.ParseOverride(job.mOverrides[j]);
+                }
+                double num_cells = (double)config.GetUnsigned("num_cells_across")*config.GetUnsigned("num_cells_up");
+                job.mMemoryMb = BASE_MEMORY_PER_JOB_MB + num_cells*memory_per_cell_kb/1024.0;
+                job.mExitStatus = -1;
+                job.mWallSeconds = 0.0;
+                job.mMaxRssKb = 0;
+                job.mStartTime = 0.0;
+                jobs.push_back(job);
+            }
+        }
+
+        OutputFileHandler output_file_handler(output_directory + "/", false);
+        std::string index_file = output_file_handler.GetOutputDirectoryFullPath() + "ensemble_index.csv";
+
+        std::cout << "Running " << jobs.size() << " jobs on up to " << num_workers << " workers with a "
+                  << memory_budget_mb << " MB memory budget\n";
+
+        // Dynamic scheduling: the next job goes to whichever slot frees up first
+        std::map<pid_t, unsigned> running;
+        double memory_in_use_mb = 0.0;
+        unsigned next_job = 0;
+        unsigned num_failed = 0;
+        while (next_job < jobs.size() || !running.empty())
+        {
+            while (next_job < jobs.size() && running.size() < num_workers
+                   && (running.empty() || memory_in_use_mb + jobs[next_job].mMemoryMb <= memory_budget_mb))
+            {
+                EnsembleJob& r_job = jobs[next_job];
+
+                std::vector<char*> arguments;
+                arguments.push_back(const_cast<char*>(simulator.c_str()));
+                arguments.push_back(const_cast<char*>(base_scenario.c_str()));
+                for (unsigned j=0; j<r_job.mOverrides.size(); j++)
+                {
+                    arguments.push_back(const_cast<char*>(r_job.mOverrides[j].c_str()));
+                }
+                arguments.push_back(NULL);
+
+                r_job.mStartTime = WallClockSeconds();
+                pid_t pid = fork();
+                if (pid < 0)
+                {
+                    EXCEPTION("fork() failed");
+                }
+                if (pid == 0)
+                {
+                    execv(simulator.c_str(), &arguments[0]);
+                    std::cerr << "Could not run " << simulator << "\n";
+                    _exit(127);
+                }
+                running[pid] = next_job;
+                memory_in_use_mb += r_job.mMemoryMb;
+                next_job++;
+            }
+
+            int status;
+            rusage usage;
+            pid_t pid = wait4(-1, &status, 0, &usage);
+            if (pid < 0)
+            {
+                EXCEPTION("wait4() failed");
+            }
+            std::map<pid_t, unsigned>::iterator it = running.find(pid);
+            if (it == running.end())
+            {
+                continue;
+            }
+
+            EnsembleJob& r_job = jobs[it->second];
+            r_job.mExitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+            r_job.mWallSeconds = WallClockSeconds() - r_job.mStartTime;
+            r_job.mMaxRssKb = usage.ru_maxrss;
+            memory_in_use_mb -= r_job.mMemoryMb;
+            if (r_job.mExitStatus != 0)
+            {
+                num_failed++;
+            }
+            std::cout << "Job " << it->second << " finished with status " << r_job.mExitStatus
+                      << " in " << r_job.mWallSeconds << " s\n";
+            running.erase(it);
+
+            WriteIndex(index_file, output_directory, jobs);
+        }
+
+        std::cout << jobs.size() - num_failed << " of " << jobs.size() << " jobs succeeded; index in " << index_file << "\n";
+        return num_failed == 0 ? 0 : 1;
+    }
+    catch (const Exception& e)
+    {
+        std::cerr << e.GetMessage() << "\n";
+        return 1;
+    }
+}
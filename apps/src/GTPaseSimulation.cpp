@@ -0,0 +1,66 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ *
+ * Standalone driver: runs the scenario described by a scenario file, with
+ * optional key=value overrides, without recompiling.
+ *
+ * Usage: GTPaseSimulation scenario_file [key=value ...]
+ */
+
+#include <iostream>
+#include <string>
+
+#include "ExecutableSupport.hpp"
+#include "Exception.hpp"
+#include "PetscException.hpp"
+#include "SimulationTime.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "CellPropertyRegistry.hpp"
+#include "CellId.hpp"
+
+#include "ScenarioConfig.hpp"
+#include "GTPaseScenario.hpp"
+
+int main(int argc, char *argv[])
+{
+    ExecutableSupport::StartupWithoutShowingCopyright(&argc, &argv);
+
+    int exit_code = ExecutableSupport::EXIT_OK;
+    try
+    {
+        if (argc < 2)
+        {
+            ExecutableSupport::PrintError("Usage: GTPaseSimulation scenario_file [key=value ...]", true);
+            exit_code = ExecutableSupport::EXIT_BAD_ARGUMENTS;
+        }
+        else
+        {
+            ScenarioConfig config;
+            config.ReadFile(argv[1]);
+            for (int i=2; i<argc; i++)
+            {
+                config.ParseOverride(argv[i]);
+            }
+
+            // The set-up AbstractCellBasedTestSuite does for tests
+            SimulationTime::Instance()->SetStartTime(0.0);
+            CellPropertyRegistry::Instance()->Clear();
+            CellId::ResetMaxCellId();
+
+            GTPaseScenario::Run(config);
+
+            SimulationTime::Destroy();
+            RandomNumberGenerator::Destroy();
+            CellPropertyRegistry::Instance()->Clear();
+        }
+    }
+    catch (const Exception& e)
+    {
+        ExecutableSupport::PrintError(e.GetMessage());
+        exit_code = ExecutableSupport::EXIT_ERROR;
+    }
+
+    ExecutableSupport::FinalizePetsc();
+    return exit_code;
+}
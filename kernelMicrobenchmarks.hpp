@@ -0,0 +1,359 @@
+#ifndef KERNELMICROBENCHMARKS_HPP_
+#define KERNELMICROBENCHMARKS_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "PetscSetupAndFinalize.hpp"
+#include "SmartPointers.hpp"
+#include "Exception.hpp"
+
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "CellsGenerator.hpp"
+#include "NoCellCycleModel.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "SimulationTime.hpp"
+#include "OutputFileHandler.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+
+#include "ODESRN.hpp"
+#include "GTPaseParameterTable.hpp"
+#include "GTPaseProfiler.hpp"
+#include "RunningStatistics.hpp"
+#include "XMLCellWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+/**
+ * Microbenchmarks of the kernels of the coupled simulation, each measured in
+ * isolation on a synthetic tissue: a 20x20 honeycomb whose nodes are jittered
+ * by up to 5% of the cell size, and SRN states drawn from the ranges seen in
+ * the oscillating regime. All inputs use fixed seeds.
+ *
+ * Every benchmark runs its kernel for a fixed number of iterations per
+ * repetition; after NUM_WARMUP_REPETITIONS unmeasured repetitions, the time
+ * per iteration of NUM_REPETITIONS repetitions is summarised by its minimum,
+ * median, mean and standard deviation. The results are written to
+ * GTPaseMicrobenchmarks/microbenchmarks.json.
+ */
+class kernelMicrobenchmarks : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** Number of unmeasured repetitions before measuring. */
+    static const unsigned NUM_WARMUP_REPETITIONS = 5;
+
+    /** Number of measured repetitions. */
+    static const unsigned NUM_REPETITIONS = 30;
+
+    /** Number of cells across and up the synthetic honeycomb. */
+    static const unsigned NUM_CELLS_ACROSS = 20;
+
+    /** Number of SRN states in the synthetic input. */
+    static const unsigned NUM_STATES = 1024;
+
+    /** A kernel run for a number of iterations. */
+    class Kernel
+    {
+    public:
+        /** Constructor. */
+        Kernel()
+            : mSink(0.0)
+        {
+        }
+
+        /** Destructor. */
+        virtual ~Kernel()
+        {
+        }
+
+        /**
+         * Run the kernel.
+         *
+         * @param numIterations the number of iterations
+         */
+        virtual void Run(unsigned numIterations)=0;
+
+        /** Accumulated results, read at the end so that the work cannot be optimised away. */
+        double mSink;
+    };
+
+    /** ODESRN::EvaluateYDerivatives on a set of states. */
+    class EvaluateYDerivativesKernel : public Kernel
+    {
+    public:
+        /** The ODE system. */
+        ODESRN mOde;
+        /** The input states. */
+        std::vector<std::vector<double> > mStates;
+        /** The derivatives. */
+        std::vector<double> mDerivatives;
+
+        /** @param rStates the input states */
+        EvaluateYDerivativesKernel(const std::vector<std::vector<double> >& rStates)
+            : mStates(rStates),
+              mDerivatives(3)
+        {
+        }
+
+        void Run(unsigned numIterations)
+        {
+            for (unsigned i=0; i<numIterations; i++)
+            {
+                mOde.EvaluateYDerivatives(0.0, mStates[i % mStates.size()], mDerivatives);
+                mSink += mDerivatives[0];
+            }
+        }
+    };
+
+    /** One RK4 step of ODESRN, as taken by ODESrnModel every time step. */
+    class Rk4StepKernel : public Kernel
+    {
+    public:
+        /** The ODE system. */
+        ODESRN mOde;
+        /** The solver used by ODESrnModel. */
+        RungeKutta4IvpOdeSolver mSolver;
+        /** The input states. */
+        std::vector<std::vector<double> > mStates;
+
+        /** @param rStates the input states */
+        Rk4StepKernel(const std::vector<std::vector<double> >& rStates)
+            : mStates(rStates)
+        {
+        }
+
+        void Run(unsigned numIterations)
+        {
+            for (unsigned i=0; i<numIterations; i++)
+            {
+                // Each iteration starts from an input state, so the states do not drift between repetitions
+                mOde.rGetStateVariables() = mStates[i % mStates.size()];
+                mSolver.SolveAndUpdateStateVariable(&mOde, 0.0, 0.01, 0.01);
+                mSink += mOde.rGetStateVariables()[0];
+            }
+        }
+    };
+
+    /** GetVolumeOfCell and GetSurfaceAreaOfElement over every cell. */
+    class CellGeometryKernel : public Kernel
+    {
+    public:
+        /** The population. */
+        VertexBasedCellPopulation<2>& mrPopulation;
+
+        /** @param rPopulation the population */
+        CellGeometryKernel(VertexBasedCellPopulation<2>& rPopulation)
+            : mrPopulation(rPopulation)
+        {
+        }
+
+        void Run(unsigned numIterations)
+        {
+            for (unsigned i=0; i<numIterations; i++)
+            {
+                for (AbstractCellPopulation<2>::Iterator cell_iter = mrPopulation.Begin();
+                     cell_iter != mrPopulation.End();
+                     ++cell_iter)
+                {
+                    unsigned elem_index = mrPopulation.GetLocationIndexUsingCell(*cell_iter);
+                    mSink += mrPopulation.GetVolumeOfCell(*cell_iter);
+                    mSink += mrPopulation.rGetMesh().GetSurfaceAreaOfElement(elem_index);
+                }
+            }
+        }
+    };
+
+    /** GetNeighbouringLocationIndices over every cell. */
+    class NeighboursKernel : public Kernel
+    {
+    public:
+        /** The population. */
+        VertexBasedCellPopulation<2>& mrPopulation;
+
+        /** @param rPopulation the population */
+        NeighboursKernel(VertexBasedCellPopulation<2>& rPopulation)
+            : mrPopulation(rPopulation)
+        {
+        }
+
+        void Run(unsigned numIterations)
+        {
+            for (unsigned i=0; i<numIterations; i++)
+            {
+                for (AbstractCellPopulation<2>::Iterator cell_iter = mrPopulation.Begin();
+                     cell_iter != mrPopulation.End();
+                     ++cell_iter)
+                {
+                    mSink += mrPopulation.GetNeighbouringLocationIndices(*cell_iter).size();
+                }
+            }
+        }
+    };
+
+    /** XMLCellWriter::VisitCell over every cell, including the formatting of the output. */
+    class XmlVisitCellKernel : public Kernel
+    {
+    public:
+        /** The population. */
+        VertexBasedCellPopulation<2>& mrPopulation;
+        /** The writer. */
+        XMLCellWriter<2,2>& mrWriter;
+
+        /**
+         * @param rPopulation the population
+         * @param rWriter the writer, with its output file open
+         */
+        XmlVisitCellKernel(VertexBasedCellPopulation<2>& rPopulation, XMLCellWriter<2,2>& rWriter)
+            : mrPopulation(rPopulation),
+              mrWriter(rWriter)
+        {
+        }
+
+        void Run(unsigned numIterations)
+        {
+            for (unsigned i=0; i<numIterations; i++)
+            {
+                for (AbstractCellPopulation<2>::Iterator cell_iter = mrPopulation.Begin();
+                     cell_iter != mrPopulation.End();
+                     ++cell_iter)
+                {
+                    mrWriter.VisitCell(*cell_iter, &mrPopulation);
+                }
+            }
+        }
+    };
+
+    /**
+     * Time a kernel and write its result as one JSON object.
+     *
+     * @param rName the name of the benchmark
+     * @param rKernel the kernel
+     * @param numIterations the number of iterations per repetition
+     * @param itemsPerIteration the number of items (cells, states) per iteration
+     * @param rJson the stream to write the result to
+     * @param isLast whether this is the last result
+     */
+    void RunBenchmark(const std::string& rName, Kernel& rKernel, unsigned numIterations, unsigned itemsPerIteration,
+                      std::ostream& rJson, bool isLast)
+    {
+        for (unsigned r=0; r<NUM_WARMUP_REPETITIONS; r++)
+        {
+            rKernel.Run(numIterations);
+        }
+
+        std::vector<double> ns_per_item;
+        RunningStatistics statistics;
+        for (unsigned r=0; r<NUM_REPETITIONS; r++)
+        {
+            double start_time = GTPaseProfiler::Now();
+            rKernel.Run(numIterations);
+            double ns = 1e9*(GTPaseProfiler::Now() - start_time)/(numIterations*(double)itemsPerIteration);
+            ns_per_item.push_back(ns);
+            statistics.Add(ns);
+        }
+        std::sort(ns_per_item.begin(), ns_per_item.end());
+        double median = 0.5*(ns_per_item[(NUM_REPETITIONS - 1)/2] + ns_per_item[NUM_REPETITIONS/2]);
+
+        rJson << "    {\"name\": \"" << rName << "\""
+              << ", \"iterations_per_repetition\": " << numIterations
+              << ", \"items_per_iteration\": " << itemsPerIteration
+              << ", \"repetitions\": " << NUM_REPETITIONS
+              << ", \"min_ns_per_item\": " << statistics.GetMin()
+              << ", \"median_ns_per_item\": " << median
+              << ", \"mean_ns_per_item\": " << statistics.GetMean()
+              << ", \"stddev_ns_per_item\": " << std::sqrt(statistics.GetVariance())
+              << ", \"checksum\": " << rKernel.mSink
+              << "}" << (isLast ? "" : ",") << "\n";
+
+        std::cout << std::left << std::setw(36) << rName << std::right
+                  << " median " << std::setw(10) << median << " ns/item, min " << std::setw(10) << statistics.GetMin()
+                  << " ns/item, rsd " << 100.0*std::sqrt(statistics.GetVariance())/statistics.GetMean() << "%\n";
+    }
+
+public:
+
+    void TestKernelMicrobenchmarks() throw (Exception)
+    {
+        GTPaseParameterTable::Instance()->Reset();
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 100);
+
+        RandomNumberGenerator* p_random = RandomNumberGenerator::Instance();
+        p_random->Reseed(0);
+
+        // SRN states in the ranges of the oscillating regime
+        std::vector<std::vector<double> > states(NUM_STATES, std::vector<double>(3));
+        for (unsigned i=0; i<NUM_STATES; i++)
+        {
+            states[i][0] = 2.0*p_random->ranf();
+            states[i][1] = 0.3 + 0.8*p_random->ranf();
+            states[i][2] = 0.7 + 0.4*p_random->ranf();
+        }
+
+        // Honeycomb with jittered nodes, so that elements are not all identical hexagons
+        HoneycombVertexMeshGenerator generator(NUM_CELLS_ACROSS, NUM_CELLS_ACROSS);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+        for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+        {
+            c_vector<double, 2>& r_location = p_mesh->GetNode(i)->rGetModifiableLocation();
+            r_location[0] += 0.05*(2.0*p_random->ranf() - 1.0);
+            r_location[1] += 0.05*(2.0*p_random->ranf() - 1.0);
+        }
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<NoCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            const std::vector<double>& r_state = states[cell_iter->GetCellId() % NUM_STATES];
+            cell_iter->GetCellData()->SetItem("G", r_state[0]);
+            cell_iter->GetCellData()->SetItem("target area", r_state[1]);
+            cell_iter->GetCellData()->SetItem("AREA", r_state[2]);
+            cell_iter->GetCellData()->SetItem("volume", cell_population.GetVolumeOfCell(*cell_iter));
+        }
+        unsigned num_cells = cell_population.GetNumRealCells();
+
+        OutputFileHandler output_file_handler("GTPaseMicrobenchmarks/", false);
+        XMLCellWriter<2,2> xml_writer;
+        xml_writer.OpenOutputFile(output_file_handler);
+
+        out_stream p_json_file = output_file_handler.OpenOutputFile("microbenchmarks.json");
+        p_json_file->precision(6);
+        *p_json_file << "{\n"
+                     << "  \"benchmark\": \"kernel_microbenchmarks\",\n"
+                     << "  \"num_cells\": " << num_cells << ",\n"
+                     << "  \"warmup_repetitions\": " << NUM_WARMUP_REPETITIONS << ",\n"
+                     << "  \"results\": [\n";
+
+        EvaluateYDerivativesKernel evaluate_kernel(states);
+        RunBenchmark("ODESRN::EvaluateYDerivatives", evaluate_kernel, 100000, 1, *p_json_file, false);
+
+        Rk4StepKernel rk4_kernel(states);
+        RunBenchmark("ODESrnModel RK4 step", rk4_kernel, 50000, 1, *p_json_file, false);
+
+        CellGeometryKernel geometry_kernel(cell_population);
+        RunBenchmark("GetVolumeOfCell+GetSurfaceAreaOfElement", geometry_kernel, 50, num_cells, *p_json_file, false);
+
+        NeighboursKernel neighbours_kernel(cell_population);
+        RunBenchmark("GetNeighbouringLocationIndices", neighbours_kernel, 20, num_cells, *p_json_file, false);
+
+        XmlVisitCellKernel xml_kernel(cell_population, xml_writer);
+        RunBenchmark("XMLCellWriter::VisitCell", xml_kernel, 5, num_cells, *p_json_file, true);
+
+        *p_json_file << "  ]\n}\n";
+        p_json_file->close();
+        xml_writer.CloseFile();
+    }
+};
+
+#endif /*KERNELMICROBENCHMARKS_HPP_*/
@@ -0,0 +1,106 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "CellStatisticsSummaryModifier.hpp"
+#include "ODESrnModel.hpp"
+#include "SimulationTime.hpp"
+
+#include <climits>
+
+template<unsigned DIM>
+CellStatisticsSummaryModifier<DIM>::CellStatisticsSummaryModifier()
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mSummaryInterval(0),
+      mLastSummaryTimeStep(UINT_MAX)
+{
+}
+
+template<unsigned DIM>
+CellStatisticsSummaryModifier<DIM>::~CellStatisticsSummaryModifier()
+{
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    OutputFileHandler output_file_handler(outputDirectory + "/", false);
+    mpOutStream = output_file_handler.OpenOutputFile("cell_statistics_summary.csv");
+    mLastSummaryTimeStep = UINT_MAX;
+    *mpOutStream << "# TimeStamp,Cell_ID,Num_Samples,G_Mean,G_Variance,G_Min,G_Max,G_Amplitude,"
+                 << "Target_Area_Mean,Target_Area_Variance,Target_Area_Min,Target_Area_Max\n";
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    if (mSummaryInterval > 0 && SimulationTime::Instance()->GetTimeStepsElapsed() % mSummaryInterval == 0)
+    {
+        WriteSummary(rCellPopulation);
+    }
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    // The last time step may already have written its summary
+    if (mLastSummaryTimeStep != SimulationTime::Instance()->GetTimeStepsElapsed())
+    {
+        WriteSummary(rCellPopulation);
+    }
+    mpOutStream->close();
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::WriteSummary(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    double time = SimulationTime::Instance()->GetTime();
+    mLastSummaryTimeStep = SimulationTime::Instance()->GetTimeStepsElapsed();
+
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        ODESrnModel* p_model = dynamic_cast<ODESrnModel*>(cell_iter->GetSrnModel());
+        if (p_model == NULL)
+        {
+            continue;
+        }
+
+        const RunningStatistics& r_G = p_model->rGetGStatistics();
+        const RunningStatistics& r_target_area = p_model->rGetTargetAreaStatistics();
+
+        *mpOutStream << time << "," << cell_iter->GetCellId() << "," << r_G.GetCount()
+                     << "," << r_G.GetMean() << "," << r_G.GetVariance()
+                     << "," << r_G.GetMin() << "," << r_G.GetMax()
+                     << "," << 0.5*(r_G.GetMax() - r_G.GetMin())
+                     << "," << r_target_area.GetMean() << "," << r_target_area.GetVariance()
+                     << "," << r_target_area.GetMin() << "," << r_target_area.GetMax() << "\n";
+    }
+    mpOutStream->flush();
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::SetSummaryInterval(unsigned summaryInterval)
+{
+    mSummaryInterval = summaryInterval;
+}
+
+template<unsigned DIM>
+void CellStatisticsSummaryModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<SummaryInterval>" << mSummaryInterval << "</SummaryInterval>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class CellStatisticsSummaryModifier<1>;
+template class CellStatisticsSummaryModifier<2>;
+template class CellStatisticsSummaryModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(CellStatisticsSummaryModifier)
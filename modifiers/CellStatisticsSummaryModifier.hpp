@@ -0,0 +1,121 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef CELLSTATISTICSSUMMARYMODIFIER_HPP_
+#define CELLSTATISTICSSUMMARYMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * A modifier class which writes a compact per-cell summary of the running
+ * statistics kept by each cell's ODESrnModel: the long-run mean, variance,
+ * minimum, maximum and amplitude of G and of the target area.
+ *
+ * The statistics themselves are updated by ODESrnModel every time step; this
+ * modifier only writes them out, every mSummaryInterval time steps (if
+ * non-zero), whenever WriteSummary() is called (e.g. at a checkpoint) and at
+ * the end of the simulation, where a summary already written at the last time
+ * step is not repeated. The output file is cell_statistics_summary.csv.
+ */
+template<unsigned DIM>
+class CellStatisticsSummaryModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+        archive & mSummaryInterval;
+    }
+
+    /** The number of time steps between intermediate summaries, or 0 to write only at the end. Defaults to 0. */
+    unsigned mSummaryInterval;
+
+    /** The time step of the last summary written, or UINT_MAX if none has been written. */
+    unsigned mLastSummaryTimeStep;
+
+    /** Output file stream for the summaries. */
+    out_stream mpOutStream;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    CellStatisticsSummaryModifier();
+
+    /**
+     * Destructor.
+     */
+    virtual ~CellStatisticsSummaryModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Writes an intermediate summary every mSummaryInterval time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Opens the output file.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * Overridden UpdateAtEndOfSolve() method.
+     *
+     * Writes the final summary, unless the last time step already wrote one,
+     * and closes the output file.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Write one summary line per cell at the current time.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    void WriteSummary(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Set mSummaryInterval.
+     *
+     * @param summaryInterval the number of time steps between intermediate summaries (0 for none)
+     */
+    void SetSummaryInterval(unsigned summaryInterval);
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(CellStatisticsSummaryModifier)
+
+#endif /*CELLSTATISTICSSUMMARYMODIFIER_HPP_*/
@@ -0,0 +1,158 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "CheckpointModifier.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "SimulationTime.hpp"
+#include "Exception.hpp"
+
+#include <cstdio>
+#include <sys/time.h>
+
+namespace
+{
+/** @return the wall-clock time in seconds. */
+double WallClockSeconds()
+{
+    timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + 1e-6*now.tv_usec;
+}
+}
+
+template<unsigned DIM>
+CheckpointModifier<DIM>::CheckpointModifier()
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mCheckpointInterval(0),
+      mCheckpointDirectory(""),
+      mRemoveCheckpointAtEnd(true)
+{
+}
+
+template<unsigned DIM>
+CheckpointModifier<DIM>::~CheckpointModifier()
+{
+}
+
+template<unsigned DIM>
+std::string CheckpointModifier<DIM>::GetCheckpointPath(const std::string& rCheckpointDirectory)
+{
+    OutputFileHandler checkpoint_handler(rCheckpointDirectory + "/", false);
+    return checkpoint_handler.GetOutputDirectoryFullPath() + "checkpoint.bin";
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    mCheckpointPath = GetCheckpointPath(mCheckpointDirectory.empty() ? outputDirectory : mCheckpointDirectory);
+
+    // Solve() has restarted the time stepper at the checkpoint time and the other components have been set up
+    if (mpResumeCheckpoint)
+    {
+        mpResumeCheckpoint->ResumeSimulationTime();
+        mpResumeCheckpoint->RestoreComponents(mCheckpointables);
+        mpResumeCheckpoint.reset();
+    }
+
+    OutputFileHandler output_file_handler(outputDirectory + "/", false);
+    mpOutStream = output_file_handler.OpenOutputFile("checkpoint_timing.csv");
+    *mpOutStream << "# TimeStamp,Bytes,Seconds\n";
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    if (mCheckpointInterval > 0 && SimulationTime::Instance()->GetTimeStepsElapsed() % mCheckpointInterval == 0)
+    {
+        WriteCheckpoint(rCellPopulation);
+    }
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    mpOutStream->close();
+    if (mRemoveCheckpointAtEnd)
+    {
+        std::remove(mCheckpointPath.c_str());
+    }
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::WriteCheckpoint(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    VertexBasedCellPopulation<2>* p_population = dynamic_cast<VertexBasedCellPopulation<2>*>(&rCellPopulation);
+    if (p_population == NULL)
+    {
+        EXCEPTION("CheckpointModifier only supports 2D vertex based simulations");
+    }
+
+    double start = WallClockSeconds();
+    unsigned long num_bytes = TissueCheckpoint::Save(mCheckpointPath, *p_population, mCheckpointables, mScenario);
+    double elapsed = WallClockSeconds() - start;
+
+    *mpOutStream << SimulationTime::Instance()->GetTime() << "," << num_bytes << "," << elapsed << "\n";
+    mpOutStream->flush();
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetCheckpointInterval(unsigned checkpointInterval)
+{
+    mCheckpointInterval = checkpointInterval;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetCheckpointDirectory(const std::string& rCheckpointDirectory)
+{
+    mCheckpointDirectory = rCheckpointDirectory;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetRemoveCheckpointAtEnd(bool removeCheckpointAtEnd)
+{
+    mRemoveCheckpointAtEnd = removeCheckpointAtEnd;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::AddCheckpointable(const std::string& rName, boost::shared_ptr<AbstractCheckpointable> pCheckpointable)
+{
+    if (mCheckpointables.find(rName) != mCheckpointables.end())
+    {
+        EXCEPTION("A component called " + rName + " is already checkpointed");
+    }
+    mCheckpointables[rName] = pCheckpointable;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetScenario(const std::string& rScenario)
+{
+    mScenario = rScenario;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::SetResumeCheckpoint(boost::shared_ptr<TissueCheckpoint> pCheckpoint)
+{
+    mpResumeCheckpoint = pCheckpoint;
+}
+
+template<unsigned DIM>
+void CheckpointModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<CheckpointInterval>" << mCheckpointInterval << "</CheckpointInterval>\n";
+    *rParamsFile << "\t\t\t<CheckpointDirectory>" << mCheckpointDirectory << "</CheckpointDirectory>\n";
+    *rParamsFile << "\t\t\t<RemoveCheckpointAtEnd>" << mRemoveCheckpointAtEnd << "</RemoveCheckpointAtEnd>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class CheckpointModifier<1>;
+template class CheckpointModifier<2>;
+template class CheckpointModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(CheckpointModifier)
@@ -0,0 +1,199 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef CHECKPOINTMODIFIER_HPP_
+#define CHECKPOINTMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/string.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "AbstractCheckpointable.hpp"
+#include "OutputFileHandler.hpp"
+#include "TissueCheckpoint.hpp"
+
+/**
+ * A modifier class which writes a TissueCheckpoint of a 2D vertex population
+ * every mCheckpointInterval time steps, replacing the previous one, so that a
+ * crashed run can be resumed from the last checkpoint rather than from t=0.
+ *
+ * The checkpoint is written to checkpoint.bin in the checkpoint directory,
+ * which defaults to the simulation output directory; set it outside the
+ * simulation output directory when restarting, since Chaste cleans
+ * results_from_time_* directories. The wall-clock cost and size of every
+ * checkpoint are written to checkpoint_timing.csv in the simulation output
+ * directory, to help choose the interval. The checkpoint is removed at the end
+ * of a completed solve unless SetRemoveCheckpointAtEnd(false) is called.
+ *
+ * Writers and modifiers whose output depends on earlier samples are registered
+ * with AddCheckpointable() and their state is saved with every checkpoint. To
+ * resume, pass the checkpoint to SetResumeCheckpoint(): SetupSolve() then
+ * restores the time stepper of the interrupted run and the state of the
+ * registered components, so the resumed run continues exactly where the
+ * interrupted one left off. This modifier must therefore be added after every
+ * stateful modifier, whose own SetupSolve() would otherwise clear the restored
+ * state.
+ */
+template<unsigned DIM>
+class CheckpointModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+        archive & mCheckpointInterval;
+        archive & mCheckpointDirectory;
+        archive & mRemoveCheckpointAtEnd;
+    }
+
+    /** The number of time steps between checkpoints, or 0 for none. Defaults to 0. */
+    unsigned mCheckpointInterval;
+
+    /** The checkpoint directory, relative to where Chaste output is stored, or empty for the simulation output directory. */
+    std::string mCheckpointDirectory;
+
+    /** Whether to remove the checkpoint at the end of the solve. Defaults to true. */
+    bool mRemoveCheckpointAtEnd;
+
+    /** The full path of the checkpoint file, set in SetupSolve(). */
+    std::string mCheckpointPath;
+
+    /** The writers and modifiers whose state is checkpointed. Not archived. */
+    TissueCheckpoint::ComponentMap mCheckpointables;
+
+    /** The settings that define the tissue, saved with every checkpoint. Not archived. */
+    std::string mScenario;
+
+    /** The checkpoint being resumed from, if any, used by the next SetupSolve(). Not archived. */
+    boost::shared_ptr<TissueCheckpoint> mpResumeCheckpoint;
+
+    /** Output file stream for the checkpoint costs. */
+    out_stream mpOutStream;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    CheckpointModifier();
+
+    /**
+     * Destructor.
+     */
+    virtual ~CheckpointModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Writes a checkpoint every mCheckpointInterval time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Creates the checkpoint directory and opens the timing file. When resuming,
+     * also restores SimulationTime and the state of the registered components.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * Overridden UpdateAtEndOfSolve() method.
+     *
+     * Closes the timing file and removes the checkpoint if required.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Write a checkpoint at the current time.
+     *
+     * @param rCellPopulation reference to the cell population, which must be a 2D VertexBasedCellPopulation
+     */
+    void WriteCheckpoint(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Set mCheckpointInterval.
+     *
+     * @param checkpointInterval the number of time steps between checkpoints (0 for none)
+     */
+    void SetCheckpointInterval(unsigned checkpointInterval);
+
+    /**
+     * Set mCheckpointDirectory.
+     *
+     * @param rCheckpointDirectory the directory, relative to where Chaste output is stored
+     */
+    void SetCheckpointDirectory(const std::string& rCheckpointDirectory);
+
+    /**
+     * Set mRemoveCheckpointAtEnd.
+     *
+     * @param removeCheckpointAtEnd whether to remove the checkpoint when the solve completes
+     */
+    void SetRemoveCheckpointAtEnd(bool removeCheckpointAtEnd);
+
+    /**
+     * Register a writer or modifier whose state is saved with every checkpoint.
+     *
+     * @param rName a unique name, under which the state is saved
+     * @param pCheckpointable the writer or modifier
+     */
+    void AddCheckpointable(const std::string& rName, boost::shared_ptr<AbstractCheckpointable> pCheckpointable);
+
+    /**
+     * Set the description of the scenario saved with every checkpoint, see
+     * TissueCheckpoint::CheckScenario().
+     *
+     * @param rScenario the settings that define the tissue, one "key = value" per line
+     */
+    void SetScenario(const std::string& rScenario);
+
+    /**
+     * Set the checkpoint to resume from in the next solve. Its
+     * RestoreSimulationTime(), CreateMesh(), CreateCells() and
+     * RestoreCellStates() must already have been used to set up the simulation.
+     *
+     * @param pCheckpoint the checkpoint
+     */
+    void SetResumeCheckpoint(boost::shared_ptr<TissueCheckpoint> pCheckpoint);
+
+    /**
+     * @param rCheckpointDirectory a checkpoint directory, relative to where Chaste output is stored
+     * @return the full path of the checkpoint file written to that directory
+     */
+    static std::string GetCheckpointPath(const std::string& rCheckpointDirectory);
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(CheckpointModifier)
+
+#endif /*CHECKPOINTMODIFIER_HPP_*/
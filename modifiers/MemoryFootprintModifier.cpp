@@ -0,0 +1,118 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "MemoryFootprintModifier.hpp"
+#include "MemoryFootprint.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "SimulationTime.hpp"
+#include "Exception.hpp"
+
+#include <iostream>
+
+template<unsigned DIM>
+MemoryFootprintModifier<DIM>::MemoryFootprintModifier()
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mReportInterval(0)
+{
+}
+
+template<unsigned DIM>
+MemoryFootprintModifier<DIM>::~MemoryFootprintModifier()
+{
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    OutputFileHandler output_file_handler(outputDirectory + "/", false);
+    mpOutStream = output_file_handler.OpenOutputFile("memory_footprint.csv");
+    MemoryFootprint::WriteHeader(*mpOutStream);
+    mpSummaryStream = output_file_handler.OpenOutputFile("memory_footprint.txt");
+
+    WriteReport(rCellPopulation, true);
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    if (mReportInterval > 0 && SimulationTime::Instance()->GetTimeStepsElapsed() % mReportInterval == 0)
+    {
+        WriteReport(rCellPopulation, false);
+    }
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    mpOutStream->close();
+    mpSummaryStream->close();
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::WriteReport(AbstractCellPopulation<DIM,DIM>& rCellPopulation, bool writeToStdout)
+{
+    VertexBasedCellPopulation<2>* p_population = dynamic_cast<VertexBasedCellPopulation<2>*>(&rCellPopulation);
+    if (p_population == NULL)
+    {
+        EXCEPTION("MemoryFootprintModifier only supports 2D vertex based simulations");
+    }
+
+    MemoryFootprint footprint;
+    footprint.Measure(*p_population);
+    for (unsigned i=0; i<mCellWriters.size(); i++)
+    {
+        footprint.AddWriterBuffer(mCellWriters[i].first, mCellWriters[i].second->GetBufferedBytes());
+    }
+    for (unsigned i=0; i<mPopulationWriters.size(); i++)
+    {
+        footprint.AddWriterBuffer(mPopulationWriters[i].first, mPopulationWriters[i].second->GetBufferedBytes());
+    }
+
+    double time = SimulationTime::Instance()->GetTime();
+    footprint.WriteRow(*mpOutStream, time);
+    mpOutStream->flush();
+    footprint.WriteSummary(*mpSummaryStream, time);
+    mpSummaryStream->flush();
+    if (writeToStdout)
+    {
+        footprint.WriteSummary(std::cout, time);
+    }
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::SetReportInterval(unsigned reportInterval)
+{
+    mReportInterval = reportInterval;
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::AddCellWriter(const std::string& rName, boost::shared_ptr<AbstractSampledCellWriter<DIM,DIM> > pWriter)
+{
+    mCellWriters.push_back(std::make_pair(rName, pWriter));
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::AddPopulationWriter(const std::string& rName, boost::shared_ptr<AbstractSampledPopulationWriter<DIM,DIM> > pWriter)
+{
+    mPopulationWriters.push_back(std::make_pair(rName, pWriter));
+}
+
+template<unsigned DIM>
+void MemoryFootprintModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<ReportInterval>" << mReportInterval << "</ReportInterval>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class MemoryFootprintModifier<1>;
+template class MemoryFootprintModifier<2>;
+template class MemoryFootprintModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(MemoryFootprintModifier)
@@ -0,0 +1,149 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef MEMORYFOOTPRINTMODIFIER_HPP_
+#define MEMORYFOOTPRINTMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "AbstractSampledCellWriter.hpp"
+#include "AbstractSampledPopulationWriter.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * A modifier class which reports the memory footprint of a 2D vertex
+ * population, as accounted by MemoryFootprint, at the start of the solve and
+ * every mReportInterval time steps (set it to the checkpoint interval to
+ * report at each checkpoint).
+ *
+ * Each report appends a row to memory_footprint.csv and a table of bytes per
+ * cell by component to memory_footprint.txt; the table at the start is also
+ * written to std::cout. Writers registered with AddCellWriter() and
+ * AddPopulationWriter() are included in the writer_buffers component.
+ */
+template<unsigned DIM>
+class MemoryFootprintModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+        archive & mReportInterval;
+    }
+
+    /** The number of time steps between reports, or 0 for a report at the start only. Defaults to 0. */
+    unsigned mReportInterval;
+
+    /** The registered cell writers and their names. Not archived. */
+    std::vector<std::pair<std::string, boost::shared_ptr<AbstractSampledCellWriter<DIM,DIM> > > > mCellWriters;
+
+    /** The registered population writers and their names. Not archived. */
+    std::vector<std::pair<std::string, boost::shared_ptr<AbstractSampledPopulationWriter<DIM,DIM> > > > mPopulationWriters;
+
+    /** Output file stream for the per-report rows. */
+    out_stream mpOutStream;
+
+    /** Output file stream for the per-report tables. */
+    out_stream mpSummaryStream;
+
+    /**
+     * Measure the population and write a report.
+     *
+     * @param rCellPopulation reference to the cell population, which must be a 2D VertexBasedCellPopulation
+     * @param writeToStdout whether to write the table to std::cout as well
+     */
+    void WriteReport(AbstractCellPopulation<DIM,DIM>& rCellPopulation, bool writeToStdout);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    MemoryFootprintModifier();
+
+    /**
+     * Destructor.
+     */
+    virtual ~MemoryFootprintModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Writes a report every mReportInterval time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Opens the output files and writes the first report.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * Overridden UpdateAtEndOfSolve() method.
+     *
+     * Closes the output files.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Set mReportInterval.
+     *
+     * @param reportInterval the number of time steps between reports (0 for a report at the start only)
+     */
+    void SetReportInterval(unsigned reportInterval);
+
+    /**
+     * Include the buffered state of a cell writer in the reports.
+     *
+     * @param rName the name of the writer in the reports
+     * @param pWriter the writer
+     */
+    void AddCellWriter(const std::string& rName, boost::shared_ptr<AbstractSampledCellWriter<DIM,DIM> > pWriter);
+
+    /**
+     * Include the buffered state of a population writer in the reports.
+     *
+     * @param rName the name of the writer in the reports
+     * @param pWriter the writer
+     */
+    void AddPopulationWriter(const std::string& rName, boost::shared_ptr<AbstractSampledPopulationWriter<DIM,DIM> > pWriter);
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(MemoryFootprintModifier)
+
+#endif /*MEMORYFOOTPRINTMODIFIER_HPP_*/
@@ -6,6 +6,7 @@
  */
 
 #include "ODEParameterAreaModifier.hpp"
+#include "GTPaseProfiler.hpp"
 #include "MeshBasedCellPopulation.hpp"
 #include "AbstractOdeSrnModel.hpp"
 #include "AbstractSrnModel.hpp"
@@ -36,6 +37,9 @@ void ODEParameterAreaModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>&
 template<unsigned DIM>
 void ODEParameterAreaModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
+    GTPASE_PROFILE_SCOPE(ODE_PARAMETER_AREA_MODIFIER);
+    GTPASE_PROFILE_COUNT(ODE_PARAMETER_AREA_MODIFIER, rCellPopulation.GetNumRealCells());
+
     // Make sure the cell population is updated
     rCellPopulation.Update();
 
@@ -0,0 +1,179 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "OscillationSpectrumModifier.hpp"
+#include "SimulationTime.hpp"
+#include "CheckpointStream.hpp"
+#include "Exception.hpp"
+
+template<unsigned DIM>
+OscillationSpectrumModifier<DIM>::OscillationSpectrumModifier()
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mSamplingTimestepMultiple(200),
+      mBlockLength(256),
+      mMinFrequency(0.001),
+      mMaxFrequency(0.1),
+      mNumFrequencies(100)
+{
+}
+
+template<unsigned DIM>
+OscillationSpectrumModifier<DIM>::~OscillationSpectrumModifier()
+{
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    mFilterBanks.clear();
+
+    OutputFileHandler output_file_handler(outputDirectory + "/", false);
+    mpOutStream = output_file_handler.OpenOutputFile("oscillation_spectrum.csv");
+    *mpOutStream << "# TimeStamp,Cell_ID,Dominant_Frequency,Amplitude,Mean_G\n";
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    SimulationTime* p_time = SimulationTime::Instance();
+    if (p_time->GetTimeStepsElapsed() % mSamplingTimestepMultiple != 0)
+    {
+        return;
+    }
+
+    // The frequencies are the same for every cell, so build them once per sample
+    std::vector<double> frequencies = GetFrequencies();
+    double sample_spacing = mSamplingTimestepMultiple*p_time->GetTimeStep();
+    double time = p_time->GetTime();
+
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        unsigned cell_id = cell_iter->GetCellId();
+
+        std::map<unsigned, GoertzelBank>::iterator bank_iter = mFilterBanks.find(cell_id);
+        if (bank_iter == mFilterBanks.end())
+        {
+            bank_iter = mFilterBanks.insert(std::make_pair(cell_id, GoertzelBank(frequencies, sample_spacing, mBlockLength))).first;
+        }
+
+        double G = cell_iter->GetCellData()->GetItem("G");
+        if (bank_iter->second.AddSample(G))
+        {
+            *mpOutStream << time << "," << cell_id
+                         << "," << bank_iter->second.GetDominantFrequency()
+                         << "," << bank_iter->second.GetDominantAmplitude()
+                         << "," << bank_iter->second.GetBlockMean() << "\n";
+        }
+    }
+}
+
+template<unsigned DIM>
+std::vector<double> OscillationSpectrumModifier<DIM>::GetFrequencies() const
+{
+    std::vector<double> frequencies(mNumFrequencies);
+    for (unsigned i=0; i<mNumFrequencies; i++)
+    {
+        frequencies[i] = (mNumFrequencies == 1) ? mMinFrequency
+                       : mMinFrequency + i*(mMaxFrequency - mMinFrequency)/(mNumFrequencies - 1);
+    }
+    return frequencies;
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    if (mpOutStream)
+    {
+        mpOutStream->close();
+    }
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple)
+{
+    if (samplingTimestepMultiple == 0)
+    {
+        EXCEPTION("The sampling timestep multiple must be positive");
+    }
+    mSamplingTimestepMultiple = samplingTimestepMultiple;
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::SetBlockLength(unsigned blockLength)
+{
+    if (blockLength == 0)
+    {
+        EXCEPTION("The block length must be positive");
+    }
+    mBlockLength = blockLength;
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::SetFrequencyBand(double minFrequency, double maxFrequency, unsigned numFrequencies)
+{
+    if (minFrequency < 0.0 || maxFrequency < minFrequency || numFrequencies == 0)
+    {
+        EXCEPTION("Invalid frequency band");
+    }
+    mMinFrequency = minFrequency;
+    mMaxFrequency = maxFrequency;
+    mNumFrequencies = numFrequencies;
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::SaveCheckpointState(std::ostream& rStream) const
+{
+    CheckpointStream::WriteValue(rStream, (boost::uint64_t)mFilterBanks.size());
+    for (std::map<unsigned, GoertzelBank>::const_iterator iter = mFilterBanks.begin();
+         iter != mFilterBanks.end();
+         ++iter)
+    {
+        CheckpointStream::WriteValue(rStream, (boost::uint32_t)iter->first);
+        iter->second.SaveState(rStream);
+    }
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::LoadCheckpointState(std::istream& rStream)
+{
+    std::vector<double> frequencies = GetFrequencies();
+    double sample_spacing = mSamplingTimestepMultiple*SimulationTime::Instance()->GetTimeStep();
+
+    boost::uint64_t num_banks;
+    CheckpointStream::ReadValue(rStream, num_banks);
+    mFilterBanks.clear();
+    for (unsigned i=0; i<num_banks; i++)
+    {
+        boost::uint32_t cell_id;
+        CheckpointStream::ReadValue(rStream, cell_id);
+        std::map<unsigned, GoertzelBank>::iterator bank_iter =
+            mFilterBanks.insert(std::make_pair((unsigned)cell_id, GoertzelBank(frequencies, sample_spacing, mBlockLength))).first;
+        bank_iter->second.LoadState(rStream);
+    }
+}
+
+template<unsigned DIM>
+void OscillationSpectrumModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<SamplingTimestepMultiple>" << mSamplingTimestepMultiple << "</SamplingTimestepMultiple>\n";
+    *rParamsFile << "\t\t\t<BlockLength>" << mBlockLength << "</BlockLength>\n";
+    *rParamsFile << "\t\t\t<MinFrequency>" << mMinFrequency << "</MinFrequency>\n";
+    *rParamsFile << "\t\t\t<MaxFrequency>" << mMaxFrequency << "</MaxFrequency>\n";
+    *rParamsFile << "\t\t\t<NumFrequencies>" << mNumFrequencies << "</NumFrequencies>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class OscillationSpectrumModifier<1>;
+template class OscillationSpectrumModifier<2>;
+template class OscillationSpectrumModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(OscillationSpectrumModifier)
@@ -0,0 +1,167 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef OSCILLATIONSPECTRUMMODIFIER_HPP_
+#define OSCILLATIONSPECTRUMMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <map>
+#include <vector>
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "AbstractCheckpointable.hpp"
+#include "OutputFileHandler.hpp"
+#include "GoertzelBank.hpp"
+
+/**
+ * A modifier class which computes the oscillation spectrum of each cell's
+ * GTPase concentration ("G" in CellData) while the simulation runs.
+ *
+ * G is sampled every mSamplingTimestepMultiple time steps and fed to a bank of
+ * Goertzel filters covering [mMinFrequency, mMaxFrequency]. Each time a cell
+ * has accumulated mBlockLength samples, its dominant frequency, the amplitude
+ * at that frequency and the block mean are written to oscillation_spectrum.csv,
+ * replacing the offline FFT in GTPase_plot.py. The partly filled blocks are
+ * checkpointed, so a resumed run reports the same spectra.
+ */
+template<unsigned DIM>
+class OscillationSpectrumModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>, public AbstractCheckpointable
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+        archive & mSamplingTimestepMultiple;
+        archive & mBlockLength;
+        archive & mMinFrequency;
+        archive & mMaxFrequency;
+        archive & mNumFrequencies;
+    }
+
+    /** The number of time steps between samples of G. Defaults to 200. */
+    unsigned mSamplingTimestepMultiple;
+
+    /** The number of samples per spectrum. Defaults to 256. */
+    unsigned mBlockLength;
+
+    /** The lowest frequency evaluated. Defaults to 0.001. */
+    double mMinFrequency;
+
+    /** The highest frequency evaluated. Defaults to 0.1. */
+    double mMaxFrequency;
+
+    /** The number of frequencies evaluated, evenly spaced over the band. Defaults to 100. */
+    unsigned mNumFrequencies;
+
+    /** The filter bank of each cell, keyed by cell ID. Not archived, but checkpointed. */
+    std::map<unsigned, GoertzelBank> mFilterBanks;
+
+    /** Output file stream for the spectrum results. */
+    out_stream mpOutStream;
+
+    /** @return the frequencies evaluated by the filter banks. */
+    std::vector<double> GetFrequencies() const;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    OscillationSpectrumModifier();
+
+    /**
+     * Destructor.
+     */
+    virtual ~OscillationSpectrumModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Specify what to do in the simulation at the end of each time step.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Opens the output file and clears any filter state.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * Overridden UpdateAtEndOfSolve() method.
+     *
+     * Closes the output file.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Set mSamplingTimestepMultiple.
+     *
+     * @param samplingTimestepMultiple the number of time steps between samples of G
+     */
+    void SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple);
+
+    /**
+     * Set mBlockLength.
+     *
+     * @param blockLength the number of samples per spectrum
+     */
+    void SetBlockLength(unsigned blockLength);
+
+    /**
+     * Set the frequency band evaluated by the filter banks.
+     *
+     * @param minFrequency the lowest frequency
+     * @param maxFrequency the highest frequency
+     * @param numFrequencies the number of evenly spaced frequencies in the band
+     */
+    void SetFrequencyBand(double minFrequency, double maxFrequency, unsigned numFrequencies);
+
+    /**
+     * Overridden SaveCheckpointState() method, which writes the filter bank of each cell.
+     *
+     * @param rStream the stream
+     */
+    void SaveCheckpointState(std::ostream& rStream) const;
+
+    /**
+     * Overridden LoadCheckpointState() method. SimulationTime must already
+     * have the time step of the run, which sets the sample spacing.
+     *
+     * @param rStream the stream
+     */
+    void LoadCheckpointState(std::istream& rStream);
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(OscillationSpectrumModifier)
+
+#endif /*OSCILLATIONSPECTRUMMODIFIER_HPP_*/
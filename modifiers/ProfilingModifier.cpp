@@ -0,0 +1,142 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "ProfilingModifier.hpp"
+#include "GTPaseProfiler.hpp"
+#include "SimulationTime.hpp"
+#include "Exception.hpp"
+
+#include <iostream>
+
+template<unsigned DIM>
+ProfilingModifier<DIM>::ProfilingModifier()
+    : AbstractCellBasedSimulationModifier<DIM>(),
+      mSamplingTimestepMultiple(1),
+      mHardwareCounters(false),
+      mStartWallTime(0.0),
+      mSampleStartWallTime(0.0),
+      mNumStepsInSample(0),
+      mNumSteps(0)
+{
+}
+
+template<unsigned DIM>
+ProfilingModifier<DIM>::~ProfilingModifier()
+{
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    mOutputDirectory = outputDirectory;
+    OutputFileHandler output_file_handler(outputDirectory + "/", false);
+    mpOutStream = output_file_handler.OpenOutputFile("phase_timing.csv");
+    GTPaseProfiler::WriteSampleHeader(*mpOutStream);
+
+    if (mHardwareCounters)
+    {
+        if (GTPaseProfiler::EnableHardwareCounters())
+        {
+            mpCountersStream = output_file_handler.OpenOutputFile("phase_counters.csv");
+            GTPaseProfiler::WriteCounterSampleHeader(*mpCountersStream);
+        }
+        else
+        {
+            std::cout << "Hardware counters not recorded: " << GTPaseProfiler::rGetHardwareCounterStatus() << "\n";
+        }
+    }
+
+    // Time spent setting up the simulation is not part of any step
+    GTPaseProfiler::Reset();
+    mStartWallTime = GTPaseProfiler::Now();
+    mSampleStartWallTime = mStartWallTime;
+    mNumStepsInSample = 0;
+    mNumSteps = 0;
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    mNumStepsInSample++;
+    mNumSteps++;
+    if (mNumStepsInSample == mSamplingTimestepMultiple)
+    {
+        double now = GTPaseProfiler::Now();
+        GTPaseProfiler::WriteSample(*mpOutStream, SimulationTime::Instance()->GetTime(), mNumStepsInSample, now - mSampleStartWallTime);
+        if (mpCountersStream)
+        {
+            GTPaseProfiler::WriteCounterSample(*mpCountersStream, SimulationTime::Instance()->GetTime());
+        }
+        GTPaseProfiler::ResetSample();
+        mSampleStartWallTime = now;
+        mNumStepsInSample = 0;
+    }
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    double now = GTPaseProfiler::Now();
+    if (mNumStepsInSample > 0)
+    {
+        GTPaseProfiler::WriteSample(*mpOutStream, SimulationTime::Instance()->GetTime(), mNumStepsInSample, now - mSampleStartWallTime);
+        if (mpCountersStream)
+        {
+            GTPaseProfiler::WriteCounterSample(*mpCountersStream, SimulationTime::Instance()->GetTime());
+        }
+    }
+    mpOutStream->close();
+    if (mpCountersStream)
+    {
+        mpCountersStream->close();
+        mpCountersStream.reset();
+    }
+
+    OutputFileHandler output_file_handler(mOutputDirectory + "/", false);
+    out_stream p_summary_file = output_file_handler.OpenOutputFile("phase_summary.txt");
+    GTPaseProfiler::WriteSummary(*p_summary_file, mNumSteps, now - mStartWallTime);
+    p_summary_file->close();
+    GTPaseProfiler::WriteSummary(std::cout, mNumSteps, now - mStartWallTime);
+
+    if (mHardwareCounters)
+    {
+        GTPaseProfiler::DisableHardwareCounters();
+    }
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple)
+{
+    if (samplingTimestepMultiple == 0)
+    {
+        EXCEPTION("The sampling timestep multiple must be positive");
+    }
+    mSamplingTimestepMultiple = samplingTimestepMultiple;
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::SetHardwareCounters(bool hardwareCounters)
+{
+    mHardwareCounters = hardwareCounters;
+}
+
+template<unsigned DIM>
+void ProfilingModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    *rParamsFile << "\t\t\t<SamplingTimestepMultiple>" << mSamplingTimestepMultiple << "</SamplingTimestepMultiple>\n";
+    *rParamsFile << "\t\t\t<HardwareCounters>" << mHardwareCounters << "</HardwareCounters>\n";
+
+    // Call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class ProfilingModifier<1>;
+template class ProfilingModifier<2>;
+template class ProfilingModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(ProfilingModifier)
@@ -0,0 +1,146 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef PROFILINGMODIFIER_HPP_
+#define PROFILINGMODIFIER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * A modifier class which writes the timings collected by GTPaseProfiler.
+ *
+ * Every mSamplingTimestepMultiple time steps a row is appended to
+ * phase_timing.csv with the wall time of the sample and the exclusive time
+ * and number of calls of each phase during it. At the end of the simulation
+ * the summary table is written to phase_summary.txt and to std::cout.
+ *
+ * With SetHardwareCounters(true), the exclusive hardware counts of each
+ * phase are also written to phase_counters.csv and summarised in
+ * phase_summary.txt. If the kernel does not allow perf events, only the
+ * timings are written and the summary says why.
+ *
+ * The wall time of a step is measured from one UpdateAtEndOfTimeStep() to
+ * the next, so this modifier should be added after the other modifiers. The
+ * phase timers only record anything when the code is compiled with
+ * GTPASE_ENABLE_PROFILING.
+ */
+template<unsigned DIM>
+class ProfilingModifier : public AbstractCellBasedSimulationModifier<DIM,DIM>
+{
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Boost Serialization method for archiving/checkpointing.
+     * Archives the object and its member variables.
+     *
+     * @param archive  The boost archive.
+     * @param version  The current version of this class.
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellBasedSimulationModifier<DIM,DIM> >(*this);
+        archive & mSamplingTimestepMultiple;
+        archive & mHardwareCounters;
+    }
+
+    /** The number of time steps per row of phase_timing.csv. Defaults to 1. */
+    unsigned mSamplingTimestepMultiple;
+
+    /** Whether to record hardware counters. Defaults to false. */
+    bool mHardwareCounters;
+
+    /** Output file stream for the per-sample timings. */
+    out_stream mpOutStream;
+
+    /** Output file stream for the per-sample hardware counts, if they are recorded. */
+    out_stream mpCountersStream;
+
+    /** The output directory, where the summary is written. */
+    std::string mOutputDirectory;
+
+    /** The wall time at the end of SetupSolve(). */
+    double mStartWallTime;
+
+    /** The wall time at the start of the current sample. */
+    double mSampleStartWallTime;
+
+    /** The number of time steps in the current sample. */
+    unsigned mNumStepsInSample;
+
+    /** The number of time steps since SetupSolve(). */
+    unsigned mNumSteps;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    ProfilingModifier();
+
+    /**
+     * Destructor.
+     */
+    virtual ~ProfilingModifier();
+
+    /**
+     * Overridden UpdateAtEndOfTimeStep() method.
+     *
+     * Writes a row of phase_timing.csv every mSamplingTimestepMultiple time steps.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Overridden SetupSolve() method.
+     *
+     * Resets the profiler and opens the output file.
+     *
+     * @param rCellPopulation reference to the cell population
+     * @param outputDirectory the output directory, relative to where Chaste output is stored
+     */
+    virtual void SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory);
+
+    /**
+     * Overridden UpdateAtEndOfSolve() method.
+     *
+     * Writes the last partial sample and the summary table.
+     *
+     * @param rCellPopulation reference to the cell population
+     */
+    virtual void UpdateAtEndOfSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation);
+
+    /**
+     * Set mSamplingTimestepMultiple.
+     *
+     * @param samplingTimestepMultiple the number of time steps per row of phase_timing.csv
+     */
+    void SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple);
+
+    /**
+     * Set mHardwareCounters.
+     *
+     * @param hardwareCounters whether to record hardware counters per phase
+     */
+    void SetHardwareCounters(bool hardwareCounters);
+
+    /**
+     * Overridden OutputSimulationModifierParameters() method.
+     * Output any simulation modifier parameters to file.
+     *
+     * @param rParamsFile the file stream to which the parameters are output
+     */
+    void OutputSimulationModifierParameters(out_stream& rParamsFile);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(ProfilingModifier)
+
+#endif /*PROFILINGMODIFIER_HPP_*/
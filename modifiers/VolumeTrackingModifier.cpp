@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "VolumeTrackingModifier.hpp"
+#include "GTPaseProfiler.hpp"
 #include "MeshBasedCellPopulation.hpp"
 
 template<unsigned DIM>
@@ -66,6 +67,9 @@ void VolumeTrackingModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rC
 template<unsigned DIM>
 void VolumeTrackingModifier<DIM>::UpdateCellData(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
+    GTPASE_PROFILE_SCOPE(VOLUME_TRACKING_MODIFIER);
+    GTPASE_PROFILE_COUNT(VOLUME_TRACKING_MODIFIER, rCellPopulation.GetNumRealCells());
+
     // Make sure the cell population is updated
     rCellPopulation.Update();
 
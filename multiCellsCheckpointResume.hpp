@@ -0,0 +1,234 @@
+#ifndef MULTICELLSCHECKPOINTRESUME_HPP_
+#define MULTICELLSCHECKPOINTRESUME_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "PetscSetupAndFinalize.hpp"
+#include "Exception.hpp"
+#include "OutputFileHandler.hpp"
+#include "FileFinder.hpp"
+#include "SimulationTime.hpp"
+
+#include "ScenarioConfig.hpp"
+#include "GTPaseScenario.hpp"
+#include "CheckpointModifier.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+/**
+ * Checks that resuming from a checkpoint reproduces an uninterrupted run.
+ *
+ * A small tissue is run straight through to t=8. The same scenario is then
+ * run to t=5, keeping its last checkpoint as an interrupted run would, and
+ * resumed to t=8. The records written by the interrupted run up to t=5 and by
+ * the resumed run after t=5 must be identical, as text, to those of the
+ * uninterrupted run: same times, same step counts (tau in cell_data.xml), same
+ * delta frames, topology events and oscillation spectra.
+ *
+ * The time step is a power of two, so the time of every step is exact and
+ * does not depend on the end time of the run.
+ */
+class multiCellsCheckpointResume : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** The records of an output file: the time of each and its text. */
+    typedef std::vector<std::pair<double, std::string> > RecordList;
+
+    /**
+     * Read the records of an output file: every <time> frame of an XML file,
+     * or every line of a text file other than comments.
+     *
+     * @param rFileName the full path of the file
+     * @return the records, in file order
+     */
+    RecordList ReadRecords(const std::string& rFileName)
+    {
+        std::ifstream file(rFileName.c_str());
+        if (!file.is_open())
+        {
+            EXCEPTION("Could not open " + rFileName);
+        }
+
+        RecordList records;
+        bool in_frame = false;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.compare(0, 9, "<time t=\"") == 0)
+            {
+                records.push_back(std::make_pair(atof(line.c_str() + 9), line + "\n"));
+                in_frame = true;
+            }
+            else if (in_frame)
+            {
+                records.back().second += line + "\n";
+                in_frame = (line != "</time>");
+            }
+            else if (!line.empty() && line[0] != '#' && line[0] != '<')
+            {
+                records.push_back(std::make_pair(atof(line.c_str()), line));
+            }
+        }
+        return records;
+    }
+
+    /**
+     * Check that the records of the interrupted run up to the resume time,
+     * followed by those of the resumed run after it, are those of the
+     * uninterrupted run. The resumed run also writes the frame at the resume
+     * time, which the interrupted run has already written.
+     *
+     * @param rFileName the name of the output file
+     * @param rStraightDirectory the results directory of the uninterrupted run
+     * @param rInterruptedDirectory the results directory of the interrupted run
+     * @param rResumedDirectory the results directory of the resumed run
+     * @param resumeTime the time of the checkpoint
+     */
+    void CompareResumedRecords(const std::string& rFileName,
+                               const std::string& rStraightDirectory,
+                               const std::string& rInterruptedDirectory,
+                               const std::string& rResumedDirectory,
+                               double resumeTime)
+    {
+        RecordList expected = ReadRecords(rStraightDirectory + rFileName);
+        RecordList interrupted = ReadRecords(rInterruptedDirectory + rFileName);
+        RecordList resumed = ReadRecords(rResumedDirectory + rFileName);
+
+        RecordList spliced;
+        unsigned num_resumed = 0;
+        for (unsigned i=0; i<interrupted.size(); i++)
+        {
+            if (interrupted[i].first <= resumeTime)
+            {
+                spliced.push_back(interrupted[i]);
+            }
+        }
+        for (unsigned i=0; i<resumed.size(); i++)
+        {
+            if (resumed[i].first > resumeTime)
+            {
+                spliced.push_back(resumed[i]);
+                num_resumed++;
+            }
+        }
+
+        // Otherwise the comparison says nothing about resuming
+        TS_ASSERT_LESS_THAN(0u, num_resumed);
+
+        TS_ASSERT_EQUALS(spliced.size(), expected.size());
+        for (unsigned i=0; i<spliced.size() && i<expected.size(); i++)
+        {
+            if (spliced[i].second != expected[i].second)
+            {
+                std::ostringstream message;
+                message << rFileName << " differs from the uninterrupted run at t=" << expected[i].first
+                        << ":\n" << expected[i].second << "\nresumed:\n" << spliced[i].second;
+                TS_FAIL(message.str());
+                break;
+            }
+        }
+    }
+
+    /**
+     * @param rEndTime the end time
+     * @param rOutputDirectory the output directory
+     * @return the scenario used by every run of this test
+     */
+    ScenarioConfig MakeConfig(const std::string& rEndTime, const std::string& rOutputDirectory)
+    {
+        ScenarioConfig config;
+        config.Set("output_directory", rOutputDirectory);
+        config.Set("num_cells_across", "6");
+        config.Set("num_cells_up", "6");
+        config.Set("beta_spread", "0.05");
+        config.Set("dt", "0.0078125");
+        config.Set("end_time", rEndTime);
+        config.Set("sampling_multiple", "2");
+        config.Set("csv_writer_multiple", "8");
+        config.Set("statistics_writer_multiple", "8");
+        config.Set("topology_writer_multiple", "16");
+        config.Set("topology_event_writer_multiple", "2");
+        config.Set("one_cell_writer_multiple", "0");
+        config.Set("xml_writer_multiple", "16");
+        config.Set("xml_keyframe_interval", "4");
+        config.Set("vtu_writer_multiple", "0");
+        config.Set("spectrum_multiple", "2");
+        config.Set("summary_interval", "0");
+        config.Set("checkpoint_interval", "128");
+        return config;
+    }
+
+    /** Restart SimulationTime at t=0 for the next run. */
+    void ResetSimulationTime()
+    {
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+    }
+
+public:
+
+    void TestResumeReproducesUninterruptedRun() throw (Exception)
+    {
+        OutputFileHandler output_file_handler("GTPaseCheckpointResume/", true);
+        std::string output_directory = output_file_handler.GetOutputDirectoryFullPath();
+
+        // Uninterrupted run, 1024 steps
+        GTPaseScenario::Run(MakeConfig("8", "GTPaseCheckpointResume/straight"));
+
+        // Interrupted after 640 steps: a spectrum block is half full and the keyframe schedule is mid-cycle
+        ResetSimulationTime();
+        ScenarioConfig interrupted_config = MakeConfig("5", "GTPaseCheckpointResume/interrupted");
+        interrupted_config.Set("keep_checkpoint", "true");
+        GTPaseScenario::Run(interrupted_config);
+
+        std::string checkpoint_path = CheckpointModifier<2>::GetCheckpointPath("GTPaseCheckpointResume/interrupted/checkpoints");
+        FileFinder checkpoint_file(checkpoint_path, RelativeTo::Absolute);
+        TS_ASSERT(checkpoint_file.Exists());
+
+        // Resumed from the checkpoint at t=5
+        ResetSimulationTime();
+        GTPaseScenario::Run(MakeConfig("8", "GTPaseCheckpointResume/interrupted"));
+        TS_ASSERT_EQUALS(SimulationTime::Instance()->GetTimeStepsElapsed(), 1024u);
+        TS_ASSERT(!checkpoint_file.Exists());
+
+        std::string straight_directory = output_directory + "straight/results_from_time_0/";
+        std::string interrupted_directory = output_directory + "interrupted/results_from_time_0/";
+        std::string resumed_directory = output_directory + "interrupted/results_from_time_5/";
+
+        const char* file_names[] = {"cell_data.xml", "data.csv", "population_statistics.csv", "topology_data.csv",
+                                    "topology_events.dat", "oscillation_spectrum.csv"};
+        for (unsigned i=0; i<6; i++)
+        {
+            CompareResumedRecords(file_names[i], straight_directory, interrupted_directory, resumed_directory, 5.0);
+        }
+    }
+
+    void TestResumeRejectsDifferentScenario() throw (Exception)
+    {
+        // Remove the checkpoint kept by any earlier run of this test
+        OutputFileHandler output_file_handler("GTPaseCheckpointResume/changed/", true);
+
+        ScenarioConfig config = MakeConfig("1", "GTPaseCheckpointResume/changed");
+        config.Set("keep_checkpoint", "true");
+        GTPaseScenario::Run(config);
+
+        // Same output directory, different seed: the old tissue must not be resumed
+        ResetSimulationTime();
+        ScenarioConfig changed_config = MakeConfig("2", "GTPaseCheckpointResume/changed");
+        changed_config.Set("seed", "2");
+        TS_ASSERT_THROWS_CONTAINS(GTPaseScenario::Run(changed_config),
+                                  "has \"seed = 1\" where this run has \"seed = 2\"");
+    }
+};
+
+#endif /*MULTICELLSCHECKPOINTRESUME_HPP_*/
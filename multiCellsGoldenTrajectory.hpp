@@ -0,0 +1,219 @@
+#ifndef MULTICELLSGOLDENTRAJECTORY_HPP_
+#define MULTICELLSGOLDENTRAJECTORY_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "PetscSetupAndFinalize.hpp"
+#include "Exception.hpp"
+#include "OutputFileHandler.hpp"
+#include "FileFinder.hpp"
+#include "SimulationTime.hpp"
+
+#include "ScenarioConfig.hpp"
+#include "GTPaseScenario.hpp"
+#include "TrajectoryComparison.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+/**
+ * Numerical regression test: runs a small coupled tissue and compares its
+ * per-cell trajectories and topology statistics with a stored reference
+ * run using TrajectoryComparison.
+ *
+ * The reference directory is $GTPASE_GOLDEN_REFERENCE if set (e.g. a copy
+ * kept under version control), otherwise GTPaseGoldenTrajectory/reference in
+ * the test output. Running with GTPASE_BLESS_GOLDEN set stores the current run
+ * as the reference, with a warning, and then compares against it. Without a
+ * stored reference the comparison is skipped with a warning, unless
+ * GTPASE_GOLDEN_REFERENCE was set: a configured reference that is missing is
+ * a failure.
+ *
+ * TestBlessAndCompare checks both paths without touching the reference: a run
+ * blessed into a scratch directory must pass against itself, and a run with
+ * a slightly different beta must fail against it.
+ */
+class multiCellsGoldenTrajectory : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** The files compared. */
+    static const unsigned NUM_FILES = 2;
+
+    /**
+     * Copy a file.
+     *
+     * @param rFrom the source
+     * @param rTo the destination
+     */
+    void CopyFile(const std::string& rFrom, const std::string& rTo)
+    {
+        std::ifstream source(rFrom.c_str(), std::ios::binary);
+        std::ofstream destination(rTo.c_str(), std::ios::binary);
+        if (!source.is_open() || !destination.is_open())
+        {
+            EXCEPTION("Could not copy " + rFrom + " to " + rTo);
+        }
+        destination << source.rdbuf();
+    }
+
+    /**
+     * @param index the file
+     * @return the name of a compared file
+     */
+    std::string GetFileName(unsigned index)
+    {
+        const char* file_names[NUM_FILES] = {"cell_data.xml", "topology_data.csv"};
+        return file_names[index];
+    }
+
+    /**
+     * Run the golden scenario.
+     *
+     * @param rOutputDirectory the output directory, relative to the test output
+     * @param rBeta the ODESRN bifurcation parameter
+     * @return the full path of the results directory of the run
+     */
+    std::string RunScenario(const std::string& rOutputDirectory, const std::string& rBeta)
+    {
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+
+        ScenarioConfig config;
+        config.Set("output_directory", rOutputDirectory);
+        config.Set("num_cells_across", "10");
+        config.Set("num_cells_up", "10");
+        config.Set("beta", rBeta);
+        config.Set("end_time", "50");
+        config.Set("sampling_multiple", "100");
+        config.Set("csv_writer_multiple", "0");
+        config.Set("statistics_writer_multiple", "0");
+        config.Set("topology_writer_multiple", "100");
+        config.Set("topology_event_writer_multiple", "0");
+        config.Set("one_cell_writer_multiple", "0");
+        config.Set("xml_writer_multiple", "100");
+        config.Set("vtu_writer_multiple", "0");
+        config.Set("spectrum_multiple", "0");
+        config.Set("summary_interval", "0");
+        config.Set("checkpoint_interval", "0");
+        GTPaseScenario::Run(config);
+
+        OutputFileHandler results_handler(rOutputDirectory + "/results_from_time_0/", false);
+        return results_handler.GetOutputDirectoryFullPath();
+    }
+
+    /**
+     * Store a run as the reference.
+     *
+     * @param rResultsDirectory the results directory of the run
+     * @param rReferenceDirectory the reference directory, which must exist
+     */
+    void Bless(const std::string& rResultsDirectory, const std::string& rReferenceDirectory)
+    {
+        for (unsigned i=0; i<NUM_FILES; i++)
+        {
+            CopyFile(rResultsDirectory + GetFileName(i), rReferenceDirectory + GetFileName(i));
+        }
+    }
+
+    /**
+     * Compare a run with a reference.
+     *
+     * @param rReferenceDirectory the reference directory
+     * @param rResultsDirectory the results directory of the run
+     * @param rComparison filled with the comparison
+     */
+    void Compare(const std::string& rReferenceDirectory, const std::string& rResultsDirectory,
+                 TrajectoryComparison& rComparison)
+    {
+        rComparison.CompareCellData(rReferenceDirectory + GetFileName(0), rResultsDirectory + GetFileName(0));
+        rComparison.CompareTopology(rReferenceDirectory + GetFileName(1), rResultsDirectory + GetFileName(1));
+    }
+
+public:
+
+    void TestBlessAndCompare() throw (Exception)
+    {
+        std::string results_directory = RunScenario("GTPaseGoldenTrajectory/bless_check/candidate", "0.2");
+
+        OutputFileHandler scratch_handler("GTPaseGoldenTrajectory/bless_check/reference/", true);
+        std::string scratch_directory = scratch_handler.GetOutputDirectoryFullPath();
+        Bless(results_directory, scratch_directory);
+
+        TrajectoryComparison same_run;
+        Compare(scratch_directory, results_directory, same_run);
+        TS_ASSERT(same_run.Passed());
+
+        // A small change in beta must be caught
+        std::string perturbed_directory = RunScenario("GTPaseGoldenTrajectory/bless_check/perturbed", "0.21");
+        TrajectoryComparison perturbed_run;
+        Compare(scratch_directory, perturbed_directory, perturbed_run);
+        TS_ASSERT(!perturbed_run.Passed());
+    }
+
+    void TestGoldenTrajectory() throw (Exception)
+    {
+        std::string results_directory = RunScenario("GTPaseGoldenTrajectory/candidate", "0.2");
+
+        std::string reference_directory;
+        const char* p_reference_env = std::getenv("GTPASE_GOLDEN_REFERENCE");
+        if (p_reference_env != NULL)
+        {
+            reference_directory = std::string(p_reference_env) + "/";
+            FileFinder reference_finder(reference_directory, RelativeTo::Absolute);
+            if (!reference_finder.IsDir())
+            {
+                EXCEPTION("GTPASE_GOLDEN_REFERENCE " + reference_directory + " is not a directory");
+            }
+        }
+        else
+        {
+            OutputFileHandler reference_handler("GTPaseGoldenTrajectory/reference/", false);
+            reference_directory = reference_handler.GetOutputDirectoryFullPath();
+        }
+
+        if (std::getenv("GTPASE_BLESS_GOLDEN") != NULL)
+        {
+            Bless(results_directory, reference_directory);
+            TS_WARN("Stored this run as the golden reference in " + reference_directory);
+        }
+
+        for (unsigned i=0; i<NUM_FILES; i++)
+        {
+            FileFinder reference_file(reference_directory + GetFileName(i), RelativeTo::Absolute);
+            if (!reference_file.Exists())
+            {
+                std::string message = "No golden reference " + reference_directory + GetFileName(i)
+                                      + "; run once with GTPASE_BLESS_GOLDEN=1 to store one";
+                if (p_reference_env != NULL)
+                {
+                    TS_FAIL(message);
+                }
+                else
+                {
+                    TS_WARN(message + ". Skipping the comparison.");
+                }
+                return;
+            }
+        }
+
+        TrajectoryComparison comparison;
+        Compare(reference_directory, results_directory, comparison);
+
+        OutputFileHandler candidate_handler("GTPaseGoldenTrajectory/candidate/", false);
+        out_stream p_report = candidate_handler.OpenOutputFile("golden_comparison.txt");
+        comparison.WriteReport(*p_report);
+        p_report->close();
+        comparison.WriteReport(std::cout);
+
+        TS_ASSERT(comparison.Passed());
+    }
+};
+
+#endif /*MULTICELLSGOLDENTRAJECTORY_HPP_*/
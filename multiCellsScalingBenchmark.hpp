@@ -0,0 +1,276 @@
+#ifndef MULTICELLSSCALINGBENCHMARK_HPP_
+#define MULTICELLSSCALINGBENCHMARK_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "SmartPointers.hpp"
+#include "Exception.hpp"
+
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "CounterBasedRandomGenerator.hpp"
+#include "OutputFileHandler.hpp"
+#include "GTPaseCellFactory.hpp"
+
+#include "VolumeTrackingModifier.hpp"
+#include "ODEParameterAreaModifier.hpp"
+
+#include "ODESRNCoupledArea.hpp"
+#include "GTPaseParameterTable.hpp"
+
+// Every tissue size is run in a fork()ed child, so this suite must not initialise MPI
+#include "FakePetscSetup.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <sstream>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Tissue-size scaling benchmark of the coupled vertex/GTPase simulation.
+ *
+ * Runs the setup of multiCellsNoDivisionCoupledArea (NagaiHondaForce,
+ * VolumeTrackingModifier, ODEParameterAreaModifier and ODESrnModel, without
+ * writers) on honeycombs of 10x10 up to 400x400 cells for a fixed number of
+ * time steps. Each size runs in its own child process so that its peak
+ * resident memory is measured on its own.
+ *
+ * The results are written to GTPaseScalingBenchmark/scaling_benchmark.json:
+ * for each size, the set-up time and the part of it spent making the cells
+ * (see GTPaseCellFactory), the time of Solve(), the wall time per step
+ * and per cell-step, and the peak resident memory in KB.
+ */
+class multiCellsScalingBenchmark : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** Result of one tissue size. */
+    struct BenchmarkResult
+    {
+        /** Number of cells across and up the honeycomb. */
+        unsigned mCellsAcross;
+        /** Number of cells. */
+        unsigned mNumCells;
+        /** Wall time taken to build the tissue and simulation, in seconds. */
+        double mSetupSeconds;
+        /** Wall time taken by GTPaseCellFactory to make the cells, in seconds. */
+        double mCellSetupSeconds;
+        /** Wall time taken by Solve(), in seconds. */
+        double mSolveSeconds;
+        /** Peak resident memory of the child, in KB. */
+        long mMaxRssKb;
+        /** Exit status of the child. */
+        int mExitStatus;
+    };
+
+    /** @return the wall-clock time in seconds. */
+    static double WallClockSeconds()
+    {
+        timeval now;
+        gettimeofday(&now, NULL);
+        return now.tv_sec + 1e-6*now.tv_usec;
+    }
+
+    /**
+     * Build and run one tissue. Called in the child process.
+     *
+     * @param cellsAcross the number of cells across and up the honeycomb
+     * @param numSteps the number of time steps to run
+     * @param dt the time step
+     * @param rSetupSeconds filled in with the set-up time
+     * @param rCellSetupSeconds filled in with the time taken to make the cells
+     * @param rSolveSeconds filled in with the time of Solve()
+     */
+    static void RunTissue(unsigned cellsAcross, unsigned numSteps, double dt,
+                          double& rSetupSeconds, double& rCellSetupSeconds, double& rSolveSeconds)
+    {
+        double start_time = WallClockSeconds();
+
+        GTPaseParameterTable::Instance()->Reset();
+
+        HoneycombVertexMeshGenerator generator(cellsAcross, cellsAcross);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        unsigned num_cells = p_mesh->GetNumElements();
+        std::vector<double> initial_g(num_cells);
+        CounterBasedRandomGenerator random_generator(1);
+        random_generator.FillRanf(0, num_cells, CounterBasedRandomGenerator::INITIAL_G, 0, &initial_g[0]);
+
+        std::vector<CellPtr> cells;
+        GTPaseCellFactory cell_factory;
+        cell_factory.GenerateCells(cells, initial_g, std::vector<double>(num_cells, 0.8), std::vector<double>(num_cells, 0.866025));
+        rCellSetupSeconds = cell_factory.GetSetupSeconds();
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetOutputResultsForChasteVisualizer(false);
+
+        std::stringstream output_directory;
+        output_directory << "GTPaseScalingBenchmark/" << cellsAcross << "x" << cellsAcross;
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory(output_directory.str());
+        simulator.SetSamplingTimestepMultiple(numSteps);
+        simulator.SetDt(dt);
+        simulator.SetEndTime(numSteps*dt);
+
+        MAKE_PTR(VolumeTrackingModifier<2>, p_volume_modifier);
+        simulator.AddSimulationModifier(p_volume_modifier);
+        MAKE_PTR(ODEParameterAreaModifier<2>, p_ODE_modifier);
+        simulator.AddSimulationModifier(p_ODE_modifier);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        p_force->SetNagaiHondaDeformationEnergyParameter(100.0);
+        p_force->SetNagaiHondaMembraneSurfaceEnergyParameter(0.0);
+        p_force->SetNagaiHondaCellBoundaryAdhesionEnergyParameter(1.0);
+        p_force->SetNagaiHondaCellCellAdhesionEnergyParameter(1.0);
+        simulator.AddForce(p_force);
+
+        double solve_start_time = WallClockSeconds();
+        rSetupSeconds = solve_start_time - start_time;
+        simulator.Solve();
+        rSolveSeconds = WallClockSeconds() - solve_start_time;
+    }
+
+    /**
+     * Run one tissue size in a child process.
+     *
+     * @param cellsAcross the number of cells across and up the honeycomb
+     * @param numSteps the number of time steps to run
+     * @param dt the time step
+     * @return the result
+     */
+    BenchmarkResult RunInChild(unsigned cellsAcross, unsigned numSteps, double dt)
+    {
+        BenchmarkResult result = {cellsAcross, cellsAcross*cellsAcross, 0.0, 0.0, 0.0, 0, -1};
+
+        // The child sends its timings back through a pipe
+        int pipe_fds[2];
+        if (pipe(pipe_fds) != 0)
+        {
+            EXCEPTION("pipe() failed");
+        }
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            EXCEPTION("fork() failed");
+        }
+        if (pid == 0)
+        {
+            // The child must never return into the test framework
+            close(pipe_fds[0]);
+            int exit_code = 0;
+            try
+            {
+                double timings[3];
+                RunTissue(cellsAcross, numSteps, dt, timings[0], timings[1], timings[2]);
+                if (write(pipe_fds[1], timings, sizeof(timings)) != (ssize_t)sizeof(timings))
+                {
+                    exit_code = 1;
+                }
+            }
+            catch (Exception& e)
+            {
+                std::cerr << e.GetMessage() << std::endl;
+                exit_code = 1;
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << e.what() << std::endl;
+                exit_code = 1;
+            }
+            catch (...)
+            {
+                std::cerr << "Unknown exception in child process" << std::endl;
+                exit_code = 1;
+            }
+            close(pipe_fds[1]);
+            _exit(exit_code);
+        }
+
+        close(pipe_fds[1]);
+        double timings[3] = {0.0, 0.0, 0.0};
+        ssize_t bytes_read = read(pipe_fds[0], timings, sizeof(timings));
+        close(pipe_fds[0]);
+
+        int status;
+        rusage usage;
+        if (wait4(pid, &status, 0, &usage) != pid)
+        {
+            EXCEPTION("wait4() failed");
+        }
+        result.mExitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        if (bytes_read == (ssize_t)sizeof(timings))
+        {
+            result.mSetupSeconds = timings[0];
+            result.mCellSetupSeconds = timings[1];
+            result.mSolveSeconds = timings[2];
+        }
+        else if (result.mExitStatus == 0)
+        {
+            result.mExitStatus = -1;
+        }
+        result.mMaxRssKb = usage.ru_maxrss;
+        return result;
+    }
+
+public:
+
+    void TestTissueSizeScaling() throw (Exception)
+    {
+        const unsigned sizes[] = {10, 50, 100, 200, 400};
+        const unsigned num_sizes = 5;
+        const unsigned num_steps = 100;
+        const double dt = 0.01;
+
+        std::vector<BenchmarkResult> results;
+        for (unsigned s=0; s<num_sizes; s++)
+        {
+            results.push_back(RunInChild(sizes[s], num_steps, dt));
+        }
+
+        OutputFileHandler output_file_handler("GTPaseScalingBenchmark/", false);
+        out_stream p_json_file = output_file_handler.OpenOutputFile("scaling_benchmark.json");
+        *p_json_file << "{\n"
+                     << "  \"benchmark\": \"tissue_size_scaling\",\n"
+                     << "  \"num_steps\": " << num_steps << ",\n"
+                     << "  \"dt\": " << dt << ",\n"
+                     << "  \"results\": [\n";
+        p_json_file->precision(9);
+        for (unsigned s=0; s<results.size(); s++)
+        {
+            const BenchmarkResult& r_result = results[s];
+            *p_json_file << "    {\"cells_across\": " << r_result.mCellsAcross
+                         << ", \"cells_up\": " << r_result.mCellsAcross
+                         << ", \"num_cells\": " << r_result.mNumCells
+                         << ", \"exit_status\": " << r_result.mExitStatus
+                         << ", \"setup_seconds\": " << r_result.mSetupSeconds
+                         << ", \"cell_setup_seconds\": " << r_result.mCellSetupSeconds
+                         << ", \"solve_seconds\": " << r_result.mSolveSeconds
+                         << ", \"seconds_per_step\": " << r_result.mSolveSeconds/num_steps
+                         << ", \"seconds_per_cell_step\": " << r_result.mSolveSeconds/(num_steps*(double)r_result.mNumCells)
+                         << ", \"peak_rss_kb\": " << r_result.mMaxRssKb
+                         << "}" << (s + 1 < results.size() ? "," : "") << "\n";
+        }
+        *p_json_file << "  ]\n}\n";
+        p_json_file->close();
+
+        for (unsigned s=0; s<results.size(); s++)
+        {
+            TS_ASSERT_EQUALS(results[s].mExitStatus, 0);
+        }
+    }
+};
+
+#endif /*MULTICELLSSCALINGBENCHMARK_HPP_*/
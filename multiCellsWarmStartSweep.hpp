@@ -0,0 +1,234 @@
+#ifndef MULTICELLSWARMSTARTSWEEP_HPP_
+#define MULTICELLSWARMSTARTSWEEP_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "SmartPointers.hpp"
+#include "Exception.hpp"
+
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "CounterBasedRandomGenerator.hpp"
+#include "SimulationTime.hpp"
+#include "NoCellCycleModel.hpp"
+
+#include "VolumeTrackingModifier.hpp"
+#include "ODEParameterAreaModifier.hpp"
+#include "CsvWriter.hpp"
+#include "OneCellGTPaseWriter.hpp"
+#include "XMLCellWriter.hpp"
+
+#include "ODESRNCoupledArea.hpp"
+#include "GTPaseParameterTable.hpp"
+
+// Children are created with fork(), so this suite must not initialise MPI
+#include "FakePetscSetup.hpp"
+
+#include <exception>
+#include <sstream>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+/**
+ * Parameter sweep from a single equilibrated tissue.
+ *
+ * The 50x50 tissue is built and run with the baseline parameters once, up to
+ * the relaxation time. Each variant is then run in a fork()ed child process,
+ * which starts from a copy-on-write image of the relaxed tissue, sets its own
+ * beta, cell-cell adhesion and deformation energy, and runs to the end time in
+ * its own output directory. At most mMaxConcurrentChildren children run at once.
+ */
+class multiCellsWarmStartSweep : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** One variant of the sweep. */
+    struct SweepVariant
+    {
+        /** The bifurcation parameter of ODESRN. */
+        double mBeta;
+        /** The Nagai-Honda cell-cell adhesion energy parameter. */
+        double mCellCellAdhesion;
+        /** The Nagai-Honda deformation energy parameter. */
+        double mDeformationEnergy;
+    };
+
+    /**
+     * Wait for one child to finish.
+     *
+     * @return whether the child exited successfully
+     */
+    bool WaitForChild()
+    {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        return pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+public:
+
+    void TestWarmStartSweep() throw (Exception)
+    {
+        const std::string output_directory = "50x50GTPase_warm_start_sweep";
+        const double relaxation_time = 250.0;
+        const double end_time = 2500.0;
+        const unsigned max_concurrent_children = 4;
+
+        std::vector<SweepVariant> variants;
+        const double betas[] = {0.15, 0.2, 0.25};
+        const double cell_cell_adhesions[] = {0.75, 1.0};
+        const double deformation_energies[] = {50.0, 100.0};
+        for (unsigned i=0; i<3; i++)
+        {
+            for (unsigned j=0; j<2; j++)
+            {
+                for (unsigned k=0; k<2; k++)
+                {
+                    SweepVariant variant = {betas[i], cell_cell_adhesions[j], deformation_energies[k]};
+                    variants.push_back(variant);
+                }
+            }
+        }
+
+        GTPaseParameterTable::Instance()->Reset();
+
+        /* Build the tissue as in multiCellsNoDivisionCoupledArea */
+        HoneycombVertexMeshGenerator generator(50, 50);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        std::vector<CellPtr> cells;
+
+        std::vector<double> initial_g(p_mesh->GetNumElements());
+        CounterBasedRandomGenerator random_generator(1);
+        random_generator.FillRanf(0, initial_g.size(), CounterBasedRandomGenerator::INITIAL_G, 0, &initial_g[0]);
+
+        for (unsigned i=0; i<p_mesh->GetNumElements(); i++)
+        {
+            NoCellCycleModel* p_cycle_model = new NoCellCycleModel();
+            ODESrnModel* p_srn_model = new ODESrnModel;
+
+            std::vector<double> initial_conditions;
+            initial_conditions.push_back(initial_g[i]);
+            initial_conditions.push_back(0.8);
+            initial_conditions.push_back(0.866025);
+            p_srn_model->SetInitialConditions(initial_conditions);
+
+            CellPtr p_cell(new Cell(p_state, p_cycle_model, p_srn_model));
+            p_cell->SetCellProliferativeType(p_differentiated_type);
+            p_cell->InitialiseCellCycleModel();
+            cells.push_back(p_cell);
+        }
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetOutputResultsForChasteVisualizer(false);
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory(output_directory + "/relaxation");
+        simulator.SetSamplingTimestepMultiple(200);
+        simulator.SetDt(0.01);
+        simulator.SetEndTime(relaxation_time);
+
+        MAKE_PTR(VolumeTrackingModifier<2>, p_volume_modifier);
+        simulator.AddSimulationModifier(p_volume_modifier);
+        MAKE_PTR(ODEParameterAreaModifier<2>, p_ODE_modifier);
+        simulator.AddSimulationModifier(p_ODE_modifier);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        p_force->SetNagaiHondaDeformationEnergyParameter(100.0);
+        p_force->SetNagaiHondaMembraneSurfaceEnergyParameter(0.0);
+        p_force->SetNagaiHondaCellBoundaryAdhesionEnergyParameter(1.0);
+        p_force->SetNagaiHondaCellCellAdhesionEnergyParameter(1.0);
+        simulator.AddForce(p_force);
+
+        /* Relax once */
+        simulator.Solve();
+
+        /* Run each variant in a child process started from the relaxed tissue */
+        unsigned num_running = 0;
+        unsigned num_failed = 0;
+        for (unsigned v=0; v<variants.size(); v++)
+        {
+            if (num_running == max_concurrent_children)
+            {
+                num_failed += WaitForChild() ? 0 : 1;
+                num_running--;
+            }
+
+            pid_t pid = fork();
+            if (pid < 0)
+            {
+                EXCEPTION("fork() failed");
+            }
+            if (pid == 0)
+            {
+                // The child must never return into the test framework
+                int exit_code = 0;
+                try
+                {
+                    const SweepVariant& r_variant = variants[v];
+                    std::stringstream variant_directory;
+                    variant_directory << output_directory << "/beta_" << r_variant.mBeta
+                                      << "_adhesion_" << r_variant.mCellCellAdhesion
+                                      << "_deformation_" << r_variant.mDeformationEnergy;
+
+                    GTPaseParameterTable::Instance()->SetGlobalValue(GTPaseParameterTable::BETA, r_variant.mBeta);
+                    p_force->SetNagaiHondaCellCellAdhesionEnergyParameter(r_variant.mCellCellAdhesion);
+                    p_force->SetNagaiHondaDeformationEnergyParameter(r_variant.mDeformationEnergy);
+
+                    boost::shared_ptr<CsvWriter<2,2> > p_csv_writer(new CsvWriter<2,2>());
+                    p_csv_writer->SetSamplingTimestepMultiple(200);
+                    cell_population.AddPopulationWriter(p_csv_writer);
+                    boost::shared_ptr<OneCellGTPaseWriter<2,2> > p_one_cell_writer(new OneCellGTPaseWriter<2,2>());
+                    p_one_cell_writer->SetSamplingTimestepMultiple(200);
+                    cell_population.AddPopulationWriter(p_one_cell_writer);
+                    boost::shared_ptr<XMLCellWriter<2,2> > p_xml_writer(new XMLCellWriter<2,2>());
+                    p_xml_writer->SetSamplingTimestepMultiple(200);
+                    cell_population.AddCellWriter(p_xml_writer);
+
+                    simulator.SetOutputDirectory(variant_directory.str());
+                    simulator.SetEndTime(end_time);
+                    simulator.Solve();
+                }
+                catch (Exception& e)
+                {
+                    std::cerr << e.GetMessage() << std::endl;
+                    exit_code = 1;
+                }
+                catch (std::exception& e)
+                {
+                    std::cerr << e.what() << std::endl;
+                    exit_code = 1;
+                }
+                catch (...)
+                {
+                    std::cerr << "Unknown exception in child process" << std::endl;
+                    exit_code = 1;
+                }
+                _exit(exit_code);
+            }
+            num_running++;
+        }
+
+        while (num_running > 0)
+        {
+            num_failed += WaitForChild() ? 0 : 1;
+            num_running--;
+        }
+
+        TS_ASSERT_EQUALS(num_failed, 0u);
+    }
+};
+
+#endif /*MULTICELLSWARMSTARTSWEEP_HPP_*/
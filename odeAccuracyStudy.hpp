@@ -0,0 +1,758 @@
+#ifndef ODEACCURACYSTUDY_HPP_
+#define ODEACCURACYSTUDY_HPP_
+
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include <cxxtest/TestSuite.h>
+#include "AbstractCellBasedTestSuite.hpp"
+#include "PetscSetupAndFinalize.hpp"
+#include "SmartPointers.hpp"
+#include "Exception.hpp"
+
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "NoCellCycleModel.hpp"
+#include "AbstractCellBasedSimulationModifier.hpp"
+#include "CellPropertyRegistry.hpp"
+#include "CellId.hpp"
+#include "CounterBasedRandomGenerator.hpp"
+#include "SimulationTime.hpp"
+#include "OutputFileHandler.hpp"
+
+#include "AbstractIvpOdeSolver.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "RungeKutta2IvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "BackwardEulerIvpOdeSolver.hpp"
+#include "RungeKuttaFehlbergIvpOdeSolver.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+
+#include "VolumeTrackingModifier.hpp"
+#include "ODEParameterAreaModifier.hpp"
+
+#include "ODESRN.hpp"
+#include "ODESrnModel.hpp"
+#include "GTPaseParameterTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+/**
+ * ODESRN closed by a one-cell stand-in for the vertex mechanics: the area
+ * relaxes towards the target area at a fixed rate, so that a single cell
+ * oscillates on its own (with a period of about 320 at rate 0.05).
+ */
+class RelaxingAreaODESRN : public ODESRN
+{
+private:
+
+    /** The rate at which the area relaxes towards the target area. */
+    double mRelaxationRate;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param relaxationRate the rate at which the area relaxes towards the target area
+     */
+    RelaxingAreaODESRN(double relaxationRate)
+        : ODESRN(),
+          mRelaxationRate(relaxationRate)
+    {
+    }
+
+    void EvaluateYDerivatives(double time, const std::vector<double>& rY,
+                              std::vector<double>& rDY)
+    {
+        ODESRN::EvaluateYDerivatives(time, rY, rDY);
+        rDY[2] = mRelaxationRate*(rY[1] - rY[2]);
+    }
+};
+
+/**
+ * Records G of every cell every given number of time steps, keyed by cell ID.
+ */
+class GTraceRecorder : public AbstractCellBasedSimulationModifier<2,2>
+{
+private:
+
+    /** Number of time steps between samples. */
+    unsigned mSamplingMultiple;
+
+    /** The recorded traces. */
+    std::map<unsigned, std::vector<double> >* mpTraces;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param samplingMultiple the number of time steps between samples
+     * @param pTraces the traces to append to
+     */
+    GTraceRecorder(unsigned samplingMultiple, std::map<unsigned, std::vector<double> >* pTraces)
+        : AbstractCellBasedSimulationModifier<2,2>(),
+          mSamplingMultiple(samplingMultiple),
+          mpTraces(pTraces)
+    {
+    }
+
+    void UpdateAtEndOfTimeStep(AbstractCellPopulation<2,2>& rCellPopulation)
+    {
+        if (SimulationTime::Instance()->GetTimeStepsElapsed() % mSamplingMultiple == 0)
+        {
+            for (AbstractCellPopulation<2,2>::Iterator cell_iter = rCellPopulation.Begin();
+                 cell_iter != rCellPopulation.End();
+                 ++cell_iter)
+            {
+                (*mpTraces)[cell_iter->GetCellId()].push_back(cell_iter->GetCellData()->GetItem("G"));
+            }
+        }
+    }
+
+    void SetupSolve(AbstractCellPopulation<2,2>& rCellPopulation, std::string outputDirectory)
+    {
+    }
+
+    void OutputSimulationModifierParameters(out_stream& rParamsFile)
+    {
+        *rParamsFile << "\t\t\t<SamplingMultiple>" << mSamplingMultiple << "</SamplingMultiple>\n";
+        AbstractCellBasedSimulationModifier<2,2>::OutputSimulationModifierParameters(rParamsFile);
+    }
+};
+
+/**
+ * Accuracy-versus-cost study of the integration of ODESRN.
+ *
+ * Each configuration (ODE solver and time step) is run to the same end time,
+ * with G sampled at a fixed interval, and compared with a reference run of
+ * RK4 at a much smaller time step. After a transient, each G trace is
+ * measured for its amplitude (half its range), its period (mean time between
+ * maxima) and the time of its last maximum, and compared with the reference:
+ *   - g_rms_error: RMS difference of G at the sample times,
+ *   - amplitude_error: relative error of the amplitude,
+ *   - period_error: relative error of the period,
+ *   - phase_error: shift of the last maximum, in cycles of the reference.
+ * The overall error of a configuration is the largest of the last three; the
+ * cost is its CPU time. A configuration is on the Pareto front if no cheaper
+ * one is at least as accurate. The front is printed, together with the
+ * cheapest configuration whose error is below $GTPASE_ACCURACY_TARGET
+ * (default 0.01).
+ *
+ * TestSingleCellAccuracy integrates one cell whose area relaxes towards its
+ * target area (RelaxingAreaODESRN) with each of the Chaste IVP solvers
+ * directly; a cell with a fixed or imposed area does not oscillate.
+ * TestCoupledTissueAccuracy runs the coupled vertex/GTPase simulation of a
+ * small tissue, where the time step is shared by the mechanics and the SRN
+ * solves; its errors are averaged over cells. The results are written to GTPaseOdeAccuracy/single_cell.json and
+ * GTPaseOdeAccuracy/tissue.json.
+ */
+class odeAccuracyStudy : public AbstractCellBasedTestSuite
+{
+private:
+
+    /** The amplitude, period and phase of one G trace. */
+    struct OscillationMeasures
+    {
+        /** Half the range of G. */
+        double mAmplitude;
+        /** Mean time between maxima, or 0 if there were fewer than two. */
+        double mPeriod;
+        /** Time of the last maximum. */
+        double mLastMaximumTime;
+    };
+
+    /** The errors and cost of one configuration. */
+    struct AccuracyResult
+    {
+        /** Name of the ODE solver. */
+        std::string mSolver;
+        /** Time step. */
+        double mDt;
+        /** Whether the run completed with finite values. */
+        bool mSucceeded;
+        /** CPU time of the run, in seconds. */
+        double mCpuSeconds;
+        /** RMS error of G. */
+        double mGRmsError;
+        /** Relative error of the amplitude. */
+        double mAmplitudeError;
+        /** Relative error of the period (1 if only the reference oscillates), or -1 if the reference has no period. */
+        double mPeriodError;
+        /** Phase error in cycles (0.5 if only the reference oscillates), or -1 if the reference has no period. */
+        double mPhaseError;
+        /** The largest of the amplitude, period and phase errors. */
+        double mError;
+        /** Whether the configuration is on the Pareto front. */
+        bool mOnParetoFront;
+    };
+
+    /** @return whether x is neither infinite nor NaN. */
+    static bool IsFinite(double x)
+    {
+        return x - x == 0.0;
+    }
+
+    /** @return the CPU time of the process in seconds. */
+    static double CpuSeconds()
+    {
+        return (double)std::clock()/CLOCKS_PER_SEC;
+    }
+
+    /**
+     * Measure a G trace after its transient. Maxima are located to within a
+     * sample by parabolic interpolation and must be separated by a crossing
+     * below the mid-range, so that small wiggles are not counted.
+     *
+     * @param rG the trace, sample k at time (k+1)*sampleInterval
+     * @param firstSample the first sample after the transient
+     * @param sampleInterval the time between samples
+     * @return the measures
+     */
+    static OscillationMeasures Measure(const std::vector<double>& rG, unsigned firstSample, double sampleInterval)
+    {
+        OscillationMeasures measures = {0.0, 0.0, 0.0};
+        if (rG.size() < firstSample + 3)
+        {
+            return measures;
+        }
+
+        double min_g = *std::min_element(rG.begin() + firstSample, rG.end());
+        double max_g = *std::max_element(rG.begin() + firstSample, rG.end());
+        double mid_g = 0.5*(min_g + max_g);
+        measures.mAmplitude = 0.5*(max_g - min_g);
+
+        double first_maximum_time = 0.0;
+        unsigned num_maxima = 0;
+        bool armed = false;
+        for (unsigned k=firstSample + 1; k+1<rG.size(); k++)
+        {
+            if (rG[k] < mid_g)
+            {
+                armed = true;
+            }
+            else if (armed && rG[k] > rG[k-1] && rG[k] >= rG[k+1])
+            {
+                double curvature = rG[k-1] - 2.0*rG[k] + rG[k+1];
+                double offset = curvature < 0.0 ? 0.5*(rG[k-1] - rG[k+1])/curvature : 0.0;
+                double time = (k + 1 + offset)*sampleInterval;
+                if (num_maxima == 0)
+                {
+                    first_maximum_time = time;
+                }
+                measures.mLastMaximumTime = time;
+                num_maxima++;
+                armed = false;
+            }
+        }
+        if (num_maxima >= 2)
+        {
+            measures.mPeriod = (measures.mLastMaximumTime - first_maximum_time)/(num_maxima - 1);
+        }
+        return measures;
+    }
+
+    /**
+     * Compare a G trace with the reference trace.
+     *
+     * @param rReference the reference trace
+     * @param rCandidate the trace, sampled at the same times
+     * @param firstSample the first sample after the transient
+     * @param sampleInterval the time between samples
+     * @param rResult the result whose errors are set
+     */
+    static void CompareTraces(const std::vector<double>& rReference, const std::vector<double>& rCandidate,
+                              unsigned firstSample, double sampleInterval, AccuracyResult& rResult)
+    {
+        if (rCandidate.size() != rReference.size())
+        {
+            EXCEPTION("Traces have different numbers of samples");
+        }
+
+        double sum_squares = 0.0;
+        for (unsigned k=firstSample; k<rReference.size(); k++)
+        {
+            sum_squares += (rCandidate[k] - rReference[k])*(rCandidate[k] - rReference[k]);
+        }
+        rResult.mGRmsError = std::sqrt(sum_squares/std::max(1u, (unsigned)rReference.size() - firstSample));
+
+        OscillationMeasures reference = Measure(rReference, firstSample, sampleInterval);
+        OscillationMeasures candidate = Measure(rCandidate, firstSample, sampleInterval);
+        rResult.mAmplitudeError = reference.mAmplitude > 0.0
+            ? std::fabs(candidate.mAmplitude - reference.mAmplitude)/reference.mAmplitude
+            : candidate.mAmplitude;
+        rResult.mPeriodError = -1.0;
+        rResult.mPhaseError = -1.0;
+        if (reference.mPeriod > 0.0 && candidate.mPeriod == 0.0)
+        {
+            rResult.mPeriodError = 1.0;
+            rResult.mPhaseError = 0.5;
+        }
+        else if (reference.mPeriod > 0.0)
+        {
+            rResult.mPeriodError = std::fabs(candidate.mPeriod - reference.mPeriod)/reference.mPeriod;
+
+            // Shift of the last maximum, wrapped to within half a cycle
+            double shift = (candidate.mLastMaximumTime - reference.mLastMaximumTime)/reference.mPeriod;
+            rResult.mPhaseError = std::fabs(shift - std::floor(shift + 0.5));
+        }
+    }
+
+    /**
+     * Set the overall errors and mark the Pareto front.
+     *
+     * @param rResults the results
+     */
+    static void FindParetoFront(std::vector<AccuracyResult>& rResults)
+    {
+        std::vector<std::pair<double, unsigned> > by_cost;
+        for (unsigned i=0; i<rResults.size(); i++)
+        {
+            AccuracyResult& r_result = rResults[i];
+            r_result.mError = std::max(r_result.mAmplitudeError, std::max(r_result.mPeriodError, r_result.mPhaseError));
+            r_result.mOnParetoFront = false;
+            if (r_result.mSucceeded && IsFinite(r_result.mError))
+            {
+                by_cost.push_back(std::make_pair(r_result.mCpuSeconds, i));
+            }
+        }
+        std::sort(by_cost.begin(), by_cost.end());
+
+        double best_error = HUGE_VAL;
+        for (unsigned i=0; i<by_cost.size(); i++)
+        {
+            AccuracyResult& r_result = rResults[by_cost[i].second];
+            if (r_result.mError < best_error)
+            {
+                r_result.mOnParetoFront = true;
+                best_error = r_result.mError;
+            }
+        }
+    }
+
+    /**
+     * Print the results, the Pareto front and the cheapest configuration that
+     * meets the accuracy target, and write them as JSON.
+     *
+     * @param rStudy the name of the study
+     * @param rReference a description of the reference
+     * @param rResults the results
+     * @param referenceCpuSeconds the CPU time of the reference
+     * @param rFileName the name of the JSON file in GTPaseOdeAccuracy/
+     */
+    static void ReportResults(const std::string& rStudy, const std::string& rReference,
+                              const std::vector<AccuracyResult>& rResults, double referenceCpuSeconds,
+                              const std::string& rFileName)
+    {
+        double accuracy_target = 0.01;
+        const char* p_target_env = std::getenv("GTPASE_ACCURACY_TARGET");
+        if (p_target_env != NULL)
+        {
+            accuracy_target = std::atof(p_target_env);
+        }
+
+        std::vector<std::pair<double, unsigned> > by_cost;
+        for (unsigned i=0; i<rResults.size(); i++)
+        {
+            by_cost.push_back(std::make_pair(rResults[i].mSucceeded ? rResults[i].mCpuSeconds : HUGE_VAL, i));
+        }
+        std::sort(by_cost.begin(), by_cost.end());
+
+        std::ios::fmtflags flags = std::cout.flags();
+        std::cout << "\n" << rStudy << ": errors against " << rReference
+                  << " (" << std::setprecision(3) << referenceCpuSeconds << " s CPU)\n\n"
+                  << std::left << std::setw(16) << "solver" << std::right
+                  << std::setw(10) << "dt" << std::setw(12) << "cpu_s"
+                  << std::setw(12) << "g_rms" << std::setw(12) << "amplitude"
+                  << std::setw(12) << "period" << std::setw(12) << "phase"
+                  << std::setw(12) << "error" << "  pareto\n";
+        for (unsigned i=0; i<by_cost.size(); i++)
+        {
+            const AccuracyResult& r_result = rResults[by_cost[i].second];
+            std::cout << std::left << std::setw(16) << r_result.mSolver << std::right
+                      << std::setw(10) << std::setprecision(4) << r_result.mDt;
+            if (!r_result.mSucceeded)
+            {
+                std::cout << std::setw(12) << std::setprecision(3) << r_result.mCpuSeconds << "  failed\n";
+                continue;
+            }
+            std::cout << std::setw(12) << std::setprecision(3) << r_result.mCpuSeconds
+                      << std::setw(12) << r_result.mGRmsError
+                      << std::setw(12) << r_result.mAmplitudeError
+                      << std::setw(12) << r_result.mPeriodError
+                      << std::setw(12) << r_result.mPhaseError
+                      << std::setw(12) << r_result.mError
+                      << (r_result.mOnParetoFront ? "  *" : "") << "\n";
+        }
+
+        std::cout << "\nPareto front, cheapest first:\n";
+        const AccuracyResult* p_cheapest_accurate = NULL;
+        for (unsigned i=0; i<by_cost.size(); i++)
+        {
+            const AccuracyResult& r_result = rResults[by_cost[i].second];
+            if (r_result.mOnParetoFront)
+            {
+                std::cout << "  " << r_result.mSolver << " dt=" << std::setprecision(4) << r_result.mDt
+                          << ": " << std::setprecision(3) << r_result.mCpuSeconds << " s, error " << r_result.mError << "\n";
+                if (p_cheapest_accurate == NULL && r_result.mError <= accuracy_target)
+                {
+                    p_cheapest_accurate = &r_result;
+                }
+            }
+        }
+        std::cout << "Cheapest configuration with error <= " << accuracy_target << ": ";
+        if (p_cheapest_accurate != NULL)
+        {
+            std::cout << p_cheapest_accurate->mSolver << " dt=" << std::setprecision(4) << p_cheapest_accurate->mDt << "\n";
+        }
+        else
+        {
+            std::cout << "none\n";
+        }
+        std::cout.flags(flags);
+
+        OutputFileHandler output_file_handler("GTPaseOdeAccuracy/", false);
+        out_stream p_json_file = output_file_handler.OpenOutputFile(rFileName);
+        p_json_file->precision(6);
+        *p_json_file << "{\n"
+                     << "  \"study\": \"" << rStudy << "\",\n"
+                     << "  \"reference\": \"" << rReference << "\",\n"
+                     << "  \"reference_cpu_seconds\": " << referenceCpuSeconds << ",\n"
+                     << "  \"accuracy_target\": " << accuracy_target << ",\n"
+                     << "  \"results\": [\n";
+        for (unsigned i=0; i<rResults.size(); i++)
+        {
+            const AccuracyResult& r_result = rResults[i];
+            *p_json_file << "    {\"solver\": \"" << r_result.mSolver << "\""
+                         << ", \"dt\": " << r_result.mDt
+                         << ", \"succeeded\": " << (r_result.mSucceeded ? "true" : "false")
+                         << ", \"cpu_seconds\": " << r_result.mCpuSeconds;
+            if (r_result.mSucceeded)
+            {
+                *p_json_file << ", \"g_rms_error\": " << r_result.mGRmsError
+                             << ", \"amplitude_error\": " << r_result.mAmplitudeError
+                             << ", \"period_error\": " << r_result.mPeriodError
+                             << ", \"phase_error\": " << r_result.mPhaseError
+                             << ", \"error\": " << r_result.mError
+                             << ", \"pareto\": " << (r_result.mOnParetoFront ? "true" : "false");
+            }
+            *p_json_file << "}" << (i + 1 < rResults.size() ? "," : "") << "\n";
+        }
+        *p_json_file << "  ]\n}\n";
+        p_json_file->close();
+    }
+
+    /**
+     * Integrate a single cell with a relaxing area.
+     *
+     * @param rSolver the ODE solver
+     * @param dt the time step (the maximum time step for adaptive solvers)
+     * @param numSamples the number of samples
+     * @param sampleInterval the time between samples
+     * @param rG filled in with G, sample k at time (k+1)*sampleInterval
+     * @return whether G stayed finite
+     */
+    static bool SolveSingleCell(AbstractIvpOdeSolver& rSolver, double dt, unsigned numSamples,
+                                double sampleInterval, std::vector<double>& rG)
+    {
+        RelaxingAreaODESRN ode_system(0.05);
+        std::vector<double> state = ode_system.GetInitialConditions();
+        state[2] = 0.866025;
+        rG.clear();
+        for (unsigned k=0; k<numSamples; k++)
+        {
+            rSolver.Solve(&ode_system, state, k*sampleInterval, (k + 1)*sampleInterval, dt);
+            if (!IsFinite(state[0]))
+            {
+                return false;
+            }
+            rG.push_back(state[0]);
+        }
+        return true;
+    }
+
+    /** The SRN solvers of the tissue study. */
+    enum TissueSolver
+    {
+        EULER = 0,
+        RUNGE_KUTTA_2,
+        RUNGE_KUTTA_4,
+        BACKWARD_EULER,
+        NUM_TISSUE_SOLVERS
+    };
+
+    /**
+     * @param solver the solver
+     * @return the shared, initialised cell-cycle model ODE solver
+     */
+    static boost::shared_ptr<AbstractCellCycleModelOdeSolver> GetTissueSolver(TissueSolver solver)
+    {
+        boost::shared_ptr<AbstractCellCycleModelOdeSolver> p_solver;
+        switch (solver)
+        {
+            case EULER:
+                p_solver = CellCycleModelOdeSolver<ODESrnModel, EulerIvpOdeSolver>::Instance();
+                break;
+            case RUNGE_KUTTA_2:
+                p_solver = CellCycleModelOdeSolver<ODESrnModel, RungeKutta2IvpOdeSolver>::Instance();
+                break;
+            case RUNGE_KUTTA_4:
+                p_solver = CellCycleModelOdeSolver<ODESrnModel, RungeKutta4IvpOdeSolver>::Instance();
+                break;
+            case BACKWARD_EULER:
+                p_solver = CellCycleModelOdeSolver<ODESrnModel, BackwardEulerIvpOdeSolver>::Instance();
+                p_solver->SetSizeOfOdeSystem(3);
+                break;
+            default:
+                NEVER_REACHED;
+        }
+        p_solver->Initialise();
+        return p_solver;
+    }
+
+    /**
+     * Run the coupled simulation of a small tissue from a fresh start, as
+     * multiCellsNoDivisionCoupledArea without writers.
+     *
+     * @param solver the SRN solver
+     * @param dt the time step of the simulation and of the SRN solves
+     * @param cellsAcross the number of cells across and up the honeycomb
+     * @param endTime the end time
+     * @param sampleInterval the time between samples of G
+     * @param rTraces filled in with G of each cell, sample k at time (k+1)*sampleInterval
+     */
+    static void RunTissue(TissueSolver solver, double dt, unsigned cellsAcross, double endTime,
+                          double sampleInterval, std::map<unsigned, std::vector<double> >& rTraces)
+    {
+        // The set-up AbstractCellBasedTestSuite does for each test
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+        CellPropertyRegistry::Instance()->Clear();
+        CellId::ResetMaxCellId();
+        GTPaseParameterTable::Instance()->Reset();
+
+        boost::shared_ptr<AbstractCellCycleModelOdeSolver> p_ode_solver = GetTissueSolver(solver);
+
+        HoneycombVertexMeshGenerator generator(cellsAcross, cellsAcross);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        std::vector<CellPtr> cells;
+
+        std::vector<double> initial_g(p_mesh->GetNumElements());
+        CounterBasedRandomGenerator random_generator(1);
+        random_generator.FillRanf(0, initial_g.size(), CounterBasedRandomGenerator::INITIAL_G, 0, &initial_g[0]);
+
+        for (unsigned i=0; i<p_mesh->GetNumElements(); i++)
+        {
+            NoCellCycleModel* p_cycle_model = new NoCellCycleModel();
+            ODESrnModel* p_srn_model = new ODESrnModel(p_ode_solver);
+            p_srn_model->SetDt(dt);
+
+            std::vector<double> initial_conditions;
+            initial_conditions.push_back(initial_g[i]);
+            initial_conditions.push_back(0.8);
+            initial_conditions.push_back(0.866025);
+            p_srn_model->SetInitialConditions(initial_conditions);
+
+            CellPtr p_cell(new Cell(p_state, p_cycle_model, p_srn_model));
+            p_cell->SetCellProliferativeType(p_differentiated_type);
+            p_cell->InitialiseCellCycleModel();
+            cells.push_back(p_cell);
+        }
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.SetOutputResultsForChasteVisualizer(false);
+
+        unsigned sampling_multiple = (unsigned)(sampleInterval/dt + 0.5);
+        unsigned num_steps = (unsigned)(endTime/dt + 0.5);
+
+        std::stringstream output_directory;
+        output_directory << "GTPaseOdeAccuracy/tissue/solver_" << solver << "_dt_" << dt;
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory(output_directory.str());
+        simulator.SetSamplingTimestepMultiple(num_steps);
+        simulator.SetDt(dt);
+        simulator.SetEndTime(endTime);
+
+        MAKE_PTR(VolumeTrackingModifier<2>, p_volume_modifier);
+        simulator.AddSimulationModifier(p_volume_modifier);
+        MAKE_PTR(ODEParameterAreaModifier<2>, p_ODE_modifier);
+        simulator.AddSimulationModifier(p_ODE_modifier);
+        rTraces.clear();
+        MAKE_PTR_ARGS(GTraceRecorder, p_recorder, (sampling_multiple, &rTraces));
+        simulator.AddSimulationModifier(p_recorder);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        p_force->SetNagaiHondaDeformationEnergyParameter(100.0);
+        p_force->SetNagaiHondaMembraneSurfaceEnergyParameter(0.0);
+        p_force->SetNagaiHondaCellBoundaryAdhesionEnergyParameter(1.0);
+        p_force->SetNagaiHondaCellCellAdhesionEnergyParameter(1.0);
+        simulator.AddForce(p_force);
+
+        simulator.Solve();
+    }
+
+public:
+
+    void TestSingleCellAccuracy() throw (Exception)
+    {
+        const double end_time = 2000.0;
+        const double transient_time = 700.0;
+        const double sample_interval = 1.0;
+        const double reference_dt = 1e-3;
+        const unsigned num_samples = (unsigned)(end_time/sample_interval + 0.5);
+        const unsigned first_sample = (unsigned)(transient_time/sample_interval + 0.5);
+
+        GTPaseParameterTable::Instance()->Reset();
+
+        RungeKutta4IvpOdeSolver reference_solver;
+        std::vector<double> reference_g;
+        double start_time = CpuSeconds();
+        TS_ASSERT(SolveSingleCell(reference_solver, reference_dt, num_samples, sample_interval, reference_g));
+        double reference_cpu_seconds = CpuSeconds() - start_time;
+        TS_ASSERT_LESS_THAN(0.0, Measure(reference_g, first_sample, sample_interval).mPeriod);
+
+        std::vector<std::pair<std::string, boost::shared_ptr<AbstractIvpOdeSolver> > > solvers;
+        solvers.push_back(std::make_pair("euler", boost::shared_ptr<AbstractIvpOdeSolver>(new EulerIvpOdeSolver)));
+        solvers.push_back(std::make_pair("rk2", boost::shared_ptr<AbstractIvpOdeSolver>(new RungeKutta2IvpOdeSolver)));
+        solvers.push_back(std::make_pair("rk4", boost::shared_ptr<AbstractIvpOdeSolver>(new RungeKutta4IvpOdeSolver)));
+        solvers.push_back(std::make_pair("backward_euler", boost::shared_ptr<AbstractIvpOdeSolver>(new BackwardEulerIvpOdeSolver(3))));
+        solvers.push_back(std::make_pair("rkf45", boost::shared_ptr<AbstractIvpOdeSolver>(new RungeKuttaFehlbergIvpOdeSolver)));
+        const double dts[] = {1.0, 0.5, 0.2, 0.1, 0.05, 0.02, 0.01, 0.005};
+        const unsigned num_dts = 8;
+
+        std::vector<AccuracyResult> results;
+        for (unsigned s=0; s<solvers.size(); s++)
+        {
+            for (unsigned d=0; d<num_dts; d++)
+            {
+                AccuracyResult result = {solvers[s].first, dts[d], false, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, false};
+                std::vector<double> g;
+                start_time = CpuSeconds();
+                try
+                {
+                    result.mSucceeded = SolveSingleCell(*(solvers[s].second), dts[d], num_samples, sample_interval, g);
+                }
+                catch (Exception& e)
+                {
+                    std::cout << solvers[s].first << " dt=" << dts[d] << " failed: " << e.GetMessage() << "\n";
+                }
+                result.mCpuSeconds = CpuSeconds() - start_time;
+                if (result.mSucceeded)
+                {
+                    CompareTraces(reference_g, g, first_sample, sample_interval, result);
+                }
+                results.push_back(result);
+            }
+        }
+
+        FindParetoFront(results);
+        ReportResults("single cell, relaxing area", "rk4 dt=1e-3", results, reference_cpu_seconds, "single_cell.json");
+
+        // The configuration in use must at least run
+        bool habitual_configuration_succeeded = false;
+        for (unsigned i=0; i<results.size(); i++)
+        {
+            if (results[i].mSolver == "rk4" && std::fabs(results[i].mDt - 0.01) < 1e-12)
+            {
+                habitual_configuration_succeeded = results[i].mSucceeded;
+            }
+        }
+        TS_ASSERT(habitual_configuration_succeeded);
+    }
+
+    void TestCoupledTissueAccuracy() throw (Exception)
+    {
+        const unsigned cells_across = 6;
+        const double end_time = 1000.0;
+        const double transient_time = 200.0;
+        const double sample_interval = 1.0;
+        const double reference_dt = 1e-3;
+        const unsigned first_sample = (unsigned)(transient_time/sample_interval + 0.5);
+        const char* solver_names[NUM_TISSUE_SOLVERS] = {"euler", "rk2", "rk4", "backward_euler"};
+
+        std::map<unsigned, std::vector<double> > reference_traces;
+        double start_time = CpuSeconds();
+        RunTissue(RUNGE_KUTTA_4, reference_dt, cells_across, end_time, sample_interval, reference_traces);
+        double reference_cpu_seconds = CpuSeconds() - start_time;
+        TS_ASSERT_EQUALS(reference_traces.size(), cells_across*cells_across);
+
+        const double dts[] = {0.02, 0.01, 0.005, 0.0025};
+        const unsigned num_dts = 4;
+
+        std::vector<AccuracyResult> results;
+        for (unsigned s=0; s<NUM_TISSUE_SOLVERS; s++)
+        {
+            for (unsigned d=0; d<num_dts; d++)
+            {
+                AccuracyResult result = {solver_names[s], dts[d], false, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, false};
+                std::map<unsigned, std::vector<double> > traces;
+                start_time = CpuSeconds();
+                try
+                {
+                    RunTissue((TissueSolver)s, dts[d], cells_across, end_time, sample_interval, traces);
+                    result.mSucceeded = (traces.size() == reference_traces.size());
+                }
+                catch (Exception& e)
+                {
+                    std::cout << solver_names[s] << " dt=" << dts[d] << " failed: " << e.GetMessage() << "\n";
+                }
+                result.mCpuSeconds = CpuSeconds() - start_time;
+
+                // Average the errors over cells; period and phase over the cells whose reference oscillates
+                unsigned num_periodic_cells = 0;
+                for (std::map<unsigned, std::vector<double> >::iterator iter = traces.begin();
+                     result.mSucceeded && iter != traces.end();
+                     ++iter)
+                {
+                    AccuracyResult cell_result = result;
+                    CompareTraces(reference_traces[iter->first], iter->second, first_sample, sample_interval, cell_result);
+                    result.mSucceeded = IsFinite(cell_result.mGRmsError);
+                    result.mGRmsError += cell_result.mGRmsError/traces.size();
+                    result.mAmplitudeError += cell_result.mAmplitudeError/traces.size();
+                    if (cell_result.mPeriodError >= 0.0)
+                    {
+                        result.mPeriodError += cell_result.mPeriodError;
+                        result.mPhaseError += cell_result.mPhaseError;
+                        num_periodic_cells++;
+                    }
+                }
+                if (num_periodic_cells > 0)
+                {
+                    result.mPeriodError /= num_periodic_cells;
+                    result.mPhaseError /= num_periodic_cells;
+                }
+                else
+                {
+                    result.mPeriodError = -1.0;
+                    result.mPhaseError = -1.0;
+                }
+                results.push_back(result);
+            }
+        }
+
+        FindParetoFront(results);
+        ReportResults("6x6 coupled tissue", "rk4 dt=1e-3", results, reference_cpu_seconds, "tissue.json");
+
+        TS_ASSERT(results[RUNGE_KUTTA_4*num_dts + 1].mSucceeded);
+    }
+};
+
+#endif /*ODEACCURACYSTUDY_HPP_*/
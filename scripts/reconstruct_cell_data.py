@@ -0,0 +1,60 @@
+#
+# Rebuilds full frames from a delta-encoded cell_data.xml
+# (XMLCellWriter::SetDeltaEncoding). Files without delta encoding pass
+# through unchanged.
+#
+# Usage: python reconstruct_cell_data.py cell_data.xml [full_cell_data.xml]
+#
+
+import re
+import sys
+
+TIME_RE = re.compile(r'<time ([^>]*)>')
+CELL_RE = re.compile(r'<cell .*?cell_id="(\d+)".*?/>')
+REMOVED_RE = re.compile(r'<removed cell_id="(\d+)"\s*/>')
+
+
+def iter_frames(path):
+    """Yield (time_attributes, {cell_id: cell_line}) for every frame, with delta frames filled in."""
+    cells = {}
+    time_attributes = None
+    frame = None
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            time_match = TIME_RE.match(line)
+            if time_match:
+                time_attributes = time_match.group(1)
+                if 'keyframe="0"' not in time_attributes:
+                    cells = {}
+                frame = dict(cells)
+                continue
+            cell_match = CELL_RE.match(line)
+            if cell_match:
+                frame[int(cell_match.group(1))] = line
+                continue
+            removed_match = REMOVED_RE.match(line)
+            if removed_match:
+                frame.pop(int(removed_match.group(1)), None)
+                continue
+            if line == '</time>':
+                cells = frame
+                yield time_attributes, frame
+
+
+def main():
+    if len(sys.argv) < 2:
+        print('\nError: no file path specified\n')
+        sys.exit(1)
+
+    out = open(sys.argv[2], 'w') if len(sys.argv) > 2 else sys.stdout
+    for time_attributes, frame in iter_frames(sys.argv[1]):
+        time_attributes = re.sub(r'\s*keyframe="\d"', '', time_attributes)
+        out.write('<time %s>\n' % time_attributes)
+        for cell_id in sorted(frame):
+            out.write(frame[cell_id] + '\n')
+        out.write('</time>\n')
+
+
+if __name__ == '__main__':
+    main()
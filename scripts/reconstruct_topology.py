@@ -0,0 +1,61 @@
+#
+# Rebuilds the cell adjacency at a given time from topology_events.dat
+# (TopologyEventWriter).
+#
+# Usage: python reconstruct_topology.py topology_events.dat time
+# Prints one line per cell: cell_id neighbour neighbour ...
+#
+
+import sys
+
+
+def adjacency_at(path, time):
+    """Return {cell_id: set(neighbour_ids)} after applying all events at or before time."""
+    adjacency = {}
+
+    def add_edge(a, b):
+        adjacency.setdefault(a, set()).add(b)
+        adjacency.setdefault(b, set()).add(a)
+
+    def remove_edge(a, b):
+        adjacency.get(a, set()).discard(b)
+        adjacency.get(b, set()).discard(a)
+
+    with open(path) as f:
+        for line in f:
+            if line.startswith('#'):
+                continue
+            fields = line.split()
+            if not fields or float(fields[0]) > time:
+                continue
+            event = fields[1]
+            ids = [int(x) for x in fields[2:]]
+            if event in ('init', 'add_cell'):
+                adjacency.setdefault(ids[0], set())
+                for neighbour in ids[1:]:
+                    add_edge(ids[0], neighbour)
+            elif event == 'remove_cell':
+                for neighbour in adjacency.pop(ids[0], set()):
+                    adjacency.get(neighbour, set()).discard(ids[0])
+            elif event == 'T1':
+                remove_edge(ids[0], ids[1])
+                add_edge(ids[2], ids[3])
+            elif event == 'remove_edge':
+                remove_edge(ids[0], ids[1])
+            elif event == 'add_edge':
+                add_edge(ids[0], ids[1])
+    return adjacency
+
+
+def main():
+    if len(sys.argv) < 3:
+        print('\nError: usage reconstruct_topology.py topology_events.dat time\n')
+        sys.exit(1)
+
+    adjacency = adjacency_at(sys.argv[1], float(sys.argv[2]))
+    for cell_id in sorted(adjacency):
+        print(' '.join(str(x) for x in [cell_id] + sorted(adjacency[cell_id])))
+
+
+if __name__ == '__main__':
+    main()
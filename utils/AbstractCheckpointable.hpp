@@ -0,0 +1,48 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef ABSTRACTCHECKPOINTABLE_HPP_
+#define ABSTRACTCHECKPOINTABLE_HPP_
+
+#include <istream>
+#include <ostream>
+
+/**
+ * Interface of a writer or modifier whose output depends on what it has seen
+ * at earlier samples (a delta baseline, the previous adjacency, partly filled
+ * filter blocks). Registered with CheckpointModifier::AddCheckpointable(), its
+ * state is saved in every TissueCheckpoint and loaded when a run resumes, so
+ * that the resumed run writes exactly what the uninterrupted run would have.
+ *
+ * State is loaded after the writer files have been opened and the modifiers
+ * set up, so OpenOutputFile() and SetupSolve() may clear it as usual.
+ */
+class AbstractCheckpointable
+{
+public:
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~AbstractCheckpointable()
+    {
+    }
+
+    /**
+     * Write the state to a checkpoint, see CheckpointStream.
+     *
+     * @param rStream the stream
+     */
+    virtual void SaveCheckpointState(std::ostream& rStream) const=0;
+
+    /**
+     * Read the state written by SaveCheckpointState().
+     *
+     * @param rStream the stream
+     */
+    virtual void LoadCheckpointState(std::istream& rStream)=0;
+};
+
+#endif /*ABSTRACTCHECKPOINTABLE_HPP_*/
@@ -0,0 +1,118 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef CHECKPOINTSTREAM_HPP_
+#define CHECKPOINTSTREAM_HPP_
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "Exception.hpp"
+
+/**
+ * Raw binary reading and writing of values, arrays and strings, in native
+ * byte order, as used by TissueCheckpoint and by the state that writers and
+ * modifiers add to a checkpoint (see AbstractCheckpointable).
+ */
+class CheckpointStream
+{
+public:
+
+    /**
+     * Write a single value.
+     *
+     * @param rStream the stream
+     * @param rValue the value
+     */
+    template<typename T>
+    static void WriteValue(std::ostream& rStream, const T& rValue)
+    {
+        rStream.write(reinterpret_cast<const char*>(&rValue), sizeof(T));
+    }
+
+    /**
+     * Write an array as its length followed by its values in one block.
+     *
+     * @param rStream the stream
+     * @param rArray the array
+     */
+    template<typename T>
+    static void WriteArray(std::ostream& rStream, const std::vector<T>& rArray)
+    {
+        WriteValue(rStream, (boost::uint64_t)rArray.size());
+        if (!rArray.empty())
+        {
+            rStream.write(reinterpret_cast<const char*>(&rArray[0]), rArray.size()*sizeof(T));
+        }
+    }
+
+    /**
+     * Write a string as its length followed by its characters.
+     *
+     * @param rStream the stream
+     * @param rString the string
+     */
+    static void WriteString(std::ostream& rStream, const std::string& rString)
+    {
+        WriteValue(rStream, (boost::uint64_t)rString.size());
+        rStream.write(rString.data(), rString.size());
+    }
+
+    /**
+     * Read a single value.
+     *
+     * @param rStream the stream
+     * @param rValue filled with the value
+     */
+    template<typename T>
+    static void ReadValue(std::istream& rStream, T& rValue)
+    {
+        rStream.read(reinterpret_cast<char*>(&rValue), sizeof(T));
+        if (!rStream)
+        {
+            EXCEPTION("Checkpoint file is truncated");
+        }
+    }
+
+    /**
+     * Read an array written by WriteArray().
+     *
+     * @param rStream the stream
+     * @param rArray filled with the array
+     */
+    template<typename T>
+    static void ReadArray(std::istream& rStream, std::vector<T>& rArray)
+    {
+        boost::uint64_t size;
+        ReadValue(rStream, size);
+        rArray.resize(size);
+        if (size > 0)
+        {
+            rStream.read(reinterpret_cast<char*>(&rArray[0]), size*sizeof(T));
+            if (!rStream)
+            {
+                EXCEPTION("Checkpoint file is truncated");
+            }
+        }
+    }
+
+    /**
+     * Read a string written by WriteString().
+     *
+     * @param rStream the stream
+     * @param rString filled with the string
+     */
+    static void ReadString(std::istream& rStream, std::string& rString)
+    {
+        std::vector<char> characters;
+        ReadArray(rStream, characters);
+        rString.assign(characters.begin(), characters.end());
+    }
+};
+
+#endif /*CHECKPOINTSTREAM_HPP_*/
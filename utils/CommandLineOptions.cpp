@@ -0,0 +1,94 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "CommandLineOptions.hpp"
+#include "Exception.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+
+CommandLineOptions::CommandLineOptions(int argc, char* argv[], int firstArgument)
+{
+    for (int i=firstArgument; i<argc; i++)
+    {
+        std::string assignment = argv[i];
+        std::string::size_type equals = assignment.find('=');
+        if (equals == std::string::npos)
+        {
+            EXCEPTION("Expected key=value, got " + assignment);
+        }
+        mValues[assignment.substr(0, equals)] = assignment.substr(equals + 1);
+    }
+}
+
+bool CommandLineOptions::Has(const std::string& rKey) const
+{
+    return mValues.find(rKey) != mValues.end();
+}
+
+std::string CommandLineOptions::GetString(const std::string& rKey, const std::string& rDefault)
+{
+    std::map<std::string, std::string>::iterator it = mValues.find(rKey);
+    if (it == mValues.end())
+    {
+        return rDefault;
+    }
+    std::string value = it->second;
+    mValues.erase(it);
+    return value;
+}
+
+double CommandLineOptions::GetDouble(const std::string& rKey, double defaultValue)
+{
+    if (!Has(rKey))
+    {
+        return defaultValue;
+    }
+    std::string text = GetString(rKey, "");
+    char* p_end;
+    errno = 0;
+    double value = std::strtod(text.c_str(), &p_end);
+    if (text.empty() || *p_end != '\0' || errno == ERANGE)
+    {
+        EXCEPTION("Option " + rKey + " is not a number: " + text);
+    }
+    return value;
+}
+
+unsigned CommandLineOptions::GetUnsigned(const std::string& rKey, unsigned defaultValue)
+{
+    if (!Has(rKey))
+    {
+        return defaultValue;
+    }
+    std::string text = GetString(rKey, "");
+    char* p_end;
+    errno = 0;
+    unsigned long value = std::strtoul(text.c_str(), &p_end, 10);
+    if (text.empty() || *p_end != '\0' || text[0] == '-' || errno == ERANGE || value > UINT_MAX)
+    {
+        EXCEPTION("Option " + rKey + " is not a non-negative integer: " + text);
+    }
+    return value;
+}
+
+std::vector<std::string> CommandLineOptions::GetRemainingKeys() const
+{
+    std::vector<std::string> keys;
+    for (std::map<std::string, std::string>::const_iterator it = mValues.begin(); it != mValues.end(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+    return keys;
+}
+
+void CommandLineOptions::CheckAllUsed() const
+{
+    if (!mValues.empty())
+    {
+        EXCEPTION("Unknown option " + mValues.begin()->first);
+    }
+}
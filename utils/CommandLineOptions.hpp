@@ -0,0 +1,82 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef COMMANDLINEOPTIONS_HPP_
+#define COMMANDLINEOPTIONS_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * The "key=value" arguments of a command line tool.
+ *
+ * Each Get method removes the option it reads, so that whatever is left
+ * afterwards can be passed on (e.g. as kinetic parameter names) or reported
+ * as unknown. Values are parsed with the same checks as ScenarioConfig:
+ * unparsable numbers are errors rather than silently read as 0.
+ */
+class CommandLineOptions
+{
+private:
+
+    /** The options not read yet. */
+    std::map<std::string, std::string> mValues;
+
+public:
+
+    /**
+     * Constructor. Parses argv[firstArgument] onwards, each of which must be
+     * of the form key=value.
+     *
+     * @param argc the number of arguments
+     * @param argv the arguments
+     * @param firstArgument the index of the first key=value argument (default 1)
+     */
+    CommandLineOptions(int argc, char* argv[], int firstArgument=1);
+
+    /**
+     * @param rKey the key
+     * @return whether the option was given and has not been read yet
+     */
+    bool Has(const std::string& rKey) const;
+
+    /**
+     * Read and remove a text option.
+     *
+     * @param rKey the key
+     * @param rDefault the value if the option was not given
+     * @return the value
+     */
+    std::string GetString(const std::string& rKey, const std::string& rDefault);
+
+    /**
+     * Read and remove a numeric option.
+     *
+     * @param rKey the key
+     * @param defaultValue the value if the option was not given
+     * @return the value
+     */
+    double GetDouble(const std::string& rKey, double defaultValue);
+
+    /**
+     * Read and remove a non-negative integer option.
+     *
+     * @param rKey the key
+     * @param defaultValue the value if the option was not given
+     * @return the value
+     */
+    unsigned GetUnsigned(const std::string& rKey, unsigned defaultValue);
+
+    /** @return the keys of the options not read yet, in alphabetical order. */
+    std::vector<std::string> GetRemainingKeys() const;
+
+    /**
+     * Throw if any option has not been read, naming the first one.
+     */
+    void CheckAllUsed() const;
+};
+
+#endif /*COMMANDLINEOPTIONS_HPP_*/
@@ -0,0 +1,129 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "CounterBasedRandomGenerator.hpp"
+
+#include <cmath>
+
+namespace
+{
+/** Philox4x32 round multipliers. */
+const boost::uint32_t PHILOX_M0 = 0xD2511F53u;
+const boost::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+
+/** Philox4x32 key increments (golden ratio and sqrt(3) - 1). */
+const boost::uint32_t PHILOX_W0 = 0x9E3779B9u;
+const boost::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+/** Number of Philox rounds. */
+const unsigned PHILOX_ROUNDS = 10;
+
+/** 2^-53, the spacing of the uniform values. */
+const double UNIFORM_SCALE = 1.0/9007199254740992.0;
+}
+
+CounterBasedRandomGenerator::CounterBasedRandomGenerator(boost::uint64_t seed)
+    : mSeed(seed)
+{
+}
+
+boost::uint64_t CounterBasedRandomGenerator::GetSeed() const
+{
+    return mSeed;
+}
+
+void CounterBasedRandomGenerator::Philox4x32(const boost::uint32_t* pCounter, const boost::uint32_t* pKey, boost::uint32_t* pResult)
+{
+    boost::uint32_t x0 = pCounter[0];
+    boost::uint32_t x1 = pCounter[1];
+    boost::uint32_t x2 = pCounter[2];
+    boost::uint32_t x3 = pCounter[3];
+    boost::uint32_t k0 = pKey[0];
+    boost::uint32_t k1 = pKey[1];
+
+    for (unsigned round=0; round<PHILOX_ROUNDS; round++)
+    {
+        boost::uint64_t product0 = (boost::uint64_t)PHILOX_M0*x0;
+        boost::uint64_t product1 = (boost::uint64_t)PHILOX_M1*x2;
+        boost::uint32_t y0 = (boost::uint32_t)(product1 >> 32) ^ x1 ^ k0;
+        boost::uint32_t y2 = (boost::uint32_t)(product0 >> 32) ^ x3 ^ k1;
+        x1 = (boost::uint32_t)product1;
+        x3 = (boost::uint32_t)product0;
+        x0 = y0;
+        x2 = y2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    pResult[0] = x0;
+    pResult[1] = x1;
+    pResult[2] = x2;
+    pResult[3] = x3;
+}
+
+void CounterBasedRandomGenerator::GetBlock(unsigned cellId, unsigned stream, boost::uint64_t block, boost::uint32_t* pBits) const
+{
+    boost::uint32_t counter[4] = {(boost::uint32_t)block, (boost::uint32_t)(block >> 32), cellId, stream};
+    boost::uint32_t key[2] = {(boost::uint32_t)mSeed, (boost::uint32_t)(mSeed >> 32)};
+    Philox4x32(counter, key, pBits);
+}
+
+double CounterBasedRandomGenerator::ToUniform(boost::uint32_t high, boost::uint32_t low)
+{
+    boost::uint64_t bits = ((boost::uint64_t)high << 32) | low;
+    return (double)(bits >> 11)*UNIFORM_SCALE;
+}
+
+double CounterBasedRandomGenerator::ranf(unsigned cellId, unsigned stream, boost::uint64_t index) const
+{
+    boost::uint32_t bits[4];
+    GetBlock(cellId, stream, index >> 1, bits);
+    unsigned offset = 2*(unsigned)(index & 1);
+    return ToUniform(bits[offset], bits[offset + 1]);
+}
+
+double CounterBasedRandomGenerator::NormalRandomDeviate(unsigned cellId, unsigned stream, boost::uint64_t index, double mean, double sd) const
+{
+    boost::uint32_t bits[4];
+    GetBlock(cellId, stream, index >> 1, bits);
+
+    // 1 - u lies in (0,1], so the logarithm is finite
+    double u1 = 1.0 - ToUniform(bits[0], bits[1]);
+    double u2 = ToUniform(bits[2], bits[3]);
+    double radius = sqrt(-2.0*log(u1));
+    double angle = 2.0*M_PI*u2;
+    return mean + sd*radius*((index & 1) ? sin(angle) : cos(angle));
+}
+
+void CounterBasedRandomGenerator::FillRanf(unsigned firstCellId, unsigned numCells, unsigned stream, boost::uint64_t index, double* pValues) const
+{
+    boost::uint32_t counter[4] = {(boost::uint32_t)(index >> 1), (boost::uint32_t)(index >> 33), 0, stream};
+    boost::uint32_t key[2] = {(boost::uint32_t)mSeed, (boost::uint32_t)(mSeed >> 32)};
+    unsigned offset = 2*(unsigned)(index & 1);
+
+    for (unsigned i=0; i<numCells; i++)
+    {
+        boost::uint32_t bits[4];
+        counter[2] = firstCellId + i;
+        Philox4x32(counter, key, bits);
+        pValues[i] = ToUniform(bits[offset], bits[offset + 1]);
+    }
+}
+
+void CounterBasedRandomGenerator::FillRanf(const std::vector<unsigned>& rCellIds, unsigned stream, boost::uint64_t index, std::vector<double>& rValues) const
+{
+    boost::uint32_t counter[4] = {(boost::uint32_t)(index >> 1), (boost::uint32_t)(index >> 33), 0, stream};
+    boost::uint32_t key[2] = {(boost::uint32_t)mSeed, (boost::uint32_t)(mSeed >> 32)};
+    unsigned offset = 2*(unsigned)(index & 1);
+
+    rValues.resize(rCellIds.size());
+    for (unsigned i=0; i<rCellIds.size(); i++)
+    {
+        boost::uint32_t bits[4];
+        counter[2] = rCellIds[i];
+        Philox4x32(counter, key, bits);
+        rValues[i] = ToUniform(bits[offset], bits[offset + 1]);
+    }
+}
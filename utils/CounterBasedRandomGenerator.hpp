@@ -0,0 +1,131 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef COUNTERBASEDRANDOMGENERATOR_HPP_
+#define COUNTERBASEDRANDOMGENERATOR_HPP_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+
+/**
+ * Counter-based random numbers for per-cell quantities, using the
+ * Philox4x32-10 bijection of Salmon et al. (SC11, "Parallel random numbers:
+ * as easy as 1, 2, 3").
+ *
+ * Every value is a pure function of (seed, cell ID, stream, index): the seed
+ * is the key, and the cell ID, stream and index make up the counter. Unlike
+ * draws from the RandomNumberGenerator singleton, values therefore do not
+ * depend on the order in which cells are built, on how many threads or
+ * processes build them, or on which other quantities were drawn before. The
+ * generator holds no state besides the seed, so it can be copied freely and
+ * used concurrently.
+ *
+ * Each quantity gets its own stream. The index tells apart values of the
+ * same quantity for the same cell, e.g. the time step of a stochastic term.
+ * One Philox block gives two uniform values, so even and odd indices share a
+ * block. The Fill methods evaluate a stream for many cells in a loop without
+ * branches, which the compiler can vectorise.
+ */
+class CounterBasedRandomGenerator
+{
+public:
+
+    /** The streams in use. New quantities must be given new streams, at the end. */
+    enum Stream
+    {
+        INITIAL_G = 0,
+        BETA,
+        NUM_STREAMS
+    };
+
+private:
+
+    /** The seed, used as the Philox key. */
+    boost::uint64_t mSeed;
+
+    /**
+     * Compute the Philox block of a cell.
+     *
+     * @param cellId the cell ID
+     * @param stream the stream
+     * @param block the index of the block, i.e. index/2
+     * @param pBits filled in with the four 32-bit words of the block
+     */
+    void GetBlock(unsigned cellId, unsigned stream, boost::uint64_t block, boost::uint32_t* pBits) const;
+
+    /**
+     * @param high the high 32 bits
+     * @param low the low 32 bits
+     * @return a uniform value in [0,1) made from their top 53 bits
+     */
+    static double ToUniform(boost::uint32_t high, boost::uint32_t low);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param seed the seed (defaults to 0)
+     */
+    CounterBasedRandomGenerator(boost::uint64_t seed = 0);
+
+    /** @return the seed */
+    boost::uint64_t GetSeed() const;
+
+    /**
+     * The Philox4x32-10 bijection.
+     *
+     * @param pCounter the four 32-bit words of the counter
+     * @param pKey the two 32-bit words of the key
+     * @param pResult filled in with the four 32-bit words of the result
+     */
+    static void Philox4x32(const boost::uint32_t* pCounter, const boost::uint32_t* pKey, boost::uint32_t* pResult);
+
+    /**
+     * @param cellId the cell ID
+     * @param stream the stream
+     * @param index the index of the value within the stream of this cell (defaults to 0)
+     * @return a uniform random value in [0,1)
+     */
+    double ranf(unsigned cellId, unsigned stream, boost::uint64_t index = 0) const;
+
+    /**
+     * A normal deviate by the Box-Muller transform, using both uniform values
+     * of the block holding index.
+     *
+     * @param cellId the cell ID
+     * @param stream the stream
+     * @param index the index of the deviate within the stream of this cell
+     * @param mean the mean
+     * @param sd the standard deviation
+     * @return a normal random deviate
+     */
+    double NormalRandomDeviate(unsigned cellId, unsigned stream, boost::uint64_t index, double mean, double sd) const;
+
+    /**
+     * Fill an array with the uniform values of a stream for consecutive cell
+     * IDs, as ranf(firstCellId + i, stream, index) for the i-th value.
+     *
+     * @param firstCellId the ID of the first cell
+     * @param numCells the number of cells
+     * @param stream the stream
+     * @param index the index of the values within the stream of each cell
+     * @param pValues filled in with numCells values
+     */
+    void FillRanf(unsigned firstCellId, unsigned numCells, unsigned stream, boost::uint64_t index, double* pValues) const;
+
+    /**
+     * Fill a vector with the uniform values of a stream for the given cells,
+     * as ranf(rCellIds[i], stream, index) for the i-th value.
+     *
+     * @param rCellIds the cell IDs
+     * @param stream the stream
+     * @param index the index of the values within the stream of each cell
+     * @param rValues resized and filled in with one value per cell
+     */
+    void FillRanf(const std::vector<unsigned>& rCellIds, unsigned stream, boost::uint64_t index, std::vector<double>& rValues) const;
+};
+
+#endif /*COUNTERBASEDRANDOMGENERATOR_HPP_*/
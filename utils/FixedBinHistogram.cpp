@@ -0,0 +1,55 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "FixedBinHistogram.hpp"
+#include <cassert>
+
+FixedBinHistogram::FixedBinHistogram(double min, double max, unsigned numBins)
+    : mMin(min),
+      mMax(max),
+      mCounts(numBins, 0)
+{
+    assert(numBins > 0);
+    assert(max > min);
+}
+
+void FixedBinHistogram::Add(double value)
+{
+    unsigned num_bins = mCounts.size();
+    unsigned bin = 0;
+    if (value >= mMax)
+    {
+        bin = num_bins - 1;
+    }
+    else if (value > mMin)
+    {
+        bin = (unsigned)((value - mMin)/(mMax - mMin)*num_bins);
+        if (bin >= num_bins)
+        {
+            bin = num_bins - 1;
+        }
+    }
+    mCounts[bin]++;
+}
+
+void FixedBinHistogram::Reset()
+{
+    mCounts.assign(mCounts.size(), 0);
+}
+
+const std::vector<unsigned>& FixedBinHistogram::rGetCounts() const
+{
+    return mCounts;
+}
+
+unsigned FixedBinHistogram::GetNumBins() const
+{
+    return mCounts.size();
+}
+
+double FixedBinHistogram::GetBinLowerEdge(unsigned bin) const
+{
+    return mMin + bin*(mMax - mMin)/mCounts.size();
+}
@@ -0,0 +1,63 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef FIXEDBINHISTOGRAM_HPP_
+#define FIXEDBINHISTOGRAM_HPP_
+
+#include <vector>
+
+/**
+ * A histogram with a fixed number of equal-width bins over [min, max).
+ * Values below min are counted in the first bin and values at or above max
+ * in the last, so the bin counts always sum to the number of values added.
+ */
+class FixedBinHistogram
+{
+private:
+
+    /** Lower edge of the first bin. */
+    double mMin;
+
+    /** Upper edge of the last bin. */
+    double mMax;
+
+    /** The count in each bin. */
+    std::vector<unsigned> mCounts;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param min the lower edge of the first bin
+     * @param max the upper edge of the last bin
+     * @param numBins the number of bins
+     */
+    FixedBinHistogram(double min=0.0, double max=1.0, unsigned numBins=10);
+
+    /**
+     * Add a value to the histogram.
+     *
+     * @param value the value
+     */
+    void Add(double value);
+
+    /** Set all bin counts to zero. */
+    void Reset();
+
+    /** @return the bin counts. */
+    const std::vector<unsigned>& rGetCounts() const;
+
+    /** @return the number of bins. */
+    unsigned GetNumBins() const;
+
+    /**
+     * @param bin the bin index
+     * @return the lower edge of the given bin
+     */
+    double GetBinLowerEdge(unsigned bin) const;
+};
+
+#endif /*FIXEDBINHISTOGRAM_HPP_*/
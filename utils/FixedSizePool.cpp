@@ -0,0 +1,103 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "FixedSizePool.hpp"
+
+#include <cassert>
+#include <new>
+
+namespace
+{
+/** Alignment of every block; that of malloc on 64-bit glibc. */
+const std::size_t BLOCK_ALIGNMENT = 16;
+
+/** Number of blocks in the first chunk if Reserve() was not called. */
+const std::size_t DEFAULT_CHUNK_BLOCKS = 256;
+}
+
+FixedSizePool::FixedSizePool(std::size_t objectBytes)
+    : mBlockBytes(0),
+      mChunkBlocks(DEFAULT_CHUNK_BLOCKS),
+      mpFreeList(NULL),
+      mNumAllocated(0),
+      mNumBlocks(0)
+{
+    // A free block must be able to hold the free list link
+    std::size_t block_bytes = objectBytes < sizeof(void*) ? sizeof(void*) : objectBytes;
+    mBlockBytes = (block_bytes + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+FixedSizePool::~FixedSizePool()
+{
+    for (unsigned i=0; i<mChunks.size(); i++)
+    {
+        ::operator delete(mChunks[i]);
+    }
+}
+
+void FixedSizePool::AddChunk(std::size_t numBlocks)
+{
+    assert(numBlocks > 0);
+    char* p_chunk = static_cast<char*>(::operator new(numBlocks*mBlockBytes));
+    mChunks.push_back(p_chunk);
+    mChunkBlocks = numBlocks;
+    mNumBlocks += numBlocks;
+
+    // Link the blocks back to front so that they are handed out in address order
+    for (std::size_t i=numBlocks; i>0; i--)
+    {
+        void* p_block = p_chunk + (i-1)*mBlockBytes;
+        *static_cast<void**>(p_block) = mpFreeList;
+        mpFreeList = p_block;
+    }
+}
+
+void* FixedSizePool::Allocate()
+{
+    if (mpFreeList == NULL)
+    {
+        AddChunk(mChunkBlocks);
+    }
+    void* p_block = mpFreeList;
+    mpFreeList = *static_cast<void**>(p_block);
+    mNumAllocated++;
+    return p_block;
+}
+
+void FixedSizePool::Deallocate(void* pBlock)
+{
+    if (pBlock == NULL)
+    {
+        return;
+    }
+    assert(mNumAllocated > 0);
+    *static_cast<void**>(pBlock) = mpFreeList;
+    mpFreeList = pBlock;
+    mNumAllocated--;
+}
+
+void FixedSizePool::Reserve(std::size_t numBlocks)
+{
+    std::size_t num_free = mNumBlocks - mNumAllocated;
+    if (numBlocks > num_free)
+    {
+        AddChunk(numBlocks - num_free);
+    }
+}
+
+std::size_t FixedSizePool::GetBlockBytes() const
+{
+    return mBlockBytes;
+}
+
+std::size_t FixedSizePool::GetNumAllocated() const
+{
+    return mNumAllocated;
+}
+
+std::size_t FixedSizePool::GetNumBlocks() const
+{
+    return mNumBlocks;
+}
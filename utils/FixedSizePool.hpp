@@ -0,0 +1,100 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef FIXEDSIZEPOOL_HPP_
+#define FIXEDSIZEPOOL_HPP_
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * A pool of equally sized memory blocks, carved out of large chunks and
+ * recycled through a free list, for the class-specific operator new and
+ * operator delete of objects that every cell owns (see ODESrnModel and
+ * ODESRN).
+ *
+ * Reserve() allocates one chunk big enough for a whole tissue up front, so
+ * that a bulk set-up (see GTPaseCellFactory) places the objects of
+ * consecutive cells next to each other instead of scattering them over the
+ * heap. When the free list runs out, a new chunk of the same size as the last
+ * one is allocated. Chunks are only returned to the system when the pool is
+ * destroyed. Not thread safe.
+ */
+class FixedSizePool
+{
+private:
+
+    /** The size of a block, rounded up to keep blocks 16-byte aligned. */
+    std::size_t mBlockBytes;
+
+    /** The chunks allocated so far. */
+    std::vector<char*> mChunks;
+
+    /** The number of blocks in the last chunk. */
+    std::size_t mChunkBlocks;
+
+    /** The first free block, or NULL. Each free block holds a pointer to the next. */
+    void* mpFreeList;
+
+    /** The number of blocks handed out and not yet returned. */
+    std::size_t mNumAllocated;
+
+    /** The number of blocks in all chunks. */
+    std::size_t mNumBlocks;
+
+    /**
+     * Allocate a chunk and add its blocks to the free list, in address order.
+     *
+     * @param numBlocks the number of blocks in the chunk
+     */
+    void AddChunk(std::size_t numBlocks);
+
+    /** Not copyable. */
+    FixedSizePool(const FixedSizePool&);
+    /** Not assignable. */
+    FixedSizePool& operator=(const FixedSizePool&);
+
+public:
+
+    /**
+     * Constructor. No memory is allocated until the first Allocate() or
+     * Reserve().
+     *
+     * @param objectBytes the size of the objects to be stored
+     */
+    FixedSizePool(std::size_t objectBytes);
+
+    /** Destructor. Frees all chunks, whether or not their blocks were returned. */
+    ~FixedSizePool();
+
+    /** @return a block of at least the object size */
+    void* Allocate();
+
+    /**
+     * Return a block obtained from Allocate().
+     *
+     * @param pBlock the block
+     */
+    void Deallocate(void* pBlock);
+
+    /**
+     * Make sure that at least numBlocks more blocks can be handed out without
+     * allocating, using a single new chunk if needed.
+     *
+     * @param numBlocks the number of blocks
+     */
+    void Reserve(std::size_t numBlocks);
+
+    /** @return the size of a block */
+    std::size_t GetBlockBytes() const;
+
+    /** @return the number of blocks handed out and not yet returned */
+    std::size_t GetNumAllocated() const;
+
+    /** @return the number of blocks in all chunks */
+    std::size_t GetNumBlocks() const;
+};
+
+#endif /*FIXEDSIZEPOOL_HPP_*/
@@ -0,0 +1,87 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "GTPaseCellFactory.hpp"
+
+#include "SmartPointers.hpp"
+#include "NoCellCycleModel.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "ODESrnModel.hpp"
+#include "ODESRN.hpp"
+#include "GTPaseProfiler.hpp"
+#include "Exception.hpp"
+
+GTPaseCellFactory::GTPaseCellFactory(boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver, double dt)
+    : mpOdeSolver(pOdeSolver),
+      mDt(dt),
+      mNumCells(0),
+      mSetupSeconds(0.0)
+{
+    if (!mpOdeSolver)
+    {
+        mpOdeSolver = CellCycleModelOdeSolver<ODESrnModel, RungeKutta4IvpOdeSolver>::Instance();
+        mpOdeSolver->Initialise();
+    }
+}
+
+void GTPaseCellFactory::GenerateCells(std::vector<CellPtr>& rCells,
+                                      const std::vector<double>& rInitialG,
+                                      const std::vector<double>& rInitialTargetArea,
+                                      const std::vector<double>& rInitialArea)
+{
+    unsigned num_cells = rInitialG.size();
+    if (rInitialTargetArea.size() != num_cells || rInitialArea.size() != num_cells)
+    {
+        EXCEPTION("GTPaseCellFactory needs the same number of initial G, target area and area values");
+    }
+
+    double start_time = GTPaseProfiler::Now();
+
+    ODESrnModel::ReservePool(num_cells);
+    ODESRN::ReservePool(num_cells);
+    rCells.reserve(rCells.size() + num_cells);
+
+    MAKE_PTR(WildTypeCellMutationState, p_state);
+    MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+    std::vector<double> initial_conditions(3);
+
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        ODESrnModel* p_srn_model = new ODESrnModel(mpOdeSolver);
+        p_srn_model->SetDt(mDt);
+
+        initial_conditions[0] = rInitialG[i];
+        initial_conditions[1] = rInitialTargetArea[i];
+        initial_conditions[2] = rInitialArea[i];
+        p_srn_model->SetInitialConditions(initial_conditions);
+
+        CellPtr p_cell(new Cell(p_state, new NoCellCycleModel(), p_srn_model));
+        p_cell->SetCellProliferativeType(p_differentiated_type);
+        p_cell->InitialiseCellCycleModel();
+        rCells.push_back(p_cell);
+    }
+
+    mNumCells = num_cells;
+    mSetupSeconds = GTPaseProfiler::Now() - start_time;
+}
+
+unsigned GTPaseCellFactory::GetNumCells() const
+{
+    return mNumCells;
+}
+
+double GTPaseCellFactory::GetSetupSeconds() const
+{
+    return mSetupSeconds;
+}
+
+void GTPaseCellFactory::WriteSetupTime(std::ostream& rStream) const
+{
+    rStream << "Created " << mNumCells << " cells in " << mSetupSeconds << " s ("
+            << (mNumCells > 0 ? 1e6*mSetupSeconds/mNumCells : 0.0) << " us per cell)\n";
+}
@@ -0,0 +1,88 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef GTPASECELLFACTORY_HPP_
+#define GTPASECELLFACTORY_HPP_
+
+#include <ostream>
+#include <vector>
+
+#include "Cell.hpp"
+#include "AbstractCellCycleModelOdeSolver.hpp"
+
+/**
+ * Builds the non-dividing GTPase cells of a tissue in one pass: wild type,
+ * differentiated, with a NoCellCycleModel and an ODESrnModel whose initial
+ * conditions are taken from arrays.
+ *
+ * Compared with constructing the cells one by one, the ODE solver is looked
+ * up and initialised once for all cells, the mutation state and
+ * proliferative type are shared, and the pools of ODESrnModel and ODESRN
+ * (see FixedSizePool) as well as the output vector are reserved for the whole
+ * tissue before the first cell is made, so the SRN models and ODE systems of
+ * consecutive cells are contiguous in memory. Cells and their cell-cycle
+ * models are Chaste classes and still come from the global heap.
+ *
+ * The wall time of the last GenerateCells() call is kept for reporting.
+ */
+class GTPaseCellFactory
+{
+private:
+
+    /** The ODE solver shared by all SRN models. */
+    boost::shared_ptr<AbstractCellCycleModelOdeSolver> mpOdeSolver;
+
+    /** The time step of the SRN models. */
+    double mDt;
+
+    /** The number of cells made by the last GenerateCells() call. */
+    unsigned mNumCells;
+
+    /** The wall time of the last GenerateCells() call, in seconds. */
+    double mSetupSeconds;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pOdeSolver an optional cell-cycle model ODE solver; by default
+     *     the shared RungeKutta4IvpOdeSolver instance of ODESrnModel is used
+     * @param dt the time step of the SRN models (defaults to 0.01, as in ODESrnModel)
+     */
+    GTPaseCellFactory(boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver = boost::shared_ptr<AbstractCellCycleModelOdeSolver>(),
+                      double dt = 0.01);
+
+    /**
+     * Make one cell per entry of the initial condition arrays, which must all
+     * have the same length, and append them to rCells. Cell IDs are assigned
+     * in array order.
+     *
+     * @param rCells the vector to which the cells are appended
+     * @param rInitialG the initial GTPase concentration of each cell
+     * @param rInitialTargetArea the initial target area of each cell
+     * @param rInitialArea the initial area of each cell
+     */
+    void GenerateCells(std::vector<CellPtr>& rCells,
+                       const std::vector<double>& rInitialG,
+                       const std::vector<double>& rInitialTargetArea,
+                       const std::vector<double>& rInitialArea);
+
+    /** @return the number of cells made by the last GenerateCells() call */
+    unsigned GetNumCells() const;
+
+    /** @return the wall time of the last GenerateCells() call, in seconds */
+    double GetSetupSeconds() const;
+
+    /**
+     * Write the number of cells and the set-up time, in total and per cell,
+     * of the last GenerateCells() call on one line.
+     *
+     * @param rStream the stream
+     */
+    void WriteSetupTime(std::ostream& rStream) const;
+};
+
+#endif /*GTPASECELLFACTORY_HPP_*/
@@ -0,0 +1,294 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "GTPaseProfiler.hpp"
+
+#include <cassert>
+#include <iomanip>
+#include <time.h>
+
+double GTPaseProfiler::mInclusiveSeconds[GTPaseProfiler::NUM_PHASES];
+double GTPaseProfiler::mExclusiveSeconds[GTPaseProfiler::NUM_PHASES];
+unsigned long GTPaseProfiler::mCalls[GTPaseProfiler::NUM_PHASES];
+unsigned long GTPaseProfiler::mItems[GTPaseProfiler::NUM_PHASES];
+double GTPaseProfiler::mSampleExclusiveSeconds[GTPaseProfiler::NUM_PHASES];
+unsigned long GTPaseProfiler::mSampleCalls[GTPaseProfiler::NUM_PHASES];
+GTPaseProfiler::ScopedTimer* GTPaseProfiler::mpActiveTimer = NULL;
+HardwareCounters GTPaseProfiler::mHardwareCounters;
+bool GTPaseProfiler::mHardwareCountersRequested = false;
+bool GTPaseProfiler::mHardwareCountersEnabled = false;
+unsigned long long GTPaseProfiler::mExclusiveEvents[GTPaseProfiler::NUM_PHASES][HardwareCounters::NUM_EVENTS];
+unsigned long long GTPaseProfiler::mSampleExclusiveEvents[GTPaseProfiler::NUM_PHASES][HardwareCounters::NUM_EVENTS];
+
+namespace
+{
+/** Names of the phases, indexed by GTPaseProfiler::Phase. */
+const char* PHASE_NAMES[GTPaseProfiler::NUM_PHASES] =
+{
+    "force_and_position_update",
+    "population_update",
+    "srn_solve",
+    "volume_tracking_modifier",
+    "ode_parameter_area_modifier",
+    "csv_writer",
+    "one_cell_writer",
+    "xml_cell_writer",
+    "topology_writer",
+    "topology_event_writer",
+    "population_statistics_writer",
+    "vtu_writer"
+};
+}
+
+GTPaseProfiler::ScopedTimer::ScopedTimer(Phase phase)
+    : mPhase(phase),
+      mStartTime(GTPaseProfiler::Now()),
+      mChildSeconds(0.0),
+      mpParent(GTPaseProfiler::mpActiveTimer)
+{
+    if (GTPaseProfiler::mHardwareCountersEnabled)
+    {
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            mChildEvents[e] = 0;
+        }
+        GTPaseProfiler::mHardwareCounters.Read(mStartEvents);
+    }
+    GTPaseProfiler::mpActiveTimer = this;
+}
+
+GTPaseProfiler::ScopedTimer::~ScopedTimer()
+{
+    double elapsed = GTPaseProfiler::Now() - mStartTime;
+    double exclusive = elapsed - mChildSeconds;
+
+    if (GTPaseProfiler::mHardwareCountersEnabled)
+    {
+        unsigned long long end_events[HardwareCounters::NUM_EVENTS];
+        GTPaseProfiler::mHardwareCounters.Read(end_events);
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            unsigned long long events = end_events[e] - mStartEvents[e];
+            unsigned long long exclusive_events = events > mChildEvents[e] ? events - mChildEvents[e] : 0;
+            GTPaseProfiler::mExclusiveEvents[mPhase][e] += exclusive_events;
+            GTPaseProfiler::mSampleExclusiveEvents[mPhase][e] += exclusive_events;
+            if (mpParent != NULL)
+            {
+                mpParent->mChildEvents[e] += events;
+            }
+        }
+    }
+
+    GTPaseProfiler::mInclusiveSeconds[mPhase] += elapsed;
+    GTPaseProfiler::mExclusiveSeconds[mPhase] += exclusive;
+    GTPaseProfiler::mSampleExclusiveSeconds[mPhase] += exclusive;
+    GTPaseProfiler::mCalls[mPhase]++;
+    GTPaseProfiler::mSampleCalls[mPhase]++;
+
+    if (mpParent != NULL)
+    {
+        mpParent->mChildSeconds += elapsed;
+    }
+    GTPaseProfiler::mpActiveTimer = mpParent;
+}
+
+double GTPaseProfiler::Now()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + 1e-9*now.tv_nsec;
+}
+
+bool GTPaseProfiler::IsEnabled()
+{
+#ifdef GTPASE_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GTPaseProfiler::Reset()
+{
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        mInclusiveSeconds[p] = 0.0;
+        mExclusiveSeconds[p] = 0.0;
+        mCalls[p] = 0;
+        mItems[p] = 0;
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            mExclusiveEvents[p][e] = 0;
+        }
+    }
+    ResetSample();
+}
+
+void GTPaseProfiler::ResetSample()
+{
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        mSampleExclusiveSeconds[p] = 0.0;
+        mSampleCalls[p] = 0;
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            mSampleExclusiveEvents[p][e] = 0;
+        }
+    }
+}
+
+bool GTPaseProfiler::EnableHardwareCounters()
+{
+    // Timers that are running now did not read the counters at their start
+    assert(mpActiveTimer == NULL);
+    mHardwareCountersRequested = true;
+    mHardwareCountersEnabled = mHardwareCounters.Open();
+    return mHardwareCountersEnabled;
+}
+
+void GTPaseProfiler::DisableHardwareCounters()
+{
+    assert(mpActiveTimer == NULL);
+    mHardwareCountersEnabled = false;
+    mHardwareCounters.Close();
+}
+
+bool GTPaseProfiler::AreHardwareCountersEnabled()
+{
+    return mHardwareCountersEnabled;
+}
+
+const std::string& GTPaseProfiler::rGetHardwareCounterStatus()
+{
+    return mHardwareCounters.rGetStatus();
+}
+
+void GTPaseProfiler::AddItems(Phase phase, unsigned long numItems)
+{
+    mItems[phase] += numItems;
+}
+
+const char* GTPaseProfiler::GetPhaseName(Phase phase)
+{
+    return PHASE_NAMES[phase];
+}
+
+void GTPaseProfiler::WriteSampleHeader(std::ostream& rStream)
+{
+    rStream << "# TimeStamp,Num_Steps,Wall_Seconds";
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        rStream << "," << PHASE_NAMES[p] << "_seconds," << PHASE_NAMES[p] << "_calls";
+    }
+    rStream << "\n";
+}
+
+void GTPaseProfiler::WriteSample(std::ostream& rStream, double time, unsigned numSteps, double wallSeconds)
+{
+    rStream << time << "," << numSteps << "," << wallSeconds;
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        rStream << "," << mSampleExclusiveSeconds[p] << "," << mSampleCalls[p];
+    }
+    rStream << "\n";
+}
+
+void GTPaseProfiler::WriteCounterSampleHeader(std::ostream& rStream)
+{
+    rStream << "# TimeStamp";
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            rStream << "," << PHASE_NAMES[p] << "_" << HardwareCounters::GetEventName((HardwareCounters::Event)e);
+        }
+    }
+    rStream << "\n";
+}
+
+void GTPaseProfiler::WriteCounterSample(std::ostream& rStream, double time)
+{
+    rStream << time;
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+        {
+            rStream << "," << mSampleExclusiveEvents[p][e];
+        }
+    }
+    rStream << "\n";
+}
+
+void GTPaseProfiler::WriteSummary(std::ostream& rStream, unsigned numSteps, double wallSeconds)
+{
+    double profiled_seconds = 0.0;
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        profiled_seconds += mExclusiveSeconds[p];
+    }
+
+    std::ios::fmtflags flags = rStream.flags();
+    rStream << std::fixed;
+    rStream << "Phase timings over " << numSteps << " steps, " << std::setprecision(3) << wallSeconds << " s wall time";
+    if (!IsEnabled())
+    {
+        rStream << " (profiling not compiled in; build with GTPASE_ENABLE_PROFILING)";
+    }
+    rStream << "\n\n";
+
+    rStream << std::left << std::setw(30) << "phase" << std::right
+            << std::setw(12) << "calls"
+            << std::setw(14) << "items"
+            << std::setw(14) << "inclusive_s"
+            << std::setw(14) << "exclusive_s"
+            << std::setw(14) << "us_per_call"
+            << std::setw(14) << "us_per_step"
+            << std::setw(10) << "%_wall" << "\n";
+    for (unsigned p=0; p<NUM_PHASES; p++)
+    {
+        rStream << std::left << std::setw(30) << PHASE_NAMES[p] << std::right
+                << std::setw(12) << mCalls[p]
+                << std::setw(14) << mItems[p]
+                << std::setw(14) << std::setprecision(4) << mInclusiveSeconds[p]
+                << std::setw(14) << mExclusiveSeconds[p]
+                << std::setw(14) << std::setprecision(2) << (mCalls[p] > 0 ? 1e6*mInclusiveSeconds[p]/mCalls[p] : 0.0)
+                << std::setw(14) << (numSteps > 0 ? 1e6*mInclusiveSeconds[p]/numSteps : 0.0)
+                << std::setw(10) << (wallSeconds > 0.0 ? 100.0*mExclusiveSeconds[p]/wallSeconds : 0.0) << "\n";
+    }
+    rStream << std::left << std::setw(30) << "unprofiled" << std::right
+            << std::setw(12) << "" << std::setw(14) << "" << std::setw(14) << ""
+            << std::setw(14) << std::setprecision(4) << wallSeconds - profiled_seconds
+            << std::setw(14) << "" << std::setw(14) << ""
+            << std::setw(10) << std::setprecision(2) << (wallSeconds > 0.0 ? 100.0*(wallSeconds - profiled_seconds)/wallSeconds : 0.0) << "\n";
+
+    if (mHardwareCountersRequested)
+    {
+        rStream << "\nHardware counters, exclusive per phase (" << mHardwareCounters.rGetStatus() << ")\n";
+        if (mHardwareCountersEnabled)
+        {
+            rStream << "\n" << std::left << std::setw(30) << "phase" << std::right;
+            for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+            {
+                rStream << std::setw(16) << HardwareCounters::GetEventName((HardwareCounters::Event)e);
+            }
+            rStream << std::setw(8) << "ipc" << std::setw(16) << "cache_mpki" << std::setw(16) << "branch_mpki" << "\n";
+            for (unsigned p=0; p<NUM_PHASES; p++)
+            {
+                const unsigned long long* p_events = mExclusiveEvents[p];
+                double instructions = (double)p_events[HardwareCounters::INSTRUCTIONS];
+                rStream << std::left << std::setw(30) << PHASE_NAMES[p] << std::right;
+                for (unsigned e=0; e<HardwareCounters::NUM_EVENTS; e++)
+                {
+                    rStream << std::setw(16) << p_events[e];
+                }
+                rStream << std::setw(8) << std::setprecision(2)
+                        << (p_events[HardwareCounters::CYCLES] > 0 ? instructions/p_events[HardwareCounters::CYCLES] : 0.0)
+                        << std::setw(16) << (instructions > 0.0 ? 1000.0*p_events[HardwareCounters::CACHE_MISSES]/instructions : 0.0)
+                        << std::setw(16) << (instructions > 0.0 ? 1000.0*p_events[HardwareCounters::BRANCH_MISSES]/instructions : 0.0) << "\n";
+            }
+        }
+    }
+    rStream.flags(flags);
+}
@@ -0,0 +1,230 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef GTPASEPROFILER_HPP_
+#define GTPASEPROFILER_HPP_
+
+#include <ostream>
+#include <string>
+
+#include "HardwareCounters.hpp"
+
+/**
+ * Per-phase timers and counters for the hot path of a simulation step.
+ *
+ * The instrumentation points use the GTPASE_PROFILE_SCOPE and
+ * GTPASE_PROFILE_COUNT macros, which expand to nothing unless the code is
+ * compiled with GTPASE_ENABLE_PROFILING defined.
+ *
+ * Phases may nest (e.g. SRN solves happen inside the population update), so
+ * both inclusive and exclusive times are kept; the exclusive time of a phase
+ * excludes the time spent in phases started inside it. Sample values are
+ * those since the last call to ResetSample(). Not thread safe.
+ *
+ * Optionally, EnableHardwareCounters() also records exclusive cycles,
+ * instructions, cache misses and branch misses per phase (see
+ * HardwareCounters). Each timer then reads the counters twice, which costs
+ * about a microsecond, so the fine-grained phases (SRN solves, XML cells)
+ * are slowed down noticeably.
+ *
+ * ProfilingModifier writes the per-sample CSV and the end-of-run summary.
+ */
+class GTPaseProfiler
+{
+public:
+
+    /** The instrumented phases. */
+    enum Phase
+    {
+        FORCE_AND_POSITION_UPDATE = 0,
+        POPULATION_UPDATE,
+        SRN_SOLVE,
+        VOLUME_TRACKING_MODIFIER,
+        ODE_PARAMETER_AREA_MODIFIER,
+        CSV_WRITER,
+        ONE_CELL_WRITER,
+        XML_CELL_WRITER,
+        TOPOLOGY_WRITER,
+        TOPOLOGY_EVENT_WRITER,
+        POPULATION_STATISTICS_WRITER,
+        VTU_WRITER,
+        NUM_PHASES
+    };
+
+    /** Times one phase from construction to destruction. */
+    class ScopedTimer
+    {
+    private:
+        /** The phase being timed. */
+        Phase mPhase;
+        /** The time at construction. */
+        double mStartTime;
+        /** The time spent in timers started while this one was active. */
+        double mChildSeconds;
+        /** The timer that was active when this one started, or NULL. */
+        ScopedTimer* mpParent;
+        /** The hardware counts at construction, if counters are enabled. */
+        unsigned long long mStartEvents[HardwareCounters::NUM_EVENTS];
+        /** The hardware counts of timers started while this one was active. */
+        unsigned long long mChildEvents[HardwareCounters::NUM_EVENTS];
+
+        /** Not copyable. */
+        ScopedTimer(const ScopedTimer&);
+        /** Not assignable. */
+        ScopedTimer& operator=(const ScopedTimer&);
+
+    public:
+        /**
+         * Start timing.
+         *
+         * @param phase the phase
+         */
+        ScopedTimer(Phase phase);
+
+        /** Stop timing and add the elapsed time to the phase. */
+        ~ScopedTimer();
+    };
+
+private:
+
+    /** Inclusive time of each phase over the run, in seconds. */
+    static double mInclusiveSeconds[NUM_PHASES];
+
+    /** Exclusive time of each phase over the run, in seconds. */
+    static double mExclusiveSeconds[NUM_PHASES];
+
+    /** Number of calls of each phase over the run. */
+    static unsigned long mCalls[NUM_PHASES];
+
+    /** Items (cells, nodes) processed by each phase over the run. */
+    static unsigned long mItems[NUM_PHASES];
+
+    /** Exclusive time of each phase in the current sample, in seconds. */
+    static double mSampleExclusiveSeconds[NUM_PHASES];
+
+    /** Number of calls of each phase in the current sample. */
+    static unsigned long mSampleCalls[NUM_PHASES];
+
+    /** The innermost active timer, or NULL. */
+    static ScopedTimer* mpActiveTimer;
+
+    /** The hardware counters. */
+    static HardwareCounters mHardwareCounters;
+
+    /** Whether hardware counters were requested with EnableHardwareCounters(). */
+    static bool mHardwareCountersRequested;
+
+    /** Whether hardware counters are being read by the timers. */
+    static bool mHardwareCountersEnabled;
+
+    /** Exclusive hardware counts of each phase over the run. */
+    static unsigned long long mExclusiveEvents[NUM_PHASES][HardwareCounters::NUM_EVENTS];
+
+    /** Exclusive hardware counts of each phase in the current sample. */
+    static unsigned long long mSampleExclusiveEvents[NUM_PHASES][HardwareCounters::NUM_EVENTS];
+
+public:
+
+    /** @return the current monotonic time in seconds. */
+    static double Now();
+
+    /** @return whether the instrumentation was compiled in. */
+    static bool IsEnabled();
+
+    /** Clear all timers and counters. */
+    static void Reset();
+
+    /** Clear the per-sample timers and counters. */
+    static void ResetSample();
+
+    /**
+     * Open the hardware counters and read them in every timer from now on.
+     *
+     * @return whether the counters could be opened; if not, the reason is
+     *     given by rGetHardwareCounterStatus() and only wall time is recorded
+     */
+    static bool EnableHardwareCounters();
+
+    /** Stop reading and close the hardware counters. */
+    static void DisableHardwareCounters();
+
+    /** @return whether hardware counters are being recorded. */
+    static bool AreHardwareCountersEnabled();
+
+    /** @return a description of the state of the hardware counters. */
+    static const std::string& rGetHardwareCounterStatus();
+
+    /**
+     * Add to the item counter of a phase.
+     *
+     * @param phase the phase
+     * @param numItems the number of items
+     */
+    static void AddItems(Phase phase, unsigned long numItems);
+
+    /**
+     * @param phase the phase
+     * @return the name of the phase as used in the output files
+     */
+    static const char* GetPhaseName(Phase phase);
+
+    /**
+     * Write the column names of the per-sample CSV.
+     *
+     * @param rStream the stream
+     */
+    static void WriteSampleHeader(std::ostream& rStream);
+
+    /**
+     * Write one row of the per-sample CSV: the time, the number of steps and the
+     * wall time of the sample, then the exclusive time and calls of each phase.
+     *
+     * @param rStream the stream
+     * @param time the simulation time
+     * @param numSteps the number of time steps in the sample
+     * @param wallSeconds the wall time of the sample
+     */
+    static void WriteSample(std::ostream& rStream, double time, unsigned numSteps, double wallSeconds);
+
+    /**
+     * Write the column names of the per-sample hardware counter CSV.
+     *
+     * @param rStream the stream
+     */
+    static void WriteCounterSampleHeader(std::ostream& rStream);
+
+    /**
+     * Write one row of the per-sample hardware counter CSV: the time, then the
+     * exclusive counts of each event of each phase.
+     *
+     * @param rStream the stream
+     * @param time the simulation time
+     */
+    static void WriteCounterSample(std::ostream& rStream, double time);
+
+    /**
+     * Write the end-of-run summary table, followed by the hardware counter
+     * table (or the reason it is missing) if counters were requested.
+     *
+     * @param rStream the stream
+     * @param numSteps the number of time steps in the run
+     * @param wallSeconds the wall time of the run
+     */
+    static void WriteSummary(std::ostream& rStream, unsigned numSteps, double wallSeconds);
+};
+
+#ifdef GTPASE_ENABLE_PROFILING
+#define GTPASE_PROFILE_CONCAT_INNER(a, b) a##b
+#define GTPASE_PROFILE_CONCAT(a, b) GTPASE_PROFILE_CONCAT_INNER(a, b)
+/** Time the rest of the enclosing scope as the given GTPaseProfiler::Phase. */
+#define GTPASE_PROFILE_SCOPE(phase) GTPaseProfiler::ScopedTimer GTPASE_PROFILE_CONCAT(gtpase_profile_timer_, __LINE__)(GTPaseProfiler::phase)
+/** Add numItems to the item counter of the given GTPaseProfiler::Phase. */
+#define GTPASE_PROFILE_COUNT(phase, numItems) GTPaseProfiler::AddItems(GTPaseProfiler::phase, numItems)
+#else
+#define GTPASE_PROFILE_SCOPE(phase)
+#define GTPASE_PROFILE_COUNT(phase, numItems)
+#endif
+
+#endif /*GTPASEPROFILER_HPP_*/
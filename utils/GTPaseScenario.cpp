@@ -0,0 +1,304 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "GTPaseScenario.hpp"
+
+#include "SmartPointers.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "ProfiledOffLatticeSimulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "CounterBasedRandomGenerator.hpp"
+#include "CellId.hpp"
+#include "OutputFileHandler.hpp"
+#include "FileFinder.hpp"
+#include "GTPaseCellFactory.hpp"
+
+#include "VolumeTrackingModifier.hpp"
+#include "ODEParameterAreaModifier.hpp"
+#include "OscillationSpectrumModifier.hpp"
+#include "CellStatisticsSummaryModifier.hpp"
+#include "CheckpointModifier.hpp"
+#include "ProfilingModifier.hpp"
+#include "MemoryFootprintModifier.hpp"
+#include "TissueCheckpoint.hpp"
+#include "TopologyWriter.hpp"
+#include "TopologyEventWriter.hpp"
+#include "CsvWriter.hpp"
+#include "PopulationStatisticsWriter.hpp"
+#include "XMLCellWriter.hpp"
+#include "VtuTissueWriter.hpp"
+#include "OneCellGTPaseWriter.hpp"
+
+#include "ODESRNCoupledArea.hpp"
+#include "GTPaseParameterTable.hpp"
+
+#include <sstream>
+
+namespace
+{
+/**
+ * @param rConfig the scenario
+ * @return the settings that define the simulated tissue, one "key = value" per
+ *     line, saved with every checkpoint and checked on restart. The end time
+ *     and the output settings may change between an interrupted run and its
+ *     resumption.
+ */
+std::string DescribeTissue(const ScenarioConfig& rConfig)
+{
+    const char* keys[] = {"num_cells_across", "num_cells_up", "seed", "dt", "beta_spread", "initial_target_area",
+                          "initial_area", "deformation_energy", "membrane_surface_energy", "cell_cell_adhesion",
+                          "cell_boundary_adhesion"};
+    std::ostringstream description;
+    for (unsigned i=0; i<sizeof(keys)/sizeof(keys[0]); i++)
+    {
+        description << keys[i] << " = " << rConfig.GetString(keys[i]) << "\n";
+    }
+    for (unsigned p=0; p<GTPaseParameterTable::NUM_PARAMETERS; p++)
+    {
+        std::string name = GTPaseParameterTable::GetParameterName((GTPaseParameterTable::Parameter)p);
+        description << name << " = " << rConfig.GetString(name) << "\n";
+    }
+    return description.str();
+}
+
+/**
+ * Check that every writer sampling multiple is a multiple of the simulator's
+ * sampling multiple. Writers only run on the steps where the simulator writes
+ * results, so any other multiple would silently be coarsened (e.g. 15 with a
+ * sampling multiple of 10 would write every 30 steps).
+ *
+ * @param rConfig the scenario
+ */
+void CheckWriterMultiples(const ScenarioConfig& rConfig)
+{
+    unsigned sampling_multiple = rConfig.GetUnsigned("sampling_multiple");
+    if (sampling_multiple == 0)
+    {
+        EXCEPTION("sampling_multiple must be positive");
+    }
+    const char* keys[] = {"csv_writer_multiple", "statistics_writer_multiple", "topology_writer_multiple",
+                          "topology_event_writer_multiple", "one_cell_writer_multiple", "xml_writer_multiple",
+                          "vtu_writer_multiple"};
+    for (unsigned i=0; i<sizeof(keys)/sizeof(keys[0]); i++)
+    {
+        unsigned writer_multiple = rConfig.GetUnsigned(keys[i]);
+        if (writer_multiple % sampling_multiple != 0)
+        {
+            std::ostringstream message;
+            message << keys[i] << " = " << writer_multiple << " is not a multiple of sampling_multiple = " << sampling_multiple;
+            EXCEPTION(message.str());
+        }
+    }
+}
+}
+
+void GTPaseScenario::Run(const ScenarioConfig& rConfig)
+{
+    CheckWriterMultiples(rConfig);
+
+    std::string output_directory = rConfig.GetString("output_directory");
+    std::string checkpoint_directory = output_directory + "/checkpoints";
+
+    OutputFileHandler output_file_handler(output_directory + "/", false);
+    out_stream p_scenario_file = output_file_handler.OpenOutputFile("scenario.txt");
+    rConfig.Write(*p_scenario_file);
+    p_scenario_file->close();
+
+    HoneycombVertexMeshGenerator generator(rConfig.GetUnsigned("num_cells_across"), rConfig.GetUnsigned("num_cells_up"));
+    MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+    bool delete_mesh = false;
+
+    std::vector<CellPtr> cells;
+    std::vector<unsigned> location_indices;
+
+    // Per-cell random values are keyed by (seed, cell ID, stream), so they do not depend on the order of construction
+    CounterBasedRandomGenerator random_generator(rConfig.GetUnsigned("seed"));
+    RandomNumberGenerator::Instance()->Reseed(rConfig.GetUnsigned("seed"));
+
+    // Kinetic parameters; a restarted run gets the same per-cell betas as the original run
+    GTPaseParameterTable* p_parameters = GTPaseParameterTable::Instance();
+    p_parameters->Reset();
+    for (unsigned p=0; p<GTPaseParameterTable::NUM_PARAMETERS; p++)
+    {
+        GTPaseParameterTable::Parameter parameter = (GTPaseParameterTable::Parameter)p;
+        p_parameters->SetGlobalValue(parameter, rConfig.GetDouble(GTPaseParameterTable::GetParameterName(parameter)));
+    }
+    double beta_spread = rConfig.GetDouble("beta_spread");
+    if (beta_spread > 0.0)
+    {
+        double beta = rConfig.GetDouble("beta");
+        std::vector<double> beta_draws(p_mesh->GetNumElements());
+        random_generator.FillRanf(0, beta_draws.size(), CounterBasedRandomGenerator::BETA, 0, &beta_draws[0]);
+        for (unsigned cell_id=0; cell_id<beta_draws.size(); cell_id++)
+        {
+            p_parameters->SetCellValue(GTPaseParameterTable::BETA, cell_id, beta + beta_spread*(2.0*beta_draws[cell_id] - 1.0));
+        }
+    }
+
+    // Resume from the last checkpoint of an interrupted run, if there is one, provided it is of the same tissue
+    std::string tissue_description = DescribeTissue(rConfig);
+    std::string checkpoint_path = CheckpointModifier<2>::GetCheckpointPath(checkpoint_directory);
+    FileFinder checkpoint_file(checkpoint_path, RelativeTo::Absolute);
+    boost::shared_ptr<TissueCheckpoint> p_checkpoint;
+    if (checkpoint_file.Exists())
+    {
+        p_checkpoint.reset(new TissueCheckpoint(checkpoint_path));
+        p_checkpoint->CheckScenario(tissue_description);
+        p_checkpoint->RestoreSimulationTime(rConfig.GetDouble("end_time"), rConfig.GetDouble("dt"));
+        p_mesh = p_checkpoint->CreateMesh();
+        delete_mesh = true;
+        p_checkpoint->CreateCells(cells, location_indices);
+    }
+    else
+    {
+        // Random initial GTPase concentration, initial target area and initial cell area; cell i gets ID i
+        unsigned num_cells = p_mesh->GetNumElements();
+        std::vector<double> initial_g(num_cells);
+        random_generator.FillRanf(0, num_cells, CounterBasedRandomGenerator::INITIAL_G, 0, &initial_g[0]);
+        std::vector<double> initial_target_area(num_cells, rConfig.GetDouble("initial_target_area"));
+        std::vector<double> initial_area(num_cells, rConfig.GetDouble("initial_area"));
+
+        CellId::ResetMaxCellId();
+        GTPaseCellFactory cell_factory;
+        cell_factory.GenerateCells(cells, initial_g, initial_target_area, initial_area);
+
+        out_stream p_setup_file = output_file_handler.OpenOutputFile("setup_time.txt");
+        cell_factory.WriteSetupTime(*p_setup_file);
+        p_setup_file->close();
+    }
+
+    VertexBasedCellPopulation<2> cell_population(*p_mesh, cells, delete_mesh, true, location_indices);
+    if (p_checkpoint)
+    {
+        p_checkpoint->RestoreCellStates(cell_population);
+    }
+
+    // Writers; a sampling multiple of 0 switches a writer off. Writers that depend on earlier samples are checkpointed.
+    cell_population.SetOutputResultsForChasteVisualizer(false);
+    MAKE_PTR(MemoryFootprintModifier<2>, p_memory_modifier);
+    MAKE_PTR(CheckpointModifier<2>, p_checkpoint_modifier);
+    p_checkpoint_modifier->SetScenario(tissue_description);
+    if (rConfig.GetUnsigned("csv_writer_multiple") > 0)
+    {
+        boost::shared_ptr<CsvWriter<2,2> > p_writer(new CsvWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("csv_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("csv_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("statistics_writer_multiple") > 0)
+    {
+        boost::shared_ptr<PopulationStatisticsWriter<2,2> > p_writer(new PopulationStatisticsWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("statistics_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("population_statistics_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("topology_writer_multiple") > 0)
+    {
+        boost::shared_ptr<TopologyWriter<2,2> > p_writer(new TopologyWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("topology_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("topology_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("topology_event_writer_multiple") > 0)
+    {
+        boost::shared_ptr<TopologyEventWriter<2,2> > p_writer(new TopologyEventWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("topology_event_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("topology_event_writer", p_writer);
+        p_checkpoint_modifier->AddCheckpointable("topology_event_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("one_cell_writer_multiple") > 0)
+    {
+        boost::shared_ptr<OneCellGTPaseWriter<2,2> > p_writer(new OneCellGTPaseWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("one_cell_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("one_cell_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("xml_writer_multiple") > 0)
+    {
+        boost::shared_ptr<XMLCellWriter<2,2> > p_writer(new XMLCellWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("xml_writer_multiple"));
+        p_writer->SetOutputNeighbourIds(rConfig.GetBool("xml_neighbour_ids"));
+        p_writer->SetDeltaEncoding(rConfig.GetUnsigned("xml_keyframe_interval"));
+        cell_population.AddCellWriter(p_writer);
+        p_memory_modifier->AddCellWriter("xml_cell_writer", p_writer);
+        p_checkpoint_modifier->AddCheckpointable("xml_cell_writer", p_writer);
+    }
+    if (rConfig.GetUnsigned("vtu_writer_multiple") > 0)
+    {
+        boost::shared_ptr<VtuTissueWriter<2,2> > p_writer(new VtuTissueWriter<2,2>());
+        p_writer->SetSamplingTimestepMultiple(rConfig.GetUnsigned("vtu_writer_multiple"));
+        cell_population.AddPopulationWriter(p_writer);
+        p_memory_modifier->AddPopulationWriter("vtu_writer", p_writer);
+        p_checkpoint_modifier->AddCheckpointable("vtu_writer", p_writer);
+    }
+
+    ProfiledOffLatticeSimulation<2> simulator(cell_population);
+    simulator.SetOutputDirectory(output_directory);
+    simulator.SetSamplingTimestepMultiple(rConfig.GetUnsigned("sampling_multiple"));
+    simulator.SetDt(rConfig.GetDouble("dt"));
+    simulator.SetEndTime(rConfig.GetDouble("end_time"));
+
+    MAKE_PTR(VolumeTrackingModifier<2>, p_volume_modifier);
+    simulator.AddSimulationModifier(p_volume_modifier);
+
+    // Couples cell target area to GTPase concentration
+    MAKE_PTR(ODEParameterAreaModifier<2>, p_ODE_modifier);
+    simulator.AddSimulationModifier(p_ODE_modifier);
+
+    if (rConfig.GetUnsigned("spectrum_multiple") > 0)
+    {
+        MAKE_PTR(OscillationSpectrumModifier<2>, p_spectrum_modifier);
+        p_spectrum_modifier->SetSamplingTimestepMultiple(rConfig.GetUnsigned("spectrum_multiple"));
+        p_spectrum_modifier->SetFrequencyBand(rConfig.GetDouble("spectrum_min_frequency"),
+                                              rConfig.GetDouble("spectrum_max_frequency"),
+                                              rConfig.GetUnsigned("spectrum_num_frequencies"));
+        simulator.AddSimulationModifier(p_spectrum_modifier);
+        p_checkpoint_modifier->AddCheckpointable("spectrum_modifier", p_spectrum_modifier);
+    }
+
+    MAKE_PTR(CellStatisticsSummaryModifier<2>, p_statistics_modifier);
+    p_statistics_modifier->SetSummaryInterval(rConfig.GetUnsigned("summary_interval"));
+    simulator.AddSimulationModifier(p_statistics_modifier);
+
+    // Added after the stateful modifiers, since a resumed run restores their state in its SetupSolve()
+    if (rConfig.GetUnsigned("checkpoint_interval") > 0 || p_checkpoint)
+    {
+        p_checkpoint_modifier->SetCheckpointInterval(rConfig.GetUnsigned("checkpoint_interval"));
+        p_checkpoint_modifier->SetCheckpointDirectory(checkpoint_directory);
+        p_checkpoint_modifier->SetRemoveCheckpointAtEnd(!rConfig.GetBool("keep_checkpoint"));
+        if (p_checkpoint)
+        {
+            p_checkpoint_modifier->SetResumeCheckpoint(p_checkpoint);
+        }
+        simulator.AddSimulationModifier(p_checkpoint_modifier);
+    }
+
+    // Reports at the start and, after the checkpoint modifier, at each checkpoint
+    if (rConfig.GetBool("memory_report"))
+    {
+        p_memory_modifier->SetReportInterval(rConfig.GetUnsigned("checkpoint_interval"));
+        simulator.AddSimulationModifier(p_memory_modifier);
+    }
+
+#ifdef GTPASE_ENABLE_PROFILING
+    // Added last so that its step wall time includes the other modifiers
+    MAKE_PTR(ProfilingModifier<2>, p_profiling_modifier);
+    p_profiling_modifier->SetSamplingTimestepMultiple(rConfig.GetUnsigned("sampling_multiple"));
+    p_profiling_modifier->SetHardwareCounters(rConfig.GetBool("hardware_counters"));
+    simulator.AddSimulationModifier(p_profiling_modifier);
+#endif
+
+    MAKE_PTR(NagaiHondaForce<2>, p_force);
+    p_force->SetNagaiHondaDeformationEnergyParameter(rConfig.GetDouble("deformation_energy"));
+    p_force->SetNagaiHondaMembraneSurfaceEnergyParameter(rConfig.GetDouble("membrane_surface_energy"));
+    p_force->SetNagaiHondaCellBoundaryAdhesionEnergyParameter(rConfig.GetDouble("cell_boundary_adhesion"));
+    p_force->SetNagaiHondaCellCellAdhesionEnergyParameter(rConfig.GetDouble("cell_cell_adhesion"));
+    simulator.AddForce(p_force);
+
+    simulator.Solve();
+}
@@ -0,0 +1,42 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef GTPASESCENARIO_HPP_
+#define GTPASESCENARIO_HPP_
+
+#include "ScenarioConfig.hpp"
+
+/**
+ * Builds and runs the coupled GTPase vertex simulation described by a
+ * ScenarioConfig: honeycomb mesh, non-dividing cells (NoCellCycleModel) with
+ * ODESrnModel, Nagai-Honda force, modifiers and writers.
+ *
+ * With the default ScenarioConfig this is the original
+ * multiCellsNoDivisionCoupledArea simulation. If a checkpoint from an
+ * interrupted run of the same scenario exists, the run resumes from it and
+ * writes, from the checkpoint time on, exactly what the uninterrupted run
+ * would have written (into results_from_time_[checkpoint time]). With
+ * keep_checkpoint a completed run can be extended to a later end time. A
+ * checkpoint written with a different mesh size, seed, time step, force or
+ * kinetic parameter is an error rather than resumed; the end time and the
+ * output settings may differ.
+ *
+ * SimulationTime must have been started (as AbstractCellBasedTestSuite does)
+ * before calling Run().
+ */
+class GTPaseScenario
+{
+public:
+
+    /**
+     * Build and run a scenario. The resolved scenario is written to
+     * scenario.txt in the output directory.
+     *
+     * @param rConfig the scenario
+     */
+    static void Run(const ScenarioConfig& rConfig);
+};
+
+#endif /*GTPASESCENARIO_HPP_*/
@@ -0,0 +1,143 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "GoertzelBank.hpp"
+#include "CheckpointStream.hpp"
+#include <cassert>
+#include <cmath>
+
+GoertzelBank::GoertzelBank(const std::vector<double>& rFrequencies, double sampleSpacing, unsigned blockLength)
+    : mFrequencies(rFrequencies),
+      mBlockLength(blockLength),
+      mNumSamples(0),
+      mSum(0.0),
+      mDominantFrequency(0.0),
+      mDominantAmplitude(0.0),
+      mBlockMean(0.0)
+{
+    assert(blockLength > 0);
+    assert(sampleSpacing > 0.0);
+
+    unsigned num_bins = mFrequencies.size();
+    mCoefficients.resize(num_bins);
+    mCosines.resize(num_bins);
+    mSines.resize(num_bins);
+    mDcResponseReal.assign(num_bins, 0.0);
+    mDcResponseImag.assign(num_bins, 0.0);
+    mState1.assign(num_bins, 0.0);
+    mState2.assign(num_bins, 0.0);
+
+    for (unsigned bin=0; bin<num_bins; bin++)
+    {
+        double omega = 2.0*M_PI*mFrequencies[bin]*sampleSpacing;
+        mCosines[bin] = cos(omega);
+        mSines[bin] = sin(omega);
+        mCoefficients[bin] = 2.0*mCosines[bin];
+
+        /*
+         * At the end of a block the Goertzel output is sum_n x[n] exp(i*omega*(N-1-n)),
+         * so a constant signal c contributes c * sum_m exp(i*omega*m). We store this sum
+         * so that the block mean can be subtracted exactly in FinishBlock().
+         */
+        for (unsigned m=0; m<mBlockLength; m++)
+        {
+            mDcResponseReal[bin] += cos(omega*m);
+            mDcResponseImag[bin] += sin(omega*m);
+        }
+    }
+}
+
+bool GoertzelBank::AddSample(double sample)
+{
+    unsigned num_bins = mFrequencies.size();
+    for (unsigned bin=0; bin<num_bins; bin++)
+    {
+        double s = sample + mCoefficients[bin]*mState1[bin] - mState2[bin];
+        mState2[bin] = mState1[bin];
+        mState1[bin] = s;
+    }
+    mSum += sample;
+    mNumSamples++;
+
+    if (mNumSamples == mBlockLength)
+    {
+        FinishBlock();
+        return true;
+    }
+    return false;
+}
+
+void GoertzelBank::FinishBlock()
+{
+    mBlockMean = mSum/mBlockLength;
+
+    double max_magnitude = -1.0;
+    unsigned num_bins = mFrequencies.size();
+    for (unsigned bin=0; bin<num_bins; bin++)
+    {
+        // y = s[N-1] - exp(-i*omega) s[N-2], minus the response to the block mean
+        double real = mState1[bin] - mCosines[bin]*mState2[bin] - mBlockMean*mDcResponseReal[bin];
+        double imag = mSines[bin]*mState2[bin] - mBlockMean*mDcResponseImag[bin];
+        double magnitude = sqrt(real*real + imag*imag);
+
+        if (magnitude > max_magnitude)
+        {
+            max_magnitude = magnitude;
+            mDominantFrequency = mFrequencies[bin];
+        }
+    }
+
+    // A sinusoid of amplitude a gives a peak of magnitude a*N/2
+    mDominantAmplitude = num_bins > 0 ? 2.0*max_magnitude/mBlockLength : 0.0;
+
+    mState1.assign(num_bins, 0.0);
+    mState2.assign(num_bins, 0.0);
+    mSum = 0.0;
+    mNumSamples = 0;
+}
+
+double GoertzelBank::GetDominantFrequency() const
+{
+    return mDominantFrequency;
+}
+
+double GoertzelBank::GetDominantAmplitude() const
+{
+    return mDominantAmplitude;
+}
+
+double GoertzelBank::GetBlockMean() const
+{
+    return mBlockMean;
+}
+
+void GoertzelBank::SaveState(std::ostream& rStream) const
+{
+    CheckpointStream::WriteArray(rStream, mState1);
+    CheckpointStream::WriteArray(rStream, mState2);
+    CheckpointStream::WriteValue(rStream, (boost::uint32_t)mNumSamples);
+    CheckpointStream::WriteValue(rStream, mSum);
+    CheckpointStream::WriteValue(rStream, mDominantFrequency);
+    CheckpointStream::WriteValue(rStream, mDominantAmplitude);
+    CheckpointStream::WriteValue(rStream, mBlockMean);
+}
+
+void GoertzelBank::LoadState(std::istream& rStream)
+{
+    unsigned num_bins = mFrequencies.size();
+    CheckpointStream::ReadArray(rStream, mState1);
+    CheckpointStream::ReadArray(rStream, mState2);
+    if (mState1.size() != num_bins || mState2.size() != num_bins)
+    {
+        EXCEPTION("The checkpointed filter bank has a different number of frequencies");
+    }
+    boost::uint32_t num_samples;
+    CheckpointStream::ReadValue(rStream, num_samples);
+    mNumSamples = num_samples;
+    CheckpointStream::ReadValue(rStream, mSum);
+    CheckpointStream::ReadValue(rStream, mDominantFrequency);
+    CheckpointStream::ReadValue(rStream, mDominantAmplitude);
+    CheckpointStream::ReadValue(rStream, mBlockMean);
+}
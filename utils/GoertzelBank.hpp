@@ -0,0 +1,118 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef GOERTZELBANK_HPP_
+#define GOERTZELBANK_HPP_
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/**
+ * A bank of Goertzel filters evaluating the discrete Fourier transform of a
+ * sampled signal at a fixed set of frequencies, one sample at a time.
+ *
+ * Samples are processed in blocks of a fixed length. At the end of each block
+ * the mean of the block is removed analytically from every bin (so the DC
+ * component does not leak into low frequency bins) and the bin with the
+ * largest magnitude is reported as the dominant frequency.
+ */
+class GoertzelBank
+{
+private:
+
+    /** The frequencies (in inverse time units) evaluated by the bank. */
+    std::vector<double> mFrequencies;
+
+    /** 2*cos(omega) for each bin, where omega is the angular frequency per sample. */
+    std::vector<double> mCoefficients;
+
+    /** cos(omega) for each bin. */
+    std::vector<double> mCosines;
+
+    /** sin(omega) for each bin. */
+    std::vector<double> mSines;
+
+    /** Real part of the response of each bin to a unit constant signal over one block. */
+    std::vector<double> mDcResponseReal;
+
+    /** Imaginary part of the response of each bin to a unit constant signal over one block. */
+    std::vector<double> mDcResponseImag;
+
+    /** The Goertzel state s[n-1] of each bin. */
+    std::vector<double> mState1;
+
+    /** The Goertzel state s[n-2] of each bin. */
+    std::vector<double> mState2;
+
+    /** The number of samples in one block. */
+    unsigned mBlockLength;
+
+    /** The number of samples processed in the current block. */
+    unsigned mNumSamples;
+
+    /** Running sum of the samples in the current block. */
+    double mSum;
+
+    /** The dominant frequency of the last completed block. */
+    double mDominantFrequency;
+
+    /** The amplitude at the dominant frequency of the last completed block. */
+    double mDominantAmplitude;
+
+    /** The mean of the last completed block. */
+    double mBlockMean;
+
+    /** Finish the current block, compute the spectrum peak and reset the filter states. */
+    void FinishBlock();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rFrequencies the frequencies (in inverse time units) to evaluate
+     * @param sampleSpacing the time between consecutive samples
+     * @param blockLength the number of samples in each block
+     */
+    GoertzelBank(const std::vector<double>& rFrequencies, double sampleSpacing, unsigned blockLength);
+
+    /**
+     * Process one sample.
+     *
+     * @param sample the value of the signal
+     * @return whether this sample completed a block, in which case the
+     *     Get methods below return the results for that block
+     */
+    bool AddSample(double sample);
+
+    /** @return the dominant frequency of the last completed block. */
+    double GetDominantFrequency() const;
+
+    /** @return the amplitude of the oscillation at the dominant frequency of the last completed block. */
+    double GetDominantAmplitude() const;
+
+    /** @return the mean of the last completed block. */
+    double GetBlockMean() const;
+
+    /**
+     * Write the state of the current block and the results of the last
+     * completed block, see CheckpointStream. The frequencies and block length
+     * are not written; they are set by the constructor.
+     *
+     * @param rStream the stream
+     */
+    void SaveState(std::ostream& rStream) const;
+
+    /**
+     * Read the state written by SaveState() into a bank constructed with the
+     * same frequencies, sample spacing and block length.
+     *
+     * @param rStream the stream
+     */
+    void LoadState(std::istream& rStream);
+};
+
+#endif /*GOERTZELBANK_HPP_*/
@@ -0,0 +1,199 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "HardwareCounters.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+/** Names of the events, indexed by HardwareCounters::Event. */
+const char* EVENT_NAMES[HardwareCounters::NUM_EVENTS] =
+{
+    "cycles",
+    "instructions",
+    "cache_misses",
+    "branch_misses"
+};
+
+#ifdef __linux__
+/** The perf hardware event of each HardwareCounters::Event. */
+const unsigned long long EVENT_CONFIGS[HardwareCounters::NUM_EVENTS] =
+{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+/**
+ * Open one event of the calling thread.
+ *
+ * @param config the perf hardware event
+ * @param groupFd the group leader, or -1 to open a new group
+ * @return the file descriptor, or -1 with errno set
+ */
+int OpenEvent(unsigned long long config, int groupFd)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (groupFd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+}
+
+HardwareCounters::HardwareCounters()
+    : mGroupFd(-1),
+      mNumOpen(0),
+      mStatus("closed")
+{
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        mFds[e] = -1;
+        mReadIndices[e] = -1;
+    }
+}
+
+HardwareCounters::~HardwareCounters()
+{
+    Close();
+}
+
+bool HardwareCounters::Open()
+{
+    Close();
+
+#ifdef __linux__
+    // The first event that opens leads the group, so a missing cycles counter does not lose the others
+    std::string unavailable;
+    int first_errno = 0;
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        int fd = OpenEvent(EVENT_CONFIGS[e], mGroupFd);
+        if (fd == -1)
+        {
+            if (first_errno == 0)
+            {
+                first_errno = errno;
+            }
+            unavailable += std::string(unavailable.empty() ? "" : ", ") + EVENT_NAMES[e];
+            continue;
+        }
+        if (mGroupFd == -1)
+        {
+            mGroupFd = fd;
+        }
+        mFds[e] = fd;
+        mReadIndices[e] = mNumOpen++;
+    }
+
+    if (mGroupFd == -1)
+    {
+        mStatus = std::string("perf_event_open failed: ") + strerror(first_errno);
+        if (first_errno == EACCES || first_errno == EPERM)
+        {
+            mStatus += " (see /proc/sys/kernel/perf_event_paranoid)";
+        }
+        return false;
+    }
+
+    ioctl(mGroupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(mGroupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    mStatus = unavailable.empty() ? "all events available" : "unavailable: " + unavailable;
+    return true;
+#else
+    mStatus = "hardware counters are only supported on Linux";
+    return false;
+#endif
+}
+
+void HardwareCounters::Close()
+{
+#ifdef __linux__
+    if (mGroupFd != -1)
+    {
+        ioctl(mGroupFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        if (mFds[e] != -1)
+        {
+            close(mFds[e]);
+        }
+    }
+#endif
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        mFds[e] = -1;
+        mReadIndices[e] = -1;
+    }
+    mGroupFd = -1;
+    mNumOpen = 0;
+    mStatus = "closed";
+}
+
+bool HardwareCounters::IsOpen() const
+{
+    return mGroupFd != -1;
+}
+
+bool HardwareCounters::IsAvailable(Event event) const
+{
+    return mReadIndices[event] != -1;
+}
+
+const std::string& HardwareCounters::rGetStatus() const
+{
+    return mStatus;
+}
+
+void HardwareCounters::Read(unsigned long long* pValues) const
+{
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        pValues[e] = 0;
+    }
+#ifdef __linux__
+    if (mGroupFd == -1)
+    {
+        return;
+    }
+
+    // PERF_FORMAT_GROUP layout: the number of events, then one value per event in opening order
+    unsigned long long buffer[1 + NUM_EVENTS];
+    ssize_t bytes_read = read(mGroupFd, buffer, sizeof(buffer));
+    if (bytes_read < (ssize_t)((1 + mNumOpen)*sizeof(unsigned long long)))
+    {
+        return;
+    }
+    for (unsigned e=0; e<NUM_EVENTS; e++)
+    {
+        if (mReadIndices[e] != -1)
+        {
+            pValues[e] = buffer[1 + mReadIndices[e]];
+        }
+    }
+#endif
+}
+
+const char* HardwareCounters::GetEventName(Event event)
+{
+    return EVENT_NAMES[event];
+}
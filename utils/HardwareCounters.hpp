@@ -0,0 +1,101 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef HARDWARECOUNTERS_HPP_
+#define HARDWARECOUNTERS_HPP_
+
+#include <string>
+
+/**
+ * A group of hardware performance counters of the calling thread, opened
+ * with perf_event_open: cycles, instructions, cache misses and branch
+ * misses, counted in user space only.
+ *
+ * Opening fails gracefully: if the kernel disallows perf events (e.g.
+ * perf_event_paranoid, seccomp, no PMU in a VM) or the platform is not
+ * Linux, Open() returns false and rGetStatus() says why. Events that are not
+ * supported on their own are left out and read as 0.
+ */
+class HardwareCounters
+{
+public:
+
+    /** The counted events, used to index the values. */
+    enum Event
+    {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        CACHE_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS
+    };
+
+private:
+
+    /** File descriptor of the group leader, or -1 if closed. */
+    int mGroupFd;
+
+    /** File descriptor of each event, or -1 if unavailable. */
+    int mFds[NUM_EVENTS];
+
+    /** Position of each event in a group read, or -1 if unavailable. */
+    int mReadIndices[NUM_EVENTS];
+
+    /** Number of events in the group. */
+    unsigned mNumOpen;
+
+    /** Description of the state of the counters, or of why they could not be opened. */
+    std::string mStatus;
+
+    /** Not copyable. */
+    HardwareCounters(const HardwareCounters&);
+    /** Not assignable. */
+    HardwareCounters& operator=(const HardwareCounters&);
+
+public:
+
+    /** Constructor; the counters are closed until Open() is called. */
+    HardwareCounters();
+
+    /** Destructor; closes the counters. */
+    ~HardwareCounters();
+
+    /**
+     * Open and start the counters.
+     *
+     * @return whether at least one event could be opened
+     */
+    bool Open();
+
+    /** Stop and close the counters. */
+    void Close();
+
+    /** @return whether the counters are open. */
+    bool IsOpen() const;
+
+    /**
+     * @param event the event
+     * @return whether the event is being counted
+     */
+    bool IsAvailable(Event event) const;
+
+    /** @return a description of the state of the counters. */
+    const std::string& rGetStatus() const;
+
+    /**
+     * Read the current counts. Unavailable events read as 0.
+     *
+     * @param pValues array of NUM_EVENTS values to fill in
+     */
+    void Read(unsigned long long* pValues) const;
+
+    /**
+     * @param event the event
+     * @return the name of the event as used in the output files
+     */
+    static const char* GetEventName(Event event);
+};
+
+#endif /*HARDWARECOUNTERS_HPP_*/
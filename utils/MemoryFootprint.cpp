@@ -0,0 +1,283 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "MemoryFootprint.hpp"
+
+#include <cstdio>
+#include <iomanip>
+#include <list>
+#include <map>
+#include <set>
+#include <unistd.h>
+
+#include "VertexBasedCellPopulation.hpp"
+#include "NoCellCycleModel.hpp"
+#include "ContactInhibitionCellCycleModel.hpp"
+#include "CellData.hpp"
+#include "ODESrnModel.hpp"
+#include "ODESRN.hpp"
+#include "FixedSizePool.hpp"
+
+namespace
+{
+/** Names of the components, indexed by MemoryFootprint::Component. */
+const char* COMPONENT_NAMES[MemoryFootprint::NUM_COMPONENTS] =
+{
+    "cell",
+    "cell_cycle_model",
+    "srn_model",
+    "ode_system",
+    "cell_data",
+    "population_maps",
+    "vertex_element",
+    "mesh_node",
+    "writer_buffers"
+};
+
+/** Size of the links (colour, parent, left, right) of a red-black tree node. */
+const unsigned long TREE_NODE_LINK_BYTES = 4*sizeof(void*);
+
+/** Size of a boost::shared_ptr control block (vtable, use and weak counts, pointer). */
+const unsigned long SHARED_COUNT_BYTES = 3*sizeof(void*);
+}
+
+MemoryFootprint::MemoryFootprint()
+    : mNumCells(0),
+      mNumNodes(0),
+      mNumElements(0)
+{
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        mBytes[c] = 0;
+    }
+}
+
+unsigned long MemoryFootprint::HeapBlockBytes(unsigned long requestedBytes)
+{
+    if (requestedBytes == 0)
+    {
+        return 0;
+    }
+    unsigned long block_bytes = (requestedBytes + 8 + 15) & ~15ul;
+    return block_bytes < 32 ? 32 : block_bytes;
+}
+
+unsigned long MemoryFootprint::PoolBlockBytes(unsigned long objectBytes)
+{
+    FixedSizePool pool(objectBytes);
+    return pool.GetBlockBytes();
+}
+
+unsigned long MemoryFootprint::TreeNodeBytes(unsigned long valueBytes)
+{
+    return HeapBlockBytes(TREE_NODE_LINK_BYTES + valueBytes);
+}
+
+unsigned long MemoryFootprint::VectorBytes(unsigned long capacity, unsigned long elementBytes)
+{
+    return HeapBlockBytes(capacity*elementBytes);
+}
+
+unsigned long MemoryFootprint::StringBytes(const std::string& rString)
+{
+    // Short strings are stored in the string object itself
+    return rString.capacity() > 15 ? HeapBlockBytes(rString.capacity() + 1) : 0;
+}
+
+void MemoryFootprint::Measure(VertexBasedCellPopulation<2>& rCellPopulation)
+{
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        mBytes[c] = 0;
+    }
+    mWriterBytes.clear();
+    mNumCells = 0;
+
+    for (AbstractCellPopulation<2>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        CellPtr p_cell = *cell_iter;
+        mNumCells++;
+
+        // The cell, its shared_ptr control block and its property set; shared properties are not counted
+        mBytes[CELL] += HeapBlockBytes(sizeof(Cell)) + HeapBlockBytes(SHARED_COUNT_BYTES)
+                        + p_cell->rGetCellPropertyCollection().GetSize()*TreeNodeBytes(sizeof(boost::shared_ptr<AbstractCellProperty>));
+
+        AbstractCellCycleModel* p_cycle_model = p_cell->GetCellCycleModel();
+        if (dynamic_cast<NoCellCycleModel*>(p_cycle_model) != NULL)
+        {
+            mBytes[CELL_CYCLE_MODEL] += HeapBlockBytes(sizeof(NoCellCycleModel));
+        }
+        else if (dynamic_cast<ContactInhibitionCellCycleModel*>(p_cycle_model) != NULL)
+        {
+            mBytes[CELL_CYCLE_MODEL] += HeapBlockBytes(sizeof(ContactInhibitionCellCycleModel));
+        }
+        else
+        {
+            mBytes[CELL_CYCLE_MODEL] += HeapBlockBytes(sizeof(AbstractCellCycleModel));
+        }
+
+        ODESrnModel* p_srn_model = dynamic_cast<ODESrnModel*>(p_cell->GetSrnModel());
+        if (p_srn_model != NULL)
+        {
+            AbstractOdeSystem* p_ode_system = p_srn_model->GetOdeSystem();
+            unsigned long state_capacity = p_ode_system->rGetStateVariables().capacity();
+
+            // The initial conditions are not accessible; they have as many entries as the state
+            mBytes[SRN_MODEL] += PoolBlockBytes(sizeof(ODESrnModel)) + VectorBytes(state_capacity, sizeof(double));
+            mBytes[ODE_SYSTEM] += (dynamic_cast<ODESRN*>(p_ode_system) != NULL ? PoolBlockBytes(sizeof(ODESRN)) : HeapBlockBytes(sizeof(AbstractOdeSystem)))
+                                  + VectorBytes(state_capacity, sizeof(double))
+                                  + VectorBytes(p_ode_system->GetNumberOfParameters(), sizeof(double));
+        }
+        else
+        {
+            mBytes[SRN_MODEL] += HeapBlockBytes(sizeof(AbstractSrnModel));
+        }
+
+        boost::shared_ptr<CellData> p_cell_data = p_cell->GetCellData();
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        mBytes[CELL_DATA] += HeapBlockBytes(sizeof(CellData)) + HeapBlockBytes(SHARED_COUNT_BYTES);
+        for (unsigned k=0; k<keys.size(); k++)
+        {
+            mBytes[CELL_DATA] += TreeNodeBytes(sizeof(std::pair<const std::string, double>)) + StringBytes(keys[k]);
+        }
+
+        // The cell list, the cell to location map and the location to cells map with its set
+        mBytes[POPULATION_MAPS] += HeapBlockBytes(2*sizeof(void*) + sizeof(CellPtr))
+                                   + TreeNodeBytes(sizeof(std::pair<Cell* const, unsigned>))
+                                   + TreeNodeBytes(sizeof(std::pair<const unsigned, std::set<CellPtr> >))
+                                   + TreeNodeBytes(sizeof(CellPtr));
+    }
+
+    // Deleted nodes and elements stay allocated until the mesh is remeshed
+    MutableVertexMesh<2,2>& r_mesh = rCellPopulation.rGetMesh();
+    mNumElements = r_mesh.GetNumAllElements();
+    for (unsigned elem_index=0; elem_index<mNumElements; elem_index++)
+    {
+        VertexElement<2,2>* p_element = r_mesh.GetElement(elem_index);
+        mBytes[VERTEX_ELEMENT] += sizeof(VertexElement<2,2>*) + HeapBlockBytes(sizeof(VertexElement<2,2>))
+                                  + VectorBytes(p_element->GetNumNodes(), sizeof(Node<2>*));
+    }
+
+    mNumNodes = r_mesh.GetNumAllNodes();
+    for (unsigned node_index=0; node_index<mNumNodes; node_index++)
+    {
+        Node<2>* p_node = r_mesh.GetNode(node_index);
+        mBytes[MESH_NODE] += sizeof(Node<2>*) + HeapBlockBytes(sizeof(Node<2>))
+                             + p_node->GetNumContainingElements()*TreeNodeBytes(sizeof(unsigned));
+    }
+}
+
+void MemoryFootprint::AddWriterBuffer(const std::string& rName, unsigned long numBytes)
+{
+    mWriterBytes.push_back(std::make_pair(rName, numBytes));
+    mBytes[WRITER_BUFFERS] += numBytes;
+}
+
+unsigned long MemoryFootprint::GetBytes(Component component) const
+{
+    return mBytes[component];
+}
+
+unsigned long MemoryFootprint::GetTotalBytes() const
+{
+    unsigned long total_bytes = 0;
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        total_bytes += mBytes[c];
+    }
+    return total_bytes;
+}
+
+unsigned MemoryFootprint::GetNumCells() const
+{
+    return mNumCells;
+}
+
+const char* MemoryFootprint::GetComponentName(Component component)
+{
+    return COMPONENT_NAMES[component];
+}
+
+unsigned long MemoryFootprint::GetResidentKb()
+{
+    unsigned long resident_pages = 0;
+    FILE* p_file = std::fopen("/proc/self/statm", "r");
+    if (p_file != NULL)
+    {
+        unsigned long total_pages;
+        if (std::fscanf(p_file, "%lu %lu", &total_pages, &resident_pages) != 2)
+        {
+            resident_pages = 0;
+        }
+        std::fclose(p_file);
+    }
+    return resident_pages*(sysconf(_SC_PAGESIZE)/1024);
+}
+
+void MemoryFootprint::WriteHeader(std::ostream& rStream)
+{
+    rStream << "# TimeStamp,Num_Cells,Num_Nodes,Num_Elements";
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        rStream << "," << COMPONENT_NAMES[c] << "_bytes";
+    }
+    rStream << ",total_bytes,bytes_per_cell,resident_kb\n";
+}
+
+void MemoryFootprint::WriteRow(std::ostream& rStream, double time) const
+{
+    unsigned long total_bytes = GetTotalBytes();
+    rStream << time << "," << mNumCells << "," << mNumNodes << "," << mNumElements;
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        rStream << "," << mBytes[c];
+    }
+    rStream << "," << total_bytes << "," << (mNumCells > 0 ? (double)total_bytes/mNumCells : 0.0)
+            << "," << GetResidentKb() << "\n";
+}
+
+void MemoryFootprint::WriteSummary(std::ostream& rStream, double time) const
+{
+    unsigned long total_bytes = GetTotalBytes();
+    double num_cells = mNumCells > 0 ? (double)mNumCells : 1.0;
+
+    std::ios::fmtflags flags = rStream.flags();
+    rStream << std::fixed;
+    rStream << "Memory footprint at t=" << std::setprecision(3) << time << ": " << mNumCells << " cells, "
+            << mNumNodes << " nodes, " << mNumElements << " elements\n\n";
+
+    rStream << std::left << std::setw(30) << "component" << std::right
+            << std::setw(16) << "bytes"
+            << std::setw(16) << "bytes_per_cell"
+            << std::setw(10) << "%" << "\n";
+    for (unsigned c=0; c<NUM_COMPONENTS; c++)
+    {
+        rStream << std::left << std::setw(30) << COMPONENT_NAMES[c] << std::right
+                << std::setw(16) << mBytes[c]
+                << std::setw(16) << std::setprecision(1) << mBytes[c]/num_cells
+                << std::setw(10) << (total_bytes > 0 ? 100.0*mBytes[c]/total_bytes : 0.0) << "\n";
+    }
+    for (unsigned w=0; w<mWriterBytes.size(); w++)
+    {
+        rStream << std::left << std::setw(30) << ("  " + mWriterBytes[w].first) << std::right
+                << std::setw(16) << mWriterBytes[w].second
+                << std::setw(16) << mWriterBytes[w].second/num_cells << "\n";
+    }
+    rStream << std::left << std::setw(30) << "total" << std::right
+            << std::setw(16) << total_bytes
+            << std::setw(16) << total_bytes/num_cells << "\n";
+
+    unsigned long resident_kb = GetResidentKb();
+    if (resident_kb > 0)
+    {
+        rStream << std::left << std::setw(30) << "resident_set" << std::right
+                << std::setw(16) << 1024*resident_kb
+                << std::setw(16) << 1024*resident_kb/num_cells << "\n";
+    }
+    rStream << "\n";
+    rStream.flags(flags);
+}
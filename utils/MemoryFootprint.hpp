@@ -0,0 +1,171 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef MEMORYFOOTPRINT_HPP_
+#define MEMORYFOOTPRINT_HPP_
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<unsigned DIM> class VertexBasedCellPopulation;
+
+/**
+ * Explicit accounting of the heap memory held by a 2D vertex population,
+ * broken down by the objects each cell drags along.
+ *
+ * Measure() walks the population and adds, for every object, the size of its
+ * class and the heap blocks owned by its containers (vectors, maps, sets,
+ * long strings). Block sizes are those of 64-bit glibc malloc: the request
+ * plus an 8-byte header, rounded up to 16 bytes, at least 32 bytes; tree
+ * nodes of std::map and std::set carry 32 bytes of links. SRN models and
+ * ODE systems come from FixedSizePools and carry no header. Objects shared by
+ * all cells (mutation states, proliferative types, the ODE solver, the
+ * parameter table) are not counted. Writer state is added by the caller with
+ * AddWriterBuffer(), see the GetBufferedBytes() methods of the sampled
+ * writers.
+ *
+ * The total can be compared with the resident set size of the process to see
+ * how much memory is not accounted for (Chaste singletons, the mesh
+ * generator, Boost and PETSc).
+ */
+class MemoryFootprint
+{
+public:
+
+    /** The accounted components. */
+    enum Component
+    {
+        CELL = 0,
+        CELL_CYCLE_MODEL,
+        SRN_MODEL,
+        ODE_SYSTEM,
+        CELL_DATA,
+        POPULATION_MAPS,
+        VERTEX_ELEMENT,
+        MESH_NODE,
+        WRITER_BUFFERS,
+        NUM_COMPONENTS
+    };
+
+private:
+
+    /** Bytes of each component. */
+    unsigned long mBytes[NUM_COMPONENTS];
+
+    /** Number of cells. */
+    unsigned mNumCells;
+
+    /** Number of mesh nodes. */
+    unsigned mNumNodes;
+
+    /** Number of mesh elements. */
+    unsigned mNumElements;
+
+    /** Name and bytes of each writer added with AddWriterBuffer(). */
+    std::vector<std::pair<std::string, unsigned long> > mWriterBytes;
+
+public:
+
+    /** Constructor. */
+    MemoryFootprint();
+
+    /**
+     * @param requestedBytes the number of bytes requested from malloc
+     * @return the size of the heap block that holds them, 0 for no request
+     */
+    static unsigned long HeapBlockBytes(unsigned long requestedBytes);
+
+    /**
+     * @param objectBytes the size of a class allocated from a FixedSizePool
+     * @return the size of its block in the pool, which has no malloc header
+     */
+    static unsigned long PoolBlockBytes(unsigned long objectBytes);
+
+    /**
+     * @param valueBytes the size of the value type
+     * @return the size of the heap block of one std::map or std::set node
+     */
+    static unsigned long TreeNodeBytes(unsigned long valueBytes);
+
+    /**
+     * @param capacity the capacity of a std::vector
+     * @param elementBytes the size of its element type
+     * @return the size of the heap block holding its elements
+     */
+    static unsigned long VectorBytes(unsigned long capacity, unsigned long elementBytes);
+
+    /**
+     * @param rString a string
+     * @return the size of the heap block holding its characters, 0 if they are stored in place
+     */
+    static unsigned long StringBytes(const std::string& rString);
+
+    /**
+     * Account for the cells, their models and data, the population's cell
+     * maps and the mesh. Clears any previous measurement, including writers.
+     *
+     * @param rCellPopulation the cell population
+     */
+    void Measure(VertexBasedCellPopulation<2>& rCellPopulation);
+
+    /**
+     * Add the buffered state of a writer to WRITER_BUFFERS.
+     *
+     * @param rName the name of the writer
+     * @param numBytes its buffered bytes
+     */
+    void AddWriterBuffer(const std::string& rName, unsigned long numBytes);
+
+    /**
+     * @param component the component
+     * @return its bytes
+     */
+    unsigned long GetBytes(Component component) const;
+
+    /** @return the bytes of all components. */
+    unsigned long GetTotalBytes() const;
+
+    /** @return the number of cells measured. */
+    unsigned GetNumCells() const;
+
+    /**
+     * @param component the component
+     * @return its name as used in the output files
+     */
+    static const char* GetComponentName(Component component);
+
+    /** @return the resident set size of the process in KB, or 0 if unknown. */
+    static unsigned long GetResidentKb();
+
+    /**
+     * Write the column names of the per-report CSV.
+     *
+     * @param rStream the stream
+     */
+    static void WriteHeader(std::ostream& rStream);
+
+    /**
+     * Write one row of the per-report CSV: the time, the numbers of cells,
+     * nodes and elements, the bytes of each component, the total, the total
+     * per cell and the resident set size in KB.
+     *
+     * @param rStream the stream
+     * @param time the simulation time
+     */
+    void WriteRow(std::ostream& rStream, double time) const;
+
+    /**
+     * Write a table of the bytes and bytes per cell of each component and of
+     * each writer.
+     *
+     * @param rStream the stream
+     * @param time the simulation time
+     */
+    void WriteSummary(std::ostream& rStream, double time) const;
+};
+
+#endif /*MEMORYFOOTPRINT_HPP_*/
@@ -0,0 +1,143 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "P2QuantileEstimator.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+P2QuantileEstimator::P2QuantileEstimator(double probability)
+    : mProbability(probability),
+      mCount(0)
+{
+    assert(probability >= 0.0 && probability <= 1.0);
+    Reset();
+}
+
+void P2QuantileEstimator::Reset()
+{
+    mCount = 0;
+    double p = mProbability;
+
+    mIncrements[0] = 0.0;
+    mIncrements[1] = p/2.0;
+    mIncrements[2] = p;
+    mIncrements[3] = (1.0 + p)/2.0;
+    mIncrements[4] = 1.0;
+
+    mDesiredPositions[0] = 1.0;
+    mDesiredPositions[1] = 1.0 + 2.0*p;
+    mDesiredPositions[2] = 1.0 + 4.0*p;
+    mDesiredPositions[3] = 3.0 + 2.0*p;
+    mDesiredPositions[4] = 5.0;
+
+    for (unsigned i=0; i<5; i++)
+    {
+        mPositions[i] = i + 1.0;
+        mHeights[i] = 0.0;
+    }
+}
+
+void P2QuantileEstimator::Add(double value)
+{
+    // The first five values initialise the markers
+    if (mCount < 5)
+    {
+        mHeights[mCount] = value;
+        mCount++;
+        if (mCount == 5)
+        {
+            std::sort(mHeights, mHeights + 5);
+        }
+        return;
+    }
+    mCount++;
+
+    // Find the cell k such that mHeights[k] <= value < mHeights[k+1], extending the extremes if needed
+    unsigned k;
+    if (value < mHeights[0])
+    {
+        mHeights[0] = value;
+        k = 0;
+    }
+    else if (value >= mHeights[4])
+    {
+        mHeights[4] = value;
+        k = 3;
+    }
+    else
+    {
+        k = 0;
+        while (value >= mHeights[k+1])
+        {
+            k++;
+        }
+    }
+
+    for (unsigned i=k+1; i<5; i++)
+    {
+        mPositions[i] += 1.0;
+    }
+    for (unsigned i=0; i<5; i++)
+    {
+        mDesiredPositions[i] += mIncrements[i];
+    }
+
+    // Adjust the heights of the three middle markers if they are off their desired positions
+    for (unsigned i=1; i<4; i++)
+    {
+        double d = mDesiredPositions[i] - mPositions[i];
+        if ((d >= 1.0 && mPositions[i+1] - mPositions[i] > 1.0)
+            || (d <= -1.0 && mPositions[i-1] - mPositions[i] < -1.0))
+        {
+            int direction = (d > 0.0) ? 1 : -1;
+            double candidate = Parabolic(i, direction);
+            if (mHeights[i-1] < candidate && candidate < mHeights[i+1])
+            {
+                mHeights[i] = candidate;
+            }
+            else
+            {
+                mHeights[i] = Linear(i, direction);
+            }
+            mPositions[i] += direction;
+        }
+    }
+}
+
+double P2QuantileEstimator::Parabolic(unsigned i, double d) const
+{
+    return mHeights[i] + d/(mPositions[i+1] - mPositions[i-1])
+        * ((mPositions[i] - mPositions[i-1] + d)*(mHeights[i+1] - mHeights[i])/(mPositions[i+1] - mPositions[i])
+         + (mPositions[i+1] - mPositions[i] - d)*(mHeights[i] - mHeights[i-1])/(mPositions[i] - mPositions[i-1]));
+}
+
+double P2QuantileEstimator::Linear(unsigned i, int d) const
+{
+    return mHeights[i] + d*(mHeights[i+d] - mHeights[i])/(mPositions[i+d] - mPositions[i]);
+}
+
+double P2QuantileEstimator::GetQuantile() const
+{
+    if (mCount == 0)
+    {
+        return 0.0;
+    }
+    if (mCount <= 5)
+    {
+        // Exact quantile of the values seen so far (nearest rank)
+        double sorted[5];
+        std::copy(mHeights, mHeights + mCount, sorted);
+        std::sort(sorted, sorted + mCount);
+        unsigned rank = (unsigned)floor(mProbability*(mCount - 1) + 0.5);
+        return sorted[rank];
+    }
+    return mHeights[2];
+}
+
+double P2QuantileEstimator::GetProbability() const
+{
+    return mProbability;
+}
@@ -0,0 +1,80 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef P2QUANTILEESTIMATOR_HPP_
+#define P2QUANTILEESTIMATOR_HPP_
+
+/**
+ * Streaming estimate of a single quantile using the P-squared algorithm of
+ * Jain and Chlamtac (1985). Five markers are kept, so memory and time per value
+ * are constant; the estimate is exact for the first five values.
+ */
+class P2QuantileEstimator
+{
+private:
+
+    /** The quantile being estimated, in [0,1]. */
+    double mProbability;
+
+    /** The number of values added. */
+    unsigned long mCount;
+
+    /** Marker heights. */
+    double mHeights[5];
+
+    /** Actual marker positions. */
+    double mPositions[5];
+
+    /** Desired marker positions. */
+    double mDesiredPositions[5];
+
+    /** Increments of the desired marker positions. */
+    double mIncrements[5];
+
+    /**
+     * Piecewise-parabolic prediction of a marker height.
+     *
+     * @param i the marker index
+     * @param d the direction (+1 or -1) the marker is moved
+     * @return the predicted height
+     */
+    double Parabolic(unsigned i, double d) const;
+
+    /**
+     * Linear prediction of a marker height, used if the parabolic one is not monotone.
+     *
+     * @param i the marker index
+     * @param d the direction (+1 or -1) the marker is moved
+     * @return the predicted height
+     */
+    double Linear(unsigned i, int d) const;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param probability the quantile to estimate, in [0,1] (e.g. 0.5 for the median)
+     */
+    P2QuantileEstimator(double probability=0.5);
+
+    /**
+     * Add a value to the estimator.
+     *
+     * @param value the value
+     */
+    void Add(double value);
+
+    /** Remove all values. */
+    void Reset();
+
+    /** @return the current estimate of the quantile, or zero if no values have been added. */
+    double GetQuantile() const;
+
+    /** @return the quantile being estimated. */
+    double GetProbability() const;
+};
+
+#endif /*P2QUANTILEESTIMATOR_HPP_*/
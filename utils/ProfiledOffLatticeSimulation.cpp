@@ -0,0 +1,40 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "ProfiledOffLatticeSimulation.hpp"
+#include "GTPaseProfiler.hpp"
+
+template<unsigned DIM>
+ProfiledOffLatticeSimulation<DIM>::ProfiledOffLatticeSimulation(AbstractCellPopulation<DIM>& rCellPopulation,
+                                                                bool deleteCellPopulationInDestructor,
+                                                                bool initialiseCells)
+    : OffLatticeSimulation<DIM>(rCellPopulation, deleteCellPopulationInDestructor, initialiseCells)
+{
+}
+
+template<unsigned DIM>
+void ProfiledOffLatticeSimulation<DIM>::UpdateCellLocationsAndTopology()
+{
+    GTPASE_PROFILE_SCOPE(FORCE_AND_POSITION_UPDATE);
+    GTPASE_PROFILE_COUNT(FORCE_AND_POSITION_UPDATE, this->mrCellPopulation.GetNumNodes());
+    OffLatticeSimulation<DIM>::UpdateCellLocationsAndTopology();
+}
+
+template<unsigned DIM>
+void ProfiledOffLatticeSimulation<DIM>::UpdateCellPopulation()
+{
+    GTPASE_PROFILE_SCOPE(POPULATION_UPDATE);
+    GTPASE_PROFILE_COUNT(POPULATION_UPDATE, this->mrCellPopulation.GetNumRealCells());
+    OffLatticeSimulation<DIM>::UpdateCellPopulation();
+}
+
+// Explicit instantiation
+template class ProfiledOffLatticeSimulation<1>;
+template class ProfiledOffLatticeSimulation<2>;
+template class ProfiledOffLatticeSimulation<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(ProfiledOffLatticeSimulation)
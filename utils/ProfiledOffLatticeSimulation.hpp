@@ -0,0 +1,104 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef PROFILEDOFFLATTICESIMULATION_HPP_
+#define PROFILEDOFFLATTICESIMULATION_HPP_
+
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "OffLatticeSimulation.hpp"
+
+/**
+ * An OffLatticeSimulation whose force/position update and population update
+ * (which includes remeshing of vertex meshes) are timed by GTPaseProfiler.
+ *
+ * Without GTPASE_ENABLE_PROFILING it behaves exactly like OffLatticeSimulation.
+ */
+template<unsigned DIM>
+class ProfiledOffLatticeSimulation : public OffLatticeSimulation<DIM>
+{
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<OffLatticeSimulation<DIM> >(*this);
+    }
+
+protected:
+
+    /**
+     * Overridden UpdateCellLocationsAndTopology() method, timed as
+     * GTPaseProfiler::FORCE_AND_POSITION_UPDATE.
+     */
+    virtual void UpdateCellLocationsAndTopology();
+
+    /**
+     * Overridden UpdateCellPopulation() method, timed as
+     * GTPaseProfiler::POPULATION_UPDATE.
+     */
+    virtual void UpdateCellPopulation();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rCellPopulation a cell population object
+     * @param deleteCellPopulationInDestructor whether to delete the cell population on destruction
+     * @param initialiseCells whether to initialise cells (set to false when loading from an archive)
+     */
+    ProfiledOffLatticeSimulation(AbstractCellPopulation<DIM>& rCellPopulation,
+                                 bool deleteCellPopulationInDestructor=false,
+                                 bool initialiseCells=true);
+};
+
+#include "SerializationExportWrapper.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(ProfiledOffLatticeSimulation)
+
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Serialize information required to construct a ProfiledOffLatticeSimulation.
+ */
+template<class Archive, unsigned DIM>
+inline void save_construct_data(
+    Archive & ar, const ProfiledOffLatticeSimulation<DIM> * t, const unsigned int file_version)
+{
+    // Save data required to construct instance
+    const AbstractCellPopulation<DIM>* p_cell_population = &(t->rGetCellPopulation());
+    ar & p_cell_population;
+}
+
+/**
+ * De-serialize constructor parameters and initialise a ProfiledOffLatticeSimulation.
+ */
+template<class Archive, unsigned DIM>
+inline void load_construct_data(
+    Archive & ar, ProfiledOffLatticeSimulation<DIM> * t, const unsigned int file_version)
+{
+    // Retrieve data from archive required to construct new instance
+    AbstractCellPopulation<DIM>* p_cell_population;
+    ar >> p_cell_population;
+
+    // Invoke inplace constructor to initialise instance, last two variables set extra
+    // member variables to be deleted as they are loaded from archive and to not initialise cells.
+    ::new(t)ProfiledOffLatticeSimulation<DIM>(*p_cell_population, true, false);
+}
+}
+} // namespace
+
+#endif /*PROFILEDOFFLATTICESIMULATION_HPP_*/
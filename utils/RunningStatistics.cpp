@@ -0,0 +1,113 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "RunningStatistics.hpp"
+
+RunningStatistics::RunningStatistics()
+    : mCount(0),
+      mMean(0.0),
+      mSumSquaredDeviations(0.0),
+      mMin(0.0),
+      mMax(0.0)
+{
+}
+
+RunningStatistics::RunningStatistics(unsigned long count, double mean, double sumSquaredDeviations, double min, double max)
+    : mCount(count),
+      mMean(mean),
+      mSumSquaredDeviations(sumSquaredDeviations),
+      mMin(min),
+      mMax(max)
+{
+}
+
+void RunningStatistics::Add(double value)
+{
+    mCount++;
+    if (mCount == 1)
+    {
+        mMin = value;
+        mMax = value;
+    }
+    else
+    {
+        if (value < mMin)
+        {
+            mMin = value;
+        }
+        if (value > mMax)
+        {
+            mMax = value;
+        }
+    }
+
+    double delta = value - mMean;
+    mMean += delta/mCount;
+    mSumSquaredDeviations += delta*(value - mMean);
+}
+
+void RunningStatistics::Merge(const RunningStatistics& rOther)
+{
+    if (rOther.mCount == 0)
+    {
+        return;
+    }
+    if (mCount == 0)
+    {
+        *this = rOther;
+        return;
+    }
+
+    // Chan et al.'s pairwise update
+    double total = (double)(mCount + rOther.mCount);
+    double delta = rOther.mMean - mMean;
+    mMean += delta*rOther.mCount/total;
+    mSumSquaredDeviations += rOther.mSumSquaredDeviations + delta*delta*mCount*rOther.mCount/total;
+    mCount += rOther.mCount;
+
+    if (rOther.mMin < mMin)
+    {
+        mMin = rOther.mMin;
+    }
+    if (rOther.mMax > mMax)
+    {
+        mMax = rOther.mMax;
+    }
+}
+
+void RunningStatistics::Reset()
+{
+    *this = RunningStatistics();
+}
+
+unsigned long RunningStatistics::GetCount() const
+{
+    return mCount;
+}
+
+double RunningStatistics::GetMean() const
+{
+    return mMean;
+}
+
+double RunningStatistics::GetVariance() const
+{
+    return mCount > 1 ? mSumSquaredDeviations/(mCount - 1) : 0.0;
+}
+
+double RunningStatistics::GetSumSquaredDeviations() const
+{
+    return mSumSquaredDeviations;
+}
+
+double RunningStatistics::GetMin() const
+{
+    return mMin;
+}
+
+double RunningStatistics::GetMax() const
+{
+    return mMax;
+}
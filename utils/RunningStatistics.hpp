@@ -0,0 +1,107 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef RUNNINGSTATISTICS_HPP_
+#define RUNNINGSTATISTICS_HPP_
+
+#include "ChasteSerialization.hpp"
+
+/**
+ * Accumulates the count, mean, variance, minimum and maximum of a stream of
+ * values in O(1) time and memory per value, using Welford's algorithm for the
+ * mean and variance so that long runs do not lose precision.
+ */
+class RunningStatistics
+{
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Archive the accumulator.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & mCount;
+        archive & mMean;
+        archive & mSumSquaredDeviations;
+        archive & mMin;
+        archive & mMax;
+    }
+
+    /** The number of values added. */
+    unsigned long mCount;
+
+    /** The running mean. */
+    double mMean;
+
+    /** The running sum of squared deviations from the mean (M2 in Welford's notation). */
+    double mSumSquaredDeviations;
+
+    /** The smallest value added. */
+    double mMin;
+
+    /** The largest value added. */
+    double mMax;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    RunningStatistics();
+
+    /**
+     * Constructor restoring an accumulator from its raw state, e.g. from a checkpoint.
+     *
+     * @param count the number of values added
+     * @param mean the running mean
+     * @param sumSquaredDeviations the running sum of squared deviations from the mean
+     * @param min the smallest value added
+     * @param max the largest value added
+     */
+    RunningStatistics(unsigned long count, double mean, double sumSquaredDeviations, double min, double max);
+
+    /**
+     * Add a value to the accumulator.
+     *
+     * @param value the value
+     */
+    void Add(double value);
+
+    /**
+     * Combine another accumulator into this one, as if its values had been added here.
+     *
+     * @param rOther the other accumulator
+     */
+    void Merge(const RunningStatistics& rOther);
+
+    /** Remove all values. */
+    void Reset();
+
+    /** @return the number of values added. */
+    unsigned long GetCount() const;
+
+    /** @return the mean, or zero if no values have been added. */
+    double GetMean() const;
+
+    /** @return the sample (unbiased) variance, or zero if fewer than two values have been added. */
+    double GetVariance() const;
+
+    /** @return the running sum of squared deviations from the mean. */
+    double GetSumSquaredDeviations() const;
+
+    /** @return the smallest value added, or zero if no values have been added. */
+    double GetMin() const;
+
+    /** @return the largest value added, or zero if no values have been added. */
+    double GetMax() const;
+};
+
+#endif /*RUNNINGSTATISTICS_HPP_*/
@@ -0,0 +1,210 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "ScenarioConfig.hpp"
+#include "Exception.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+/** @return rText without leading and trailing white space. */
+std::string Trim(const std::string& rText)
+{
+    const char* white_space = " \t\r\n";
+    std::string::size_type first = rText.find_first_not_of(white_space);
+    if (first == std::string::npos)
+    {
+        return "";
+    }
+    std::string::size_type last = rText.find_last_not_of(white_space);
+    return rText.substr(first, last - first + 1);
+}
+}
+
+ScenarioConfig::ScenarioConfig()
+{
+    Declare("output_directory", "50x50GTPAse_2500_0.2beta_medAdhesion_Random_G_scale_1point15_deformation100_surface_0",
+            "output directory, relative to CHASTE_TEST_OUTPUT");
+    Declare("num_cells_across", "50", "honeycomb mesh width in cells");
+    Declare("num_cells_up", "50", "honeycomb mesh height in cells");
+    Declare("seed", "1", "seed of the per-cell random initial G and betas");
+    Declare("dt", "0.01", "time step");
+    Declare("end_time", "2500", "end time");
+    Declare("sampling_multiple", "10", "simulator sampling multiple; must divide all writer multiples");
+
+    Declare("beta", "0.2", "ODESRN bifurcation parameter");
+    Declare("beta_spread", "0", "per-cell beta is drawn uniformly from [beta - beta_spread, beta + beta_spread]");
+    Declare("basal_rate", "0.1", "ODESRN basal activation rate");
+    Declare("feedback_strength", "1.5", "ODESRN positive feedback strength");
+    Declare("target_area_rate", "0.1", "ODESRN target area relaxation rate");
+    Declare("target_area_scale", "1.15", "ODESRN target area with no active GTPase");
+    Declare("target_area_reduction", "0.75", "ODESRN maximal fractional target area reduction");
+    Declare("half_saturation", "0.3", "ODESRN level of G giving half the target area reduction");
+    Declare("time_scale", "0.25", "ODESRN time scale");
+    Declare("initial_target_area", "0.8", "initial target area");
+    Declare("initial_area", "0.866025", "initial cell area");
+
+    Declare("deformation_energy", "100", "Nagai-Honda deformation energy parameter");
+    Declare("membrane_surface_energy", "0", "Nagai-Honda membrane surface energy parameter");
+    Declare("cell_cell_adhesion", "1.0", "Nagai-Honda cell-cell adhesion energy parameter");
+    Declare("cell_boundary_adhesion", "1.0", "Nagai-Honda cell-boundary adhesion energy parameter");
+
+    Declare("csv_writer_multiple", "10", "CsvWriter sampling multiple (0 switches the writer off)");
+    Declare("statistics_writer_multiple", "10", "PopulationStatisticsWriter sampling multiple (0 for off)");
+    Declare("topology_writer_multiple", "200", "TopologyWriter sampling multiple (0 for off)");
+    Declare("topology_event_writer_multiple", "10", "TopologyEventWriter sampling multiple (0 for off)");
+    Declare("one_cell_writer_multiple", "10", "OneCellGTPaseWriter sampling multiple (0 for off)");
+    Declare("xml_writer_multiple", "200", "XMLCellWriter sampling multiple (0 for off)");
+    Declare("xml_neighbour_ids", "false", "whether XMLCellWriter writes neighbour lists");
+    Declare("xml_keyframe_interval", "0", "XMLCellWriter frames between keyframes of delta output (0 for full frames only)");
+    Declare("vtu_writer_multiple", "200", "VtuTissueWriter sampling multiple (0 for off)");
+
+    Declare("spectrum_multiple", "200", "OscillationSpectrumModifier sampling multiple (0 for off)");
+    Declare("spectrum_min_frequency", "0.001", "lowest frequency of the oscillation spectrum");
+    Declare("spectrum_max_frequency", "0.1", "highest frequency of the oscillation spectrum");
+    Declare("spectrum_num_frequencies", "100", "number of frequencies of the oscillation spectrum");
+    Declare("summary_interval", "50000", "CellStatisticsSummaryModifier interval in time steps (0 for end only)");
+    Declare("checkpoint_interval", "10000", "checkpoint interval in time steps (0 for none)");
+    Declare("keep_checkpoint", "false", "whether to keep the last checkpoint of a completed run, so that it can be extended to a later end time");
+    Declare("memory_report", "false", "whether to report the memory footprint per cell at the start and at each checkpoint");
+    Declare("hardware_counters", "false", "whether a profiling build also records hardware counters per phase");
+}
+
+void ScenarioConfig::Declare(const std::string& rKey, const std::string& rDefault, const std::string& rDescription)
+{
+    mValues[rKey] = rDefault;
+    mKeys.push_back(rKey);
+    mDescriptions[rKey] = rDescription;
+}
+
+void ScenarioConfig::ReadFile(const std::string& rFileName)
+{
+    std::ifstream file(rFileName.c_str());
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open scenario file " + rFileName);
+    }
+
+    std::string line;
+    unsigned line_number = 0;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+        line = Trim(line);
+        if (line.empty())
+        {
+            continue;
+        }
+
+        std::string::size_type equals = line.find('=');
+        if (equals == std::string::npos)
+        {
+            std::stringstream message;
+            message << rFileName << ":" << line_number << ": expected key = value";
+            EXCEPTION(message.str());
+        }
+        Set(Trim(line.substr(0, equals)), Trim(line.substr(equals + 1)));
+    }
+}
+
+void ScenarioConfig::ParseOverride(const std::string& rAssignment)
+{
+    std::string::size_type equals = rAssignment.find('=');
+    if (equals == std::string::npos)
+    {
+        EXCEPTION("Expected key=value, got " + rAssignment);
+    }
+    Set(Trim(rAssignment.substr(0, equals)), Trim(rAssignment.substr(equals + 1)));
+}
+
+void ScenarioConfig::Set(const std::string& rKey, const std::string& rValue)
+{
+    if (!HasKey(rKey))
+    {
+        EXCEPTION("Unknown scenario key " + rKey);
+    }
+    mValues[rKey] = rValue;
+}
+
+bool ScenarioConfig::HasKey(const std::string& rKey) const
+{
+    return mValues.find(rKey) != mValues.end();
+}
+
+const std::string& ScenarioConfig::rGetValue(const std::string& rKey) const
+{
+    std::map<std::string, std::string>::const_iterator it = mValues.find(rKey);
+    if (it == mValues.end())
+    {
+        EXCEPTION("Unknown scenario key " + rKey);
+    }
+    return it->second;
+}
+
+std::string ScenarioConfig::GetString(const std::string& rKey) const
+{
+    return rGetValue(rKey);
+}
+
+double ScenarioConfig::GetDouble(const std::string& rKey) const
+{
+    const std::string& r_value = rGetValue(rKey);
+    char* p_end;
+    errno = 0;
+    double value = std::strtod(r_value.c_str(), &p_end);
+    if (r_value.empty() || *p_end != '\0' || errno == ERANGE)
+    {
+        EXCEPTION("Scenario key " + rKey + " is not a number: " + r_value);
+    }
+    return value;
+}
+
+unsigned ScenarioConfig::GetUnsigned(const std::string& rKey) const
+{
+    const std::string& r_value = rGetValue(rKey);
+    char* p_end;
+    errno = 0;
+    unsigned long value = std::strtoul(r_value.c_str(), &p_end, 10);
+    if (r_value.empty() || *p_end != '\0' || r_value[0] == '-' || errno == ERANGE || value > UINT_MAX)
+    {
+        EXCEPTION("Scenario key " + rKey + " is not a non-negative integer: " + r_value);
+    }
+    return value;
+}
+
+bool ScenarioConfig::GetBool(const std::string& rKey) const
+{
+    const std::string& r_value = rGetValue(rKey);
+    bool value = false;
+    if (r_value == "true" || r_value == "yes" || r_value == "on" || r_value == "1")
+    {
+        value = true;
+    }
+    else if (!(r_value == "false" || r_value == "no" || r_value == "off" || r_value == "0"))
+    {
+        EXCEPTION("Scenario key " + rKey + " is not a bool: " + r_value);
+    }
+    return value;
+}
+
+void ScenarioConfig::Write(std::ostream& rStream) const
+{
+    for (unsigned i=0; i<mKeys.size(); i++)
+    {
+        const std::string& r_key = mKeys[i];
+        rStream << "# " << mDescriptions.find(r_key)->second << "\n"
+                << r_key << " = " << mValues.find(r_key)->second << "\n";
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef SCENARIOCONFIG_HPP_
+#define SCENARIOCONFIG_HPP_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The settings of one simulation scenario, as key = value pairs.
+ *
+ * Every key has a default equal to the original hard-coded
+ * multiCellsNoDivisionCoupledArea setup, so a scenario file only lists what it
+ * changes. Scenario files have one "key = value" per line; blank lines and
+ * text after '#' are ignored. Unknown keys and unparsable values are errors,
+ * so typos are not silently ignored.
+ */
+class ScenarioConfig
+{
+private:
+
+    /** The value of every key, as text. */
+    std::map<std::string, std::string> mValues;
+
+    /** The keys in the order they were declared, for Write(). */
+    std::vector<std::string> mKeys;
+
+    /** The description of each key, for Write(). */
+    std::map<std::string, std::string> mDescriptions;
+
+    /**
+     * Declare a key with its default value.
+     *
+     * @param rKey the key
+     * @param rDefault the default value
+     * @param rDescription a one-line description
+     */
+    void Declare(const std::string& rKey, const std::string& rDefault, const std::string& rDescription);
+
+    /**
+     * @param rKey the key
+     * @return the value of the key
+     */
+    const std::string& rGetValue(const std::string& rKey) const;
+
+public:
+
+    /**
+     * Default constructor. Declares all keys with their defaults.
+     */
+    ScenarioConfig();
+
+    /**
+     * Read a scenario file, overriding the values of the keys it lists.
+     *
+     * @param rFileName the path of the file
+     */
+    void ReadFile(const std::string& rFileName);
+
+    /**
+     * Apply a single "key=value" override, e.g. from the command line.
+     *
+     * @param rAssignment the assignment
+     */
+    void ParseOverride(const std::string& rAssignment);
+
+    /**
+     * Set the value of a key.
+     *
+     * @param rKey the key, which must have been declared
+     * @param rValue the value, as text
+     */
+    void Set(const std::string& rKey, const std::string& rValue);
+
+    /**
+     * @param rKey the key
+     * @return whether the key is declared
+     */
+    bool HasKey(const std::string& rKey) const;
+
+    /**
+     * @param rKey the key
+     * @return the value as text
+     */
+    std::string GetString(const std::string& rKey) const;
+
+    /**
+     * @param rKey the key
+     * @return the value as a double
+     */
+    double GetDouble(const std::string& rKey) const;
+
+    /**
+     * @param rKey the key
+     * @return the value as an unsigned integer
+     */
+    unsigned GetUnsigned(const std::string& rKey) const;
+
+    /**
+     * @param rKey the key
+     * @return the value as a bool (true/false, yes/no, on/off or 1/0)
+     */
+    bool GetBool(const std::string& rKey) const;
+
+    /**
+     * Write the full resolved scenario in scenario file format.
+     *
+     * @param rStream the stream
+     */
+    void Write(std::ostream& rStream) const;
+};
+
+#endif /*SCENARIOCONFIG_HPP_*/
@@ -0,0 +1,555 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "TissueCheckpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <boost/cstdint.hpp>
+
+#include "CheckpointArchiveTypes.hpp"
+#include "CheckpointStream.hpp"
+#include "CellId.hpp"
+#include "NoCellCycleModel.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "Exception.hpp"
+#include "ODESrnModel.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "SimulationTime.hpp"
+#include "SmartPointers.hpp"
+#include "WildTypeCellMutationState.hpp"
+
+namespace
+{
+/** Identifies a checkpoint file. */
+const char CHECKPOINT_MAGIC[8] = {'G', 'T', 'P', 'C', 'K', 'P', 'T', '\0'};
+
+/** The checkpoint format version. */
+const boost::uint32_t CHECKPOINT_VERSION = 4;
+
+/** Written in native byte order, to detect files from machines of the other endianness. */
+const boost::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/** Orders cells by increasing cell ID. */
+bool CellIdLess(const CellPtr& rA, const CellPtr& rB)
+{
+    return rA->GetCellId() < rB->GetCellId();
+}
+}
+
+TissueCheckpoint::TissueCheckpoint()
+    : mTime(0.0),
+      mDt(0.0),
+      mStartTime(0.0),
+      mTimeStepsElapsed(0),
+      mSrnStateSize(0)
+{
+}
+
+TissueCheckpoint::TissueCheckpoint(const std::string& rFileName)
+    : mTime(0.0),
+      mDt(0.0),
+      mStartTime(0.0),
+      mTimeStepsElapsed(0),
+      mSrnStateSize(0)
+{
+    Read(rFileName);
+}
+
+unsigned long TissueCheckpoint::Save(const std::string& rFileName,
+                                     VertexBasedCellPopulation<2>& rCellPopulation,
+                                     const ComponentMap& rComponents,
+                                     const std::string& rScenario)
+{
+    TissueCheckpoint checkpoint;
+    checkpoint.Gather(rCellPopulation, rComponents, rScenario);
+
+    std::string temporary_file_name = rFileName + ".tmp";
+    unsigned long num_bytes = checkpoint.Write(temporary_file_name);
+    if (std::rename(temporary_file_name.c_str(), rFileName.c_str()) != 0)
+    {
+        EXCEPTION("Could not rename " + temporary_file_name + " to " + rFileName);
+    }
+    return num_bytes;
+}
+
+void TissueCheckpoint::Gather(VertexBasedCellPopulation<2>& rCellPopulation, const ComponentMap& rComponents,
+                              const std::string& rScenario)
+{
+    mScenario = rScenario;
+
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    mTime = p_simulation_time->GetTime();
+    mDt = p_simulation_time->GetTimeStep();
+    mStartTime = p_simulation_time->GetStartTime();
+    mTimeStepsElapsed = p_simulation_time->GetTimeStepsElapsed();
+
+    // Mesh
+    MutableVertexMesh<2,2>& r_mesh = rCellPopulation.rGetMesh();
+    unsigned num_nodes = r_mesh.GetNumNodes();
+    mNodeLocations.resize(2*num_nodes);
+    mNodeIsBoundary.resize(num_nodes);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        Node<2>* p_node = r_mesh.GetNode(node_index);
+        mNodeLocations[2*node_index] = p_node->rGetLocation()[0];
+        mNodeLocations[2*node_index + 1] = p_node->rGetLocation()[1];
+        mNodeIsBoundary[node_index] = p_node->IsBoundaryNode();
+    }
+
+    unsigned num_elements = r_mesh.GetNumElements();
+    mElementNumNodes.resize(num_elements);
+    mElementNodeIndices.clear();
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<2,2>* p_element = r_mesh.GetElement(elem_index);
+        mElementNumNodes[elem_index] = p_element->GetNumNodes();
+        for (unsigned j=0; j<p_element->GetNumNodes(); j++)
+        {
+            mElementNodeIndices.push_back(p_element->GetNodeGlobalIndex(j));
+        }
+    }
+
+    mMeshParameters.clear();
+    mMeshParameters.push_back(r_mesh.GetCellRearrangementThreshold());
+    mMeshParameters.push_back(r_mesh.GetT2Threshold());
+    mMeshParameters.push_back(r_mesh.GetCellRearrangementRatio());
+    mMeshParameters.push_back(r_mesh.GetCheckForInternalIntersections() ? 1.0 : 0.0);
+
+    // Cells, in increasing ID order so that CreateCells() can reproduce the IDs
+    std::vector<CellPtr> cells;
+    for (AbstractCellPopulation<2>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        cells.push_back(*cell_iter);
+    }
+    std::sort(cells.begin(), cells.end(), CellIdLess);
+
+    unsigned num_cells = cells.size();
+    mCellDataKeys = num_cells > 0 ? cells[0]->GetCellData()->GetKeys() : std::vector<std::string>();
+    mSrnStateSize = 0;
+    if (num_cells > 0)
+    {
+        ODESrnModel* p_model = dynamic_cast<ODESrnModel*>(cells[0]->GetSrnModel());
+        if (p_model == NULL)
+        {
+            EXCEPTION("TissueCheckpoint requires every cell to have an ODESrnModel");
+        }
+        mSrnStateSize = p_model->GetStateVariables().size();
+    }
+
+    mCellIds.resize(num_cells);
+    mLocationIndices.resize(num_cells);
+    mCellBirthTimes.resize(num_cells);
+    mCellDataValues.resize(mCellDataKeys.size()*num_cells);
+    mSrnStates.resize(mSrnStateSize*num_cells);
+    mSrnLastTimes.resize(num_cells);
+    mSrnStatistics.resize(10*num_cells);
+
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        CellPtr p_cell = cells[i];
+        mCellIds[i] = p_cell->GetCellId();
+        mLocationIndices[i] = rCellPopulation.GetLocationIndexUsingCell(p_cell);
+
+        if (dynamic_cast<NoCellCycleModel*>(p_cell->GetCellCycleModel()) == NULL)
+        {
+            EXCEPTION("TissueCheckpoint requires every cell to have a NoCellCycleModel");
+        }
+        mCellBirthTimes[i] = p_cell->GetCellCycleModel()->GetBirthTime();
+
+        for (unsigned k=0; k<mCellDataKeys.size(); k++)
+        {
+            mCellDataValues[mCellDataKeys.size()*i + k] = p_cell->GetCellData()->GetItem(mCellDataKeys[k]);
+        }
+
+        ODESrnModel* p_model = dynamic_cast<ODESrnModel*>(p_cell->GetSrnModel());
+        if (p_model == NULL)
+        {
+            EXCEPTION("TissueCheckpoint requires every cell to have an ODESrnModel");
+        }
+        std::vector<double>& r_state = p_model->GetStateVariables();
+        std::copy(r_state.begin(), r_state.end(), mSrnStates.begin() + mSrnStateSize*i);
+        mSrnLastTimes[i] = p_model->GetSimulatedToTime();
+
+        const RunningStatistics* p_statistics[2] = {&p_model->rGetGStatistics(), &p_model->rGetTargetAreaStatistics()};
+        for (unsigned s=0; s<2; s++)
+        {
+            double* p_row = &mSrnStatistics[10*i + 5*s];
+            p_row[0] = (double)p_statistics[s]->GetCount();
+            p_row[1] = p_statistics[s]->GetMean();
+            p_row[2] = p_statistics[s]->GetSumSquaredDeviations();
+            p_row[3] = p_statistics[s]->GetMin();
+            p_row[4] = p_statistics[s]->GetMax();
+        }
+    }
+
+    // The random number generator is archived the same way CellBasedSimulationArchiver does it
+    std::ostringstream rng_stream;
+    {
+        boost::archive::binary_oarchive output_arch(rng_stream);
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        output_arch & static_cast<const RandomNumberGenerator&>(*p_gen);
+        output_arch & p_gen;
+    }
+    mRandomNumberGeneratorState = rng_stream.str();
+
+    mComponentStates.clear();
+    for (ComponentMap::const_iterator iter = rComponents.begin(); iter != rComponents.end(); ++iter)
+    {
+        std::ostringstream component_stream(std::ios::out | std::ios::binary);
+        iter->second->SaveCheckpointState(component_stream);
+        mComponentStates[iter->first] = component_stream.str();
+    }
+}
+
+unsigned long TissueCheckpoint::Write(const std::string& rFileName) const
+{
+    std::ofstream file(rFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open checkpoint file " + rFileName);
+    }
+
+    file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    CheckpointStream::WriteValue(file, CHECKPOINT_VERSION);
+    CheckpointStream::WriteValue(file, BYTE_ORDER_MARK);
+    CheckpointStream::WriteValue(file, mTime);
+    CheckpointStream::WriteValue(file, mDt);
+    CheckpointStream::WriteValue(file, mStartTime);
+    CheckpointStream::WriteValue(file, (boost::uint64_t)mTimeStepsElapsed);
+    CheckpointStream::WriteString(file, mScenario);
+
+    CheckpointStream::WriteArray(file, mNodeLocations);
+    CheckpointStream::WriteArray(file, mNodeIsBoundary);
+    CheckpointStream::WriteArray(file, mElementNumNodes);
+    CheckpointStream::WriteArray(file, mElementNodeIndices);
+    CheckpointStream::WriteArray(file, mMeshParameters);
+
+    CheckpointStream::WriteArray(file, mCellIds);
+    CheckpointStream::WriteArray(file, mLocationIndices);
+    CheckpointStream::WriteArray(file, mCellBirthTimes);
+    CheckpointStream::WriteValue(file, (boost::uint64_t)mCellDataKeys.size());
+    for (unsigned k=0; k<mCellDataKeys.size(); k++)
+    {
+        CheckpointStream::WriteString(file, mCellDataKeys[k]);
+    }
+    CheckpointStream::WriteArray(file, mCellDataValues);
+
+    CheckpointStream::WriteValue(file, (boost::uint32_t)mSrnStateSize);
+    CheckpointStream::WriteArray(file, mSrnStates);
+    CheckpointStream::WriteArray(file, mSrnLastTimes);
+    CheckpointStream::WriteArray(file, mSrnStatistics);
+
+    CheckpointStream::WriteString(file, mRandomNumberGeneratorState);
+
+    CheckpointStream::WriteValue(file, (boost::uint64_t)mComponentStates.size());
+    for (std::map<std::string, std::string>::const_iterator iter = mComponentStates.begin();
+         iter != mComponentStates.end();
+         ++iter)
+    {
+        CheckpointStream::WriteString(file, iter->first);
+        CheckpointStream::WriteString(file, iter->second);
+    }
+
+    unsigned long num_bytes = file.tellp();
+    file.close();
+    if (file.fail())
+    {
+        EXCEPTION("Error writing checkpoint file " + rFileName);
+    }
+    return num_bytes;
+}
+
+void TissueCheckpoint::Read(const std::string& rFileName)
+{
+    std::ifstream file(rFileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open checkpoint file " + rFileName);
+    }
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+    {
+        EXCEPTION(rFileName + " is not a checkpoint file");
+    }
+    boost::uint32_t version;
+    CheckpointStream::ReadValue(file, version);
+    if (version != CHECKPOINT_VERSION)
+    {
+        EXCEPTION("Unsupported checkpoint version in " + rFileName);
+    }
+    boost::uint32_t byte_order_mark;
+    CheckpointStream::ReadValue(file, byte_order_mark);
+    if (byte_order_mark != BYTE_ORDER_MARK)
+    {
+        EXCEPTION(rFileName + " was written on a machine with a different byte order");
+    }
+    CheckpointStream::ReadValue(file, mTime);
+    CheckpointStream::ReadValue(file, mDt);
+    CheckpointStream::ReadValue(file, mStartTime);
+    boost::uint64_t time_steps_elapsed;
+    CheckpointStream::ReadValue(file, time_steps_elapsed);
+    mTimeStepsElapsed = time_steps_elapsed;
+    CheckpointStream::ReadString(file, mScenario);
+
+    CheckpointStream::ReadArray(file, mNodeLocations);
+    CheckpointStream::ReadArray(file, mNodeIsBoundary);
+    CheckpointStream::ReadArray(file, mElementNumNodes);
+    CheckpointStream::ReadArray(file, mElementNodeIndices);
+    CheckpointStream::ReadArray(file, mMeshParameters);
+
+    CheckpointStream::ReadArray(file, mCellIds);
+    CheckpointStream::ReadArray(file, mLocationIndices);
+    CheckpointStream::ReadArray(file, mCellBirthTimes);
+    boost::uint64_t num_keys;
+    CheckpointStream::ReadValue(file, num_keys);
+    mCellDataKeys.resize(num_keys);
+    for (unsigned k=0; k<num_keys; k++)
+    {
+        CheckpointStream::ReadString(file, mCellDataKeys[k]);
+    }
+    CheckpointStream::ReadArray(file, mCellDataValues);
+
+    boost::uint32_t srn_state_size;
+    CheckpointStream::ReadValue(file, srn_state_size);
+    mSrnStateSize = srn_state_size;
+    CheckpointStream::ReadArray(file, mSrnStates);
+    CheckpointStream::ReadArray(file, mSrnLastTimes);
+    CheckpointStream::ReadArray(file, mSrnStatistics);
+
+    CheckpointStream::ReadString(file, mRandomNumberGeneratorState);
+
+    boost::uint64_t num_components;
+    CheckpointStream::ReadValue(file, num_components);
+    mComponentStates.clear();
+    for (unsigned c=0; c<num_components; c++)
+    {
+        std::string name;
+        CheckpointStream::ReadString(file, name);
+        CheckpointStream::ReadString(file, mComponentStates[name]);
+    }
+
+    unsigned num_cells = mCellIds.size();
+    if (mNodeIsBoundary.size()*2 != mNodeLocations.size()
+        || mMeshParameters.size() != 4
+        || mLocationIndices.size() != num_cells
+        || mCellBirthTimes.size() != num_cells
+        || mCellDataValues.size() != mCellDataKeys.size()*num_cells
+        || mSrnStates.size() != mSrnStateSize*num_cells
+        || mSrnLastTimes.size() != num_cells
+        || mSrnStatistics.size() != 10*num_cells)
+    {
+        EXCEPTION(rFileName + " is inconsistent");
+    }
+}
+
+double TissueCheckpoint::GetTime() const
+{
+    return mTime;
+}
+
+void TissueCheckpoint::CheckScenario(const std::string& rScenario) const
+{
+    if (rScenario == mScenario)
+    {
+        return;
+    }
+
+    // Report the first setting that differs
+    std::istringstream saved_stream(mScenario);
+    std::istringstream current_stream(rScenario);
+    std::string saved_line;
+    std::string current_line;
+    while (true)
+    {
+        bool has_saved = (bool)std::getline(saved_stream, saved_line);
+        bool has_current = (bool)std::getline(current_stream, current_line);
+        if (!has_saved && !has_current)
+        {
+            break;
+        }
+        if (!has_saved || !has_current || saved_line != current_line)
+        {
+            EXCEPTION("The checkpoint was written by a different scenario: it has \"" + (has_saved ? saved_line : "")
+                      + "\" where this run has \"" + (has_current ? current_line : "") + "\"");
+        }
+    }
+    EXCEPTION("The checkpoint was written by a different scenario");
+}
+
+void TissueCheckpoint::RestoreSimulationTime(double endTime, double dt)
+{
+    SimulationTime::Destroy();
+    SimulationTime* p_simulation_time = SimulationTime::Instance();
+    p_simulation_time->SetStartTime(mStartTime);
+
+    // As in AbstractCellBasedSimulation::Solve() when starting from mStartTime
+    unsigned num_time_steps = (unsigned) ((endTime - mStartTime)/dt + 0.5);
+    if (num_time_steps < mTimeStepsElapsed)
+    {
+        EXCEPTION("The checkpoint was taken after the end time");
+    }
+    p_simulation_time->SetEndTimeAndNumberOfTimeSteps(endTime, num_time_steps);
+    for (unsigned step=0; step<mTimeStepsElapsed; step++)
+    {
+        p_simulation_time->IncrementTimeOneStep();
+    }
+
+    // A different time step would put the schedules and the checkpointed SRN solve times out of step
+    if (fabs(p_simulation_time->GetTime() - mTime) > 1e-9*std::max(1.0, fabs(mTime)))
+    {
+        EXCEPTION("The checkpoint was taken with a different time step");
+    }
+
+    std::ostringstream time_stream(std::ios::out | std::ios::binary);
+    {
+        boost::archive::binary_oarchive output_arch(time_stream);
+        output_arch << static_cast<const SimulationTime&>(*p_simulation_time);
+    }
+    mSimulationTimeState = time_stream.str();
+}
+
+void TissueCheckpoint::ResumeSimulationTime() const
+{
+    if (mSimulationTimeState.empty())
+    {
+        EXCEPTION("RestoreSimulationTime() must be called before ResumeSimulationTime()");
+    }
+    std::istringstream time_stream(mSimulationTimeState, std::ios::in | std::ios::binary);
+    boost::archive::binary_iarchive input_arch(time_stream);
+    input_arch >> *SimulationTime::Instance();
+}
+
+MutableVertexMesh<2,2>* TissueCheckpoint::CreateMesh() const
+{
+    std::vector<Node<2>*> nodes;
+    for (unsigned node_index=0; node_index<mNodeIsBoundary.size(); node_index++)
+    {
+        nodes.push_back(new Node<2>(node_index, mNodeIsBoundary[node_index] != 0,
+                                    mNodeLocations[2*node_index], mNodeLocations[2*node_index + 1]));
+    }
+
+    std::vector<VertexElement<2,2>*> elements;
+    unsigned offset = 0;
+    for (unsigned elem_index=0; elem_index<mElementNumNodes.size(); elem_index++)
+    {
+        std::vector<Node<2>*> element_nodes;
+        for (unsigned j=0; j<mElementNumNodes[elem_index]; j++)
+        {
+            element_nodes.push_back(nodes[mElementNodeIndices[offset + j]]);
+        }
+        offset += mElementNumNodes[elem_index];
+        elements.push_back(new VertexElement<2,2>(elem_index, element_nodes));
+    }
+
+    MutableVertexMesh<2,2>* p_mesh = new MutableVertexMesh<2,2>(nodes, elements, mMeshParameters[0], mMeshParameters[1], mMeshParameters[2]);
+    p_mesh->SetCheckForInternalIntersections(mMeshParameters[3] != 0.0);
+    return p_mesh;
+}
+
+void TissueCheckpoint::CreateCells(std::vector<CellPtr>& rCells, std::vector<unsigned>& rLocationIndices) const
+{
+    MAKE_PTR(WildTypeCellMutationState, p_state);
+    MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+
+    rCells.clear();
+    rLocationIndices.clear();
+
+    // Cell IDs are assigned in order of construction, so cells removed before the checkpoint are stood in for by discarded cells
+    CellId::ResetMaxCellId();
+    unsigned next_id = 0;
+    for (unsigned i=0; i<mCellIds.size(); i++)
+    {
+        for (; next_id < mCellIds[i]; next_id++)
+        {
+            CellPtr p_discarded(new Cell(p_state, new NoCellCycleModel()));
+        }
+
+        NoCellCycleModel* p_cycle_model = new NoCellCycleModel();
+        p_cycle_model->SetBirthTime(mCellBirthTimes[i]);
+
+        ODESrnModel* p_srn_model = new ODESrnModel;
+        p_srn_model->SetInitialConditions(std::vector<double>(mSrnStates.begin() + mSrnStateSize*i,
+                                                              mSrnStates.begin() + mSrnStateSize*(i+1)));
+
+        CellPtr p_cell(new Cell(p_state, p_cycle_model, p_srn_model));
+        p_cell->SetCellProliferativeType(p_differentiated_type);
+        p_cell->InitialiseCellCycleModel();
+        assert(p_cell->GetCellId() == mCellIds[i]);
+        next_id++;
+
+        rCells.push_back(p_cell);
+        rLocationIndices.push_back(mLocationIndices[i]);
+    }
+}
+
+void TissueCheckpoint::RestoreCellStates(VertexBasedCellPopulation<2>& rCellPopulation) const
+{
+    std::map<unsigned, unsigned> index_of_cell_id;
+    for (unsigned i=0; i<mCellIds.size(); i++)
+    {
+        index_of_cell_id[mCellIds[i]] = i;
+    }
+
+    for (AbstractCellPopulation<2>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        std::map<unsigned, unsigned>::const_iterator it = index_of_cell_id.find(cell_iter->GetCellId());
+        if (it == index_of_cell_id.end())
+        {
+            EXCEPTION("Cell is not in the checkpoint");
+        }
+        unsigned i = it->second;
+
+        for (unsigned k=0; k<mCellDataKeys.size(); k++)
+        {
+            cell_iter->GetCellData()->SetItem(mCellDataKeys[k], mCellDataValues[mCellDataKeys.size()*i + k]);
+        }
+
+        ODESrnModel* p_model = dynamic_cast<ODESrnModel*>(cell_iter->GetSrnModel());
+        if (p_model == NULL)
+        {
+            EXCEPTION("TissueCheckpoint requires every cell to have an ODESrnModel");
+        }
+        const double* p_row = &mSrnStatistics[10*i];
+        p_model->RestoreState(&mSrnStates[mSrnStateSize*i], mSrnLastTimes[i],
+                              RunningStatistics((unsigned long)p_row[0], p_row[1], p_row[2], p_row[3], p_row[4]),
+                              RunningStatistics((unsigned long)p_row[5], p_row[6], p_row[7], p_row[8], p_row[9]));
+    }
+
+    std::istringstream rng_stream(mRandomNumberGeneratorState);
+    boost::archive::binary_iarchive input_arch(rng_stream);
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    input_arch & *p_gen;
+    input_arch & p_gen;
+}
+
+void TissueCheckpoint::RestoreComponents(const ComponentMap& rComponents) const
+{
+    if (rComponents.size() != mComponentStates.size())
+    {
+        EXCEPTION("The checkpoint has state for " << mComponentStates.size() << " writers and modifiers, not " << rComponents.size());
+    }
+    for (ComponentMap::const_iterator iter = rComponents.begin(); iter != rComponents.end(); ++iter)
+    {
+        std::map<std::string, std::string>::const_iterator state_iter = mComponentStates.find(iter->first);
+        if (state_iter == mComponentStates.end())
+        {
+            EXCEPTION("The checkpoint has no state for " + iter->first);
+        }
+        std::istringstream component_stream(state_iter->second, std::ios::in | std::ios::binary);
+        iter->second->LoadCheckpointState(component_stream);
+    }
+}
@@ -0,0 +1,234 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef TISSUECHECKPOINT_HPP_
+#define TISSUECHECKPOINT_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCheckpointable.hpp"
+#include "Cell.hpp"
+#include "MutableVertexMesh.hpp"
+#include "VertexBasedCellPopulation.hpp"
+
+/**
+ * Compact binary checkpoint of a 2D vertex tissue with coupled GTPase SRNs.
+ *
+ * A checkpoint holds a description of the scenario that produced it (see
+ * CheckScenario()), the simulation time (start time, time step and number
+ * of steps taken), the mesh (node locations, boundary flags, element node
+ * lists and rearrangement thresholds), every cell's ID, location index, birth
+ * time and CellData, the SRN state variables and last solve times of all
+ * cells as single contiguous blocks, the state of the random number generator
+ * and the state of any registered writers and modifiers. Arrays are written
+ * raw, in native byte order, rather than through per-object Boost archives.
+ *
+ * Restarting is done in four steps, in this order:
+ * RestoreSimulationTime(), CreateMesh(), CreateCells() and, once the
+ * population has been constructed from the mesh and cells,
+ * RestoreCellStates(). The cells are recreated as in
+ * multiCellsNoDivisionCoupledArea: wild type, differentiated, with a
+ * NoCellCycleModel and an ODESrnModel. Finally, from within Solve(),
+ * ResumeSimulationTime() and RestoreComponents() undo the time stepper reset
+ * done by Solve() and reload the writer and modifier state; CheckpointModifier
+ * does this in SetupSolve() when given the checkpoint.
+ */
+class TissueCheckpoint
+{
+public:
+
+    /** The writers and modifiers whose state is checkpointed, keyed by a unique name. */
+    typedef std::map<std::string, boost::shared_ptr<AbstractCheckpointable> > ComponentMap;
+
+private:
+
+    /** The simulation time at which the checkpoint was taken. */
+    double mTime;
+
+    /** The simulation time step. */
+    double mDt;
+
+    /** The start time of the checkpointed run. */
+    double mStartTime;
+
+    /** The number of time steps taken since mStartTime. */
+    unsigned mTimeStepsElapsed;
+
+    /** The settings that define the checkpointed tissue, as given to Save(). */
+    std::string mScenario;
+
+    /** The node locations, x0,y0,x1,y1,... */
+    std::vector<double> mNodeLocations;
+
+    /** Whether each node is a boundary node. */
+    std::vector<unsigned char> mNodeIsBoundary;
+
+    /** The number of nodes of each element. */
+    std::vector<unsigned> mElementNumNodes;
+
+    /** The global node indices of all elements, concatenated. */
+    std::vector<unsigned> mElementNodeIndices;
+
+    /** The mesh cell rearrangement threshold, T2 threshold and cell rearrangement ratio. */
+    std::vector<double> mMeshParameters;
+
+    /** The cell IDs, in increasing order. */
+    std::vector<unsigned> mCellIds;
+
+    /** The location index of each cell. */
+    std::vector<unsigned> mLocationIndices;
+
+    /** The birth time of each cell's cell-cycle model. */
+    std::vector<double> mCellBirthTimes;
+
+    /** The CellData keys, shared by all cells. */
+    std::vector<std::string> mCellDataKeys;
+
+    /** The CellData values of all cells, one row of mCellDataKeys.size() values per cell. */
+    std::vector<double> mCellDataValues;
+
+    /** The number of SRN state variables per cell. */
+    unsigned mSrnStateSize;
+
+    /** The SRN state variables of all cells, one row of mSrnStateSize values per cell. */
+    std::vector<double> mSrnStates;
+
+    /** The time to which each cell's SRN has been solved. */
+    std::vector<double> mSrnLastTimes;
+
+    /** The running statistics of G and of the target area of each cell, 10 values per cell. */
+    std::vector<double> mSrnStatistics;
+
+    /** The archived state of RandomNumberGenerator. */
+    std::string mRandomNumberGeneratorState;
+
+    /** The state of each checkpointed writer and modifier, keyed by name. */
+    std::map<std::string, std::string> mComponentStates;
+
+    /** The archived SimulationTime set up by RestoreSimulationTime(), reloaded by ResumeSimulationTime(). Not written. */
+    std::string mSimulationTimeState;
+
+    /** Private constructor, used by Save(). */
+    TissueCheckpoint();
+
+    /**
+     * Copy the state of a population and of the checkpointed components into this checkpoint.
+     *
+     * @param rCellPopulation the population
+     * @param rComponents the checkpointed writers and modifiers
+     * @param rScenario the settings that define the tissue
+     */
+    void Gather(VertexBasedCellPopulation<2>& rCellPopulation, const ComponentMap& rComponents,
+                const std::string& rScenario);
+
+    /**
+     * Write this checkpoint to a file.
+     *
+     * @param rFileName the full path of the file
+     * @return the number of bytes written
+     */
+    unsigned long Write(const std::string& rFileName) const;
+
+    /**
+     * Read this checkpoint from a file.
+     *
+     * @param rFileName the full path of the file
+     */
+    void Read(const std::string& rFileName);
+
+public:
+
+    /**
+     * Constructor, which reads a checkpoint from a file.
+     *
+     * @param rFileName the full path of the file
+     */
+    TissueCheckpoint(const std::string& rFileName);
+
+    /**
+     * Write a checkpoint of a population. The file is first written under a
+     * temporary name and then renamed, so an interrupted write leaves any
+     * previous checkpoint intact.
+     *
+     * @param rFileName the full path of the file
+     * @param rCellPopulation the population
+     * @param rComponents the checkpointed writers and modifiers
+     * @param rScenario the settings that define the tissue, checked by CheckScenario() on restart
+     * @return the number of bytes written
+     */
+    static unsigned long Save(const std::string& rFileName,
+                              VertexBasedCellPopulation<2>& rCellPopulation,
+                              const ComponentMap& rComponents=ComponentMap(),
+                              const std::string& rScenario="");
+
+    /** @return the simulation time at which the checkpoint was taken. */
+    double GetTime() const;
+
+    /**
+     * Check that the checkpoint was written by the scenario about to resume
+     * from it, so that a changed mesh size, seed or parameter does not
+     * silently restart the old tissue under the new settings.
+     *
+     * @param rScenario the settings that define the tissue, one "key = value" per line
+     */
+    void CheckScenario(const std::string& rScenario) const;
+
+    /**
+     * Reset SimulationTime to the state of the checkpointed run: the same
+     * start time and time step, with the same number of steps taken, so that
+     * cells created next and a subsequent OffLatticeSimulation::Solve()
+     * continue from the checkpoint time. The time step is recomputed from the
+     * end time and ideal time step the way Solve() does it, so the times are
+     * exactly those of an uninterrupted run with the same end time.
+     *
+     * @param endTime the end time of the simulation to be resumed
+     * @param dt the ideal time step of the simulation, as passed to SetDt()
+     */
+    void RestoreSimulationTime(double endTime, double dt);
+
+    /**
+     * Reload the SimulationTime set up by RestoreSimulationTime(). Solve()
+     * replaces the time stepper when it starts at a positive time, restarting
+     * the step count from 0, which would shift every schedule based on
+     * GetTimeStepsElapsed(); call this from within Solve(), before the first
+     * time step. SimulationTime is loaded in place, since Solve() holds a
+     * pointer to it.
+     */
+    void ResumeSimulationTime() const;
+
+    /**
+     * @return a new mesh identical to the checkpointed one (owned by the caller)
+     */
+    MutableVertexMesh<2,2>* CreateMesh() const;
+
+    /**
+     * Create the cells, with their original cell IDs.
+     *
+     * @param rCells filled with the cells
+     * @param rLocationIndices filled with the location index of each cell
+     */
+    void CreateCells(std::vector<CellPtr>& rCells, std::vector<unsigned>& rLocationIndices) const;
+
+    /**
+     * Restore the CellData and SRN state of every cell of a population created
+     * from CreateMesh() and CreateCells(), and the random number generator.
+     *
+     * @param rCellPopulation the population
+     */
+    void RestoreCellStates(VertexBasedCellPopulation<2>& rCellPopulation) const;
+
+    /**
+     * Load the state of each checkpointed writer and modifier. The components
+     * must be those of the checkpointed run, under the same names.
+     *
+     * @param rComponents the writers and modifiers
+     */
+    void RestoreComponents(const ComponentMap& rComponents) const;
+};
+
+#endif /*TISSUECHECKPOINT_HPP_*/
@@ -0,0 +1,424 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "TrajectoryComparison.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+/** Number of structural differences described in the report. */
+const unsigned MAX_REPORTED_DIFFERENCES = 20;
+
+/** The quantities compared, in report order. */
+const char* QUANTITIES[] = {"G", "area", "target_area", "topology"};
+
+/** Number of quantities compared. */
+const unsigned NUM_QUANTITIES = 4;
+
+/** The values of one cell in one frame of cell_data.xml. */
+struct CellValues
+{
+    /** G. */
+    double mG;
+    /** Area. */
+    double mArea;
+    /** Target area. */
+    double mTargetArea;
+};
+
+/** One frame of cell_data.xml. */
+struct CellDataFrame
+{
+    /** The time of the frame. */
+    double mTime;
+    /** The cells, keyed by cell ID. */
+    std::map<unsigned, CellValues> mCells;
+};
+
+/**
+ * @param rLine a line of cell_data.xml
+ * @param rName an attribute name
+ * @param rValue filled in with the value of the attribute
+ * @return whether the line has the attribute
+ */
+bool GetAttribute(const std::string& rLine, const std::string& rName, double& rValue)
+{
+    // Attributes are preceded by a space, so "area" does not match "target_area"
+    std::string::size_type start = rLine.find(" " + rName + "=\"");
+    if (start == std::string::npos)
+    {
+        return false;
+    }
+    rValue = std::atof(rLine.c_str() + start + rName.size() + 3);
+    return true;
+}
+
+/**
+ * Read every frame of a cell_data.xml file, filling in delta frames.
+ *
+ * @param rFileName the file
+ * @param rFrames filled in with the frames
+ */
+void ReadCellData(const std::string& rFileName, std::vector<CellDataFrame>& rFrames)
+{
+    std::ifstream file(rFileName.c_str());
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open " + rFileName);
+    }
+
+    std::map<unsigned, CellValues> previous_cells;
+    CellDataFrame frame;
+    bool in_frame = false;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::string::size_type first = line.find_first_not_of(" \t");
+        if (first == std::string::npos)
+        {
+            continue;
+        }
+        line = line.substr(first);
+
+        double value;
+        if (line.compare(0, 6, "<time ") == 0)
+        {
+            GetAttribute(line, "t", frame.mTime);
+            // A delta frame starts from the previous frame; other frames are complete
+            frame.mCells.clear();
+            if (line.find("keyframe=\"0\"") != std::string::npos)
+            {
+                frame.mCells = previous_cells;
+            }
+            in_frame = true;
+        }
+        else if (line.compare(0, 6, "<cell ") == 0 && in_frame && GetAttribute(line, "cell_id", value))
+        {
+            CellValues& r_values = frame.mCells[(unsigned)value];
+            GetAttribute(line, "G", r_values.mG);
+            GetAttribute(line, "area", r_values.mArea);
+            GetAttribute(line, "target_area", r_values.mTargetArea);
+        }
+        else if (line.compare(0, 9, "<removed ") == 0 && in_frame && GetAttribute(line, "cell_id", value))
+        {
+            frame.mCells.erase((unsigned)value);
+        }
+        else if (line.compare(0, 7, "</time>") == 0 && in_frame)
+        {
+            rFrames.push_back(frame);
+            previous_cells = frame.mCells;
+            in_frame = false;
+        }
+    }
+}
+
+/**
+ * Read the numbers of every data row of a topology_data.csv file.
+ *
+ * @param rFileName the file
+ * @param rRows filled in with the numbers of each row; the first is the time
+ */
+void ReadTopology(const std::string& rFileName, std::vector<std::vector<double> >& rRows)
+{
+    std::ifstream file(rFileName.c_str());
+    if (!file.is_open())
+    {
+        EXCEPTION("Could not open " + rFileName);
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        // Fields are separated by commas; the distributions are space separated n:count pairs
+        for (unsigned i=0; i<line.size(); i++)
+        {
+            if (line[i] == ',' || line[i] == ':')
+            {
+                line[i] = ' ';
+            }
+        }
+        // Parsed with strtod rather than >> so that an undefined (nan) correlation is read too
+        std::vector<double> row;
+        std::istringstream tokens(line);
+        std::string token;
+        while (tokens >> token)
+        {
+            char* p_end;
+            double value = std::strtod(token.c_str(), &p_end);
+            if (*p_end != '\0')
+            {
+                break;
+            }
+            row.push_back(value);
+        }
+        if (!row.empty())
+        {
+            rRows.push_back(row);
+        }
+    }
+}
+}
+
+TrajectoryComparison::TrajectoryComparison()
+    : mNumStructuralDifferences(0)
+{
+    ErrorNorms empty_norms = {0, 0, 0.0, 0.0, 0.0, 0.0, 0};
+    for (unsigned q=0; q<NUM_QUANTITIES; q++)
+    {
+        mAbsoluteTolerances[QUANTITIES[q]] = 1e-6;
+        mRelativeTolerances[QUANTITIES[q]] = 1e-5;
+        mNorms[QUANTITIES[q]] = empty_norms;
+    }
+}
+
+void TrajectoryComparison::SetTolerance(const std::string& rQuantity, double absolute, double relative)
+{
+    if (mNorms.find(rQuantity) == mNorms.end())
+    {
+        EXCEPTION("Unknown quantity " + rQuantity);
+    }
+    if (absolute < 0.0 || relative < 0.0)
+    {
+        EXCEPTION("Tolerances must be non-negative");
+    }
+    mAbsoluteTolerances[rQuantity] = absolute;
+    mRelativeTolerances[rQuantity] = relative;
+}
+
+double TrajectoryComparison::GetAbsoluteTolerance(const std::string& rQuantity) const
+{
+    std::map<std::string, double>::const_iterator it = mAbsoluteTolerances.find(rQuantity);
+    if (it == mAbsoluteTolerances.end())
+    {
+        EXCEPTION("Unknown quantity " + rQuantity);
+    }
+    return it->second;
+}
+
+double TrajectoryComparison::GetRelativeTolerance(const std::string& rQuantity) const
+{
+    std::map<std::string, double>::const_iterator it = mRelativeTolerances.find(rQuantity);
+    if (it == mRelativeTolerances.end())
+    {
+        EXCEPTION("Unknown quantity " + rQuantity);
+    }
+    return it->second;
+}
+
+void TrajectoryComparison::CompareValue(const std::string& rQuantity, double reference, double candidate, double time, unsigned index)
+{
+    ErrorNorms& r_norms = mNorms[rQuantity];
+    if (reference != reference && candidate != candidate)
+    {
+        // Undefined in both runs, e.g. a topology correlation over constant data
+        r_norms.mNumCompared++;
+        return;
+    }
+    double error = fabs(candidate - reference);
+    r_norms.mNumCompared++;
+    r_norms.mSumSquaredError += error*error;
+    if (error > mAbsoluteTolerances[rQuantity] + mRelativeTolerances[rQuantity]*fabs(reference)
+        || candidate != candidate || reference != reference)
+    {
+        r_norms.mNumFailed++;
+    }
+    if (error > r_norms.mMaxAbsoluteError)
+    {
+        r_norms.mMaxAbsoluteError = error;
+        r_norms.mWorstTime = time;
+        r_norms.mWorstIndex = index;
+    }
+    if (reference != 0.0 && error/fabs(reference) > r_norms.mMaxRelativeError)
+    {
+        r_norms.mMaxRelativeError = error/fabs(reference);
+    }
+}
+
+void TrajectoryComparison::AddStructuralDifference(const std::string& rDescription)
+{
+    if (mStructuralDifferences.size() < MAX_REPORTED_DIFFERENCES)
+    {
+        mStructuralDifferences.push_back(rDescription);
+    }
+    mNumStructuralDifferences++;
+}
+
+void TrajectoryComparison::CompareCellData(const std::string& rReferenceFile, const std::string& rCandidateFile)
+{
+    std::vector<CellDataFrame> reference_frames;
+    std::vector<CellDataFrame> candidate_frames;
+    ReadCellData(rReferenceFile, reference_frames);
+    ReadCellData(rCandidateFile, candidate_frames);
+
+    if (reference_frames.size() != candidate_frames.size())
+    {
+        std::stringstream description;
+        description << "cell_data.xml: " << reference_frames.size() << " reference frames, "
+                    << candidate_frames.size() << " candidate frames";
+        AddStructuralDifference(description.str());
+    }
+
+    unsigned num_frames = std::min(reference_frames.size(), candidate_frames.size());
+    for (unsigned f=0; f<num_frames; f++)
+    {
+        const CellDataFrame& r_reference = reference_frames[f];
+        const CellDataFrame& r_candidate = candidate_frames[f];
+        if (fabs(r_reference.mTime - r_candidate.mTime) > 1e-9*(1.0 + fabs(r_reference.mTime)))
+        {
+            std::stringstream description;
+            description << "cell_data.xml frame " << f << ": reference time " << r_reference.mTime
+                        << ", candidate time " << r_candidate.mTime;
+            AddStructuralDifference(description.str());
+            continue;
+        }
+
+        for (std::map<unsigned, CellValues>::const_iterator it = r_reference.mCells.begin();
+             it != r_reference.mCells.end();
+             ++it)
+        {
+            std::map<unsigned, CellValues>::const_iterator candidate_it = r_candidate.mCells.find(it->first);
+            if (candidate_it == r_candidate.mCells.end())
+            {
+                std::stringstream description;
+                description << "cell_data.xml t=" << r_reference.mTime << ": cell " << it->first << " missing from candidate";
+                AddStructuralDifference(description.str());
+                continue;
+            }
+            CompareValue("G", it->second.mG, candidate_it->second.mG, r_reference.mTime, it->first);
+            CompareValue("area", it->second.mArea, candidate_it->second.mArea, r_reference.mTime, it->first);
+            CompareValue("target_area", it->second.mTargetArea, candidate_it->second.mTargetArea, r_reference.mTime, it->first);
+        }
+        for (std::map<unsigned, CellValues>::const_iterator it = r_candidate.mCells.begin();
+             it != r_candidate.mCells.end();
+             ++it)
+        {
+            if (r_reference.mCells.find(it->first) == r_reference.mCells.end())
+            {
+                std::stringstream description;
+                description << "cell_data.xml t=" << r_reference.mTime << ": cell " << it->first << " not in reference";
+                AddStructuralDifference(description.str());
+            }
+        }
+    }
+}
+
+void TrajectoryComparison::CompareTopology(const std::string& rReferenceFile, const std::string& rCandidateFile)
+{
+    std::vector<std::vector<double> > reference_rows;
+    std::vector<std::vector<double> > candidate_rows;
+    ReadTopology(rReferenceFile, reference_rows);
+    ReadTopology(rCandidateFile, candidate_rows);
+
+    if (reference_rows.size() != candidate_rows.size())
+    {
+        std::stringstream description;
+        description << "topology_data.csv: " << reference_rows.size() << " reference rows, "
+                    << candidate_rows.size() << " candidate rows";
+        AddStructuralDifference(description.str());
+    }
+
+    unsigned num_rows = std::min(reference_rows.size(), candidate_rows.size());
+    for (unsigned r=0; r<num_rows; r++)
+    {
+        const std::vector<double>& r_reference = reference_rows[r];
+        const std::vector<double>& r_candidate = candidate_rows[r];
+        if (r_reference.size() != r_candidate.size())
+        {
+            std::stringstream description;
+            description << "topology_data.csv t=" << r_reference[0] << ": " << r_reference.size()
+                        << " reference values, " << r_candidate.size() << " candidate values";
+            AddStructuralDifference(description.str());
+            continue;
+        }
+        for (unsigned i=1; i<r_reference.size(); i++)
+        {
+            CompareValue("topology", r_reference[i], r_candidate[i], r_reference[0], i);
+        }
+    }
+}
+
+TrajectoryComparison::ErrorNorms TrajectoryComparison::GetNorms(const std::string& rQuantity) const
+{
+    std::map<std::string, ErrorNorms>::const_iterator it = mNorms.find(rQuantity);
+    if (it == mNorms.end())
+    {
+        EXCEPTION("Unknown quantity " + rQuantity);
+    }
+    return it->second;
+}
+
+bool TrajectoryComparison::Passed() const
+{
+    if (mNumStructuralDifferences > 0)
+    {
+        return false;
+    }
+    for (std::map<std::string, ErrorNorms>::const_iterator it = mNorms.begin(); it != mNorms.end(); ++it)
+    {
+        if (it->second.mNumFailed > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TrajectoryComparison::WriteReport(std::ostream& rStream) const
+{
+    std::ios::fmtflags flags = rStream.flags();
+    std::streamsize precision = rStream.precision(4);
+    rStream << std::scientific;
+
+    rStream << std::left << std::setw(14) << "quantity" << std::right
+            << std::setw(12) << "compared" << std::setw(10) << "failed"
+            << std::setw(12) << "abs_tol" << std::setw(12) << "rel_tol"
+            << std::setw(12) << "max_abs" << std::setw(12) << "rms" << std::setw(12) << "max_rel"
+            << "  worst at\n";
+    for (unsigned q=0; q<NUM_QUANTITIES; q++)
+    {
+        const std::string quantity = QUANTITIES[q];
+        const ErrorNorms& r_norms = mNorms.find(quantity)->second;
+        double rms = r_norms.mNumCompared > 0 ? sqrt(r_norms.mSumSquaredError/r_norms.mNumCompared) : 0.0;
+        rStream << std::left << std::setw(14) << quantity << std::right
+                << std::setw(12) << r_norms.mNumCompared << std::setw(10) << r_norms.mNumFailed
+                << std::setw(12) << mAbsoluteTolerances.find(quantity)->second
+                << std::setw(12) << mRelativeTolerances.find(quantity)->second
+                << std::setw(12) << r_norms.mMaxAbsoluteError << std::setw(12) << rms
+                << std::setw(12) << r_norms.mMaxRelativeError;
+        if (r_norms.mMaxAbsoluteError > 0.0)
+        {
+            rStream << "  t=" << r_norms.mWorstTime << (quantity == "topology" ? " column " : " cell ") << r_norms.mWorstIndex;
+        }
+        rStream << "\n";
+    }
+
+    if (mNumStructuralDifferences > 0)
+    {
+        rStream << "\n" << mNumStructuralDifferences << " structural difference(s):\n";
+        for (unsigned i=0; i<mStructuralDifferences.size(); i++)
+        {
+            rStream << "  " << mStructuralDifferences[i] << "\n";
+        }
+        if (mNumStructuralDifferences > mStructuralDifferences.size())
+        {
+            rStream << "  ...\n";
+        }
+    }
+    rStream << "\n" << (Passed() ? "PASSED" : "FAILED") << "\n";
+
+    rStream.precision(precision);
+    rStream.flags(flags);
+}
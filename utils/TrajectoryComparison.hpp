@@ -0,0 +1,151 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef TRAJECTORYCOMPARISON_HPP_
+#define TRAJECTORYCOMPARISON_HPP_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Compares the output of a run against a stored reference run.
+ *
+ * Per-cell G, area and target area trajectories are read from cell_data.xml
+ * (XMLCellWriter; delta-encoded files are filled in as by
+ * scripts/reconstruct_cell_data.py) and matched by frame and cell ID. Every
+ * number of each row of topology_data.csv (TopologyWriter) is compared in
+ * order as the "topology" quantity.
+ *
+ * A candidate value c passes against the reference value r if
+ * |c - r| <= absolute + relative*|r|, with per-quantity tolerances. The
+ * writers use the default stream precision of 6 significant digits, so
+ * relative tolerances below about 1e-5 flag rounding differences. Frames
+ * or cells present in only one of the runs, and topology rows of different
+ * lengths, are structural differences and always fail.
+ */
+class TrajectoryComparison
+{
+public:
+
+    /** Error norms of one quantity. */
+    struct ErrorNorms
+    {
+        /** Number of values compared. */
+        unsigned long mNumCompared;
+        /** Number of values outside the tolerance. */
+        unsigned long mNumFailed;
+        /** Maximum absolute error. */
+        double mMaxAbsoluteError;
+        /** Sum of squared absolute errors, for the RMS error. */
+        double mSumSquaredError;
+        /** Maximum relative error, relative to the reference value. */
+        double mMaxRelativeError;
+        /** Time of the maximum absolute error. */
+        double mWorstTime;
+        /** Cell ID (or position in the row for topology) of the maximum absolute error. */
+        unsigned mWorstIndex;
+    };
+
+private:
+
+    /** Absolute tolerance of each quantity. */
+    std::map<std::string, double> mAbsoluteTolerances;
+
+    /** Relative tolerance of each quantity. */
+    std::map<std::string, double> mRelativeTolerances;
+
+    /** Error norms of each quantity. */
+    std::map<std::string, ErrorNorms> mNorms;
+
+    /** Descriptions of the first structural differences found. */
+    std::vector<std::string> mStructuralDifferences;
+
+    /** Total number of structural differences found. */
+    unsigned mNumStructuralDifferences;
+
+    /**
+     * Compare one value and update the norms of its quantity. A value that
+     * is NaN in both runs matches; NaN in only one of them is a failure.
+     *
+     * @param rQuantity the quantity
+     * @param reference the reference value
+     * @param candidate the candidate value
+     * @param time the time of the value
+     * @param index the cell ID or position of the value
+     */
+    void CompareValue(const std::string& rQuantity, double reference, double candidate, double time, unsigned index);
+
+    /**
+     * Record a structural difference.
+     *
+     * @param rDescription the description
+     */
+    void AddStructuralDifference(const std::string& rDescription);
+
+public:
+
+    /**
+     * Constructor. Every quantity has an absolute tolerance of 1e-6 and a
+     * relative tolerance of 1e-5.
+     */
+    TrajectoryComparison();
+
+    /**
+     * Set the tolerances of one quantity.
+     *
+     * @param rQuantity one of "G", "area", "target_area" or "topology"
+     * @param absolute the absolute tolerance
+     * @param relative the relative tolerance
+     */
+    void SetTolerance(const std::string& rQuantity, double absolute, double relative);
+
+    /**
+     * @param rQuantity the quantity
+     * @return the absolute tolerance of the quantity
+     */
+    double GetAbsoluteTolerance(const std::string& rQuantity) const;
+
+    /**
+     * @param rQuantity the quantity
+     * @return the relative tolerance of the quantity
+     */
+    double GetRelativeTolerance(const std::string& rQuantity) const;
+
+    /**
+     * Compare per-cell trajectories.
+     *
+     * @param rReferenceFile the reference cell_data.xml
+     * @param rCandidateFile the candidate cell_data.xml
+     */
+    void CompareCellData(const std::string& rReferenceFile, const std::string& rCandidateFile);
+
+    /**
+     * Compare topology statistics.
+     *
+     * @param rReferenceFile the reference topology_data.csv
+     * @param rCandidateFile the candidate topology_data.csv
+     */
+    void CompareTopology(const std::string& rReferenceFile, const std::string& rCandidateFile);
+
+    /**
+     * @param rQuantity the quantity
+     * @return the error norms of the quantity so far
+     */
+    ErrorNorms GetNorms(const std::string& rQuantity) const;
+
+    /** @return whether every value was within tolerance and there were no structural differences. */
+    bool Passed() const;
+
+    /**
+     * Write a summary of the error norms and structural differences.
+     *
+     * @param rStream the stream
+     */
+    void WriteReport(std::ostream& rStream) const;
+};
+
+#endif /*TRAJECTORYCOMPARISON_HPP_*/
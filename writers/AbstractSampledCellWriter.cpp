@@ -0,0 +1,66 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "AbstractSampledCellWriter.hpp"
+#include "MemoryFootprint.hpp"
+
+#include <cstdio>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::AbstractSampledCellWriter(const std::string& rFileName)
+    : AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>(rFileName)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple)
+{
+    mSamplingSchedule.SetSamplingTimestepMultiple(samplingTimestepMultiple);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::SetSamplingWindow(double startTime, double endTime)
+{
+    mSamplingSchedule.SetSamplingWindow(startTime, endTime);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::IsSamplingTime() const
+{
+    return mSamplingSchedule.IsSamplingTime();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp()
+{
+    if (IsSamplingTime())
+    {
+        AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline()
+{
+    if (IsSamplingTime())
+    {
+        AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned long AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes() const
+{
+    // std::filebuf allocates a BUFSIZ buffer when the file is opened and frees it when it is closed
+    return (this->mpOutStream && this->mpOutStream->is_open()) ? MemoryFootprint::HeapBlockBytes(BUFSIZ) : 0;
+}
+
+// Explicit instantiation
+template class AbstractSampledCellWriter<1,1>;
+template class AbstractSampledCellWriter<1,2>;
+template class AbstractSampledCellWriter<2,2>;
+template class AbstractSampledCellWriter<1,3>;
+template class AbstractSampledCellWriter<2,3>;
+template class AbstractSampledCellWriter<3,3>;
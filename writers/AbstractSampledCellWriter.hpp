@@ -0,0 +1,91 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef ABSTRACTSAMPLEDCELLWRITER_HPP_
+#define ABSTRACTSAMPLEDCELLWRITER_HPP_
+
+#include "ChasteSerialization.hpp"
+#include "ClassIsAbstract.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include "AbstractCellWriter.hpp"
+#include "WriterSamplingSchedule.hpp"
+
+/**
+ * A cell writer with its own sampling timestep multiple and time window, so that
+ * cheap and expensive outputs can be written at different cadences.
+ *
+ * Time stamps and newlines are only written at this writer's sampling times;
+ * concrete writers must return early from VisitCell() when IsSamplingTime() is false.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class AbstractSampledCellWriter : public AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+        archive & mSamplingSchedule;
+    }
+
+    /** When this writer writes output. */
+    WriterSamplingSchedule mSamplingSchedule;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rFileName the name of the file to write to
+     */
+    AbstractSampledCellWriter(const std::string& rFileName);
+
+    /**
+     * Set the number of time steps between outputs of this writer.
+     *
+     * @param samplingTimestepMultiple the sampling timestep multiple
+     */
+    void SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple);
+
+    /**
+     * Restrict the output of this writer to a time window.
+     *
+     * @param startTime the first time at which output may be written
+     * @param endTime the last time at which output may be written
+     */
+    void SetSamplingWindow(double startTime, double endTime);
+
+    /** @return whether this writer writes output at the current simulation time. */
+    bool IsSamplingTime() const;
+
+    /**
+     * Overridden WriteTimeStamp() method, which only writes at sampling times.
+     */
+    virtual void WriteTimeStamp();
+
+    /**
+     * Overridden WriteNewline() method, which only writes at sampling times.
+     */
+    virtual void WriteNewline();
+
+    /**
+     * @return the heap bytes held by this writer between samples: by default
+     *     the buffer of its output file while it is open
+     */
+    virtual unsigned long GetBufferedBytes() const;
+};
+
+TEMPLATED_CLASS_IS_ABSTRACT_2_UNSIGNED(AbstractSampledCellWriter)
+
+#endif /*ABSTRACTSAMPLEDCELLWRITER_HPP_*/
@@ -0,0 +1,66 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "AbstractSampledPopulationWriter.hpp"
+#include "MemoryFootprint.hpp"
+
+#include <cstdio>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::AbstractSampledPopulationWriter(const std::string& rFileName)
+    : AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>(rFileName)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple)
+{
+    mSamplingSchedule.SetSamplingTimestepMultiple(samplingTimestepMultiple);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::SetSamplingWindow(double startTime, double endTime)
+{
+    mSamplingSchedule.SetSamplingWindow(startTime, endTime);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::IsSamplingTime() const
+{
+    return mSamplingSchedule.IsSamplingTime();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp()
+{
+    if (IsSamplingTime())
+    {
+        AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline()
+{
+    if (IsSamplingTime())
+    {
+        AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned long AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes() const
+{
+    // std::filebuf allocates a BUFSIZ buffer when the file is opened and frees it when it is closed
+    return (this->mpOutStream && this->mpOutStream->is_open()) ? MemoryFootprint::HeapBlockBytes(BUFSIZ) : 0;
+}
+
+// Explicit instantiation
+template class AbstractSampledPopulationWriter<1,1>;
+template class AbstractSampledPopulationWriter<1,2>;
+template class AbstractSampledPopulationWriter<2,2>;
+template class AbstractSampledPopulationWriter<1,3>;
+template class AbstractSampledPopulationWriter<2,3>;
+template class AbstractSampledPopulationWriter<3,3>;
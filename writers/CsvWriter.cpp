@@ -7,6 +7,7 @@
  */
 
 #include "CsvWriter.hpp"
+#include "GTPaseProfiler.hpp"
 #include "AbstractCellPopulation.hpp"
 #include "AbstractCellPopulationWriter.hpp"
 #include "MeshBasedCellPopulation.hpp"
@@ -19,7 +20,7 @@
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CsvWriter<ELEMENT_DIM, SPACE_DIM>::CsvWriter()
-    : AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>("data.csv")
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("data.csv")
 {
 }
 
@@ -47,6 +48,10 @@ void CsvWriter<ELEMENT_DIM, SPACE_DIM>::VisitAnyPopulation(AbstractCellPopulatio
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
 
     pCellPopulation->Update();
 
@@ -61,23 +66,45 @@ void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DI
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
     VisitAnyPopulation(pCellPopulation);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
     VisitAnyPopulation(pCellPopulation);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CsvWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(CSV_WRITER);
+    GTPASE_PROFILE_COUNT(CSV_WRITER, pCellPopulation->GetNumRealCells());
+
     pCellPopulation->Update();
 
     unsigned num_cells = pCellPopulation->GetNumRealCells();
@@ -36,7 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CSVWRITER_HPP_
 #define CSVWRITER_HPP_
 
-#include "AbstractCellPopulationWriter.hpp"
+#include "AbstractSampledPopulationWriter.hpp"
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 
@@ -47,7 +47,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * The output file is called cellpopulationadjacency.dat by default.
  */
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-class CsvWriter : public AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>
+class CsvWriter : public AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>
 {
 private:
     /** Needed for serialization. */
@@ -61,7 +61,7 @@ private:
     template<class Archive>
     void serialize(Archive & archive, const unsigned int version)
     {
-        archive & boost::serialization::base_object<AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+        archive & boost::serialization::base_object<AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
     }
 
 public:
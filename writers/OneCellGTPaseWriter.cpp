@@ -7,6 +7,7 @@
  */
 
 #include "OneCellGTPaseWriter.hpp"
+#include "GTPaseProfiler.hpp"
 #include "AbstractCellPopulation.hpp"
 #include "AbstractCellPopulationWriter.hpp"
 #include "MeshBasedCellPopulation.hpp"
@@ -18,7 +19,7 @@
 #include <VertexBasedCellPopulation.hpp>
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::OneCellGTPaseWriter()
-    : AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM>("OneCellData.csv")
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("OneCellData.csv")
 {
 }
 
@@ -46,6 +47,10 @@ void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::VisitAnyPopulation(AbstractCel
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
 
     pCellPopulation->Update();
 
@@ -60,23 +65,44 @@ void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
     VisitAnyPopulation(pCellPopulation);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
     VisitAnyPopulation(pCellPopulation);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void OneCellGTPaseWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(ONE_CELL_WRITER);
+    GTPASE_PROFILE_COUNT(ONE_CELL_WRITER, pCellPopulation->GetNumRealCells());
 	
     pCellPopulation->Update();
 
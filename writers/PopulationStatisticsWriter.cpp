@@ -0,0 +1,272 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "PopulationStatisticsWriter.hpp"
+#include "GTPaseProfiler.hpp"
+#include "AbstractCellPopulation.hpp"
+#include "AbstractCellPopulationWriter.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "CaBasedCellPopulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+/**
+ * @param pCellPopulation a vertex population
+ * @param pCell a cell of the population
+ * @return the perimeter of the cell's element
+ */
+template<unsigned DIM>
+double GetCellPerimeter(VertexBasedCellPopulation<DIM>* pCellPopulation, CellPtr pCell)
+{
+    return pCellPopulation->rGetMesh().GetSurfaceAreaOfElement(pCellPopulation->GetLocationIndexUsingCell(pCell));
+}
+
+/**
+ * @param pCellPopulation a population whose cells have no perimeter
+ * @param pCell a cell of the population
+ * @return NaN
+ */
+template<class POPULATION>
+double GetCellPerimeter(POPULATION* pCellPopulation, CellPtr pCell)
+{
+    return std::numeric_limits<double>::quiet_NaN();
+}
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::PopulationStatisticsWriter()
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("population_statistics.csv")
+{
+    mQuantityNames.push_back("G");
+    mQuantityNames.push_back("area");
+    mQuantityNames.push_back("target_area");
+    mQuantityNames.push_back("perimeter");
+
+    // G lies in [0,2]; areas are around 1 and perimeters around 3.7 for unit hexagons
+    mHistogramMins.push_back(0.0); mHistogramMaxs.push_back(2.0);
+    mHistogramMins.push_back(0.0); mHistogramMaxs.push_back(2.0);
+    mHistogramMins.push_back(0.0); mHistogramMaxs.push_back(2.0);
+    mHistogramMins.push_back(0.0); mHistogramMaxs.push_back(6.0);
+    mHistogramNumBins.assign(mQuantityNames.size(), 20);
+
+    mQuantiles.push_back(0.05);
+    mQuantiles.push_back(0.25);
+    mQuantiles.push_back(0.5);
+    mQuantiles.push_back(0.75);
+    mQuantiles.push_back(0.95);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::SetHistogramRange(const std::string& rQuantity, double min, double max, unsigned numBins)
+{
+    if (max <= min || numBins == 0)
+    {
+        EXCEPTION("Invalid histogram range for " + rQuantity);
+    }
+    for (unsigned i=0; i<mQuantityNames.size(); i++)
+    {
+        if (mQuantityNames[i] == rQuantity)
+        {
+            mHistogramMins[i] = min;
+            mHistogramMaxs[i] = max;
+            mHistogramNumBins[i] = numBins;
+            return;
+        }
+    }
+    EXCEPTION("Unknown quantity " + rQuantity);
+}
+
+// Writing CSV Header
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+    *this->mpOutStream << "# TimeStamp";
+    for (unsigned i=0; i<mQuantityNames.size(); i++)
+    {
+        const std::string& r_name = mQuantityNames[i];
+        *this->mpOutStream << "," << r_name << "_count," << r_name << "_mean," << r_name << "_variance,"
+                           << r_name << "_min," << r_name << "_max";
+        for (unsigned q=0; q<mQuantiles.size(); q++)
+        {
+            *this->mpOutStream << "," << r_name << "_q" << (unsigned)(100*mQuantiles[q] + 0.5);
+        }
+        FixedBinHistogram histogram(mHistogramMins[i], mHistogramMaxs[i], mHistogramNumBins[i]);
+        for (unsigned bin=0; bin<histogram.GetNumBins(); bin++)
+        {
+            *this->mpOutStream << "," << r_name << "_bin" << histogram.GetBinLowerEdge(bin);
+        }
+    }
+    *this->mpOutStream << "\n";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+template<class POPULATION>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::WriteStatistics(POPULATION* pCellPopulation, bool hasPerimeters)
+{
+    unsigned num_quantities = mQuantityNames.size();
+
+    // G, area and target area come from CellData; a quantity is undefined if the cells do not carry it
+    std::vector<bool> is_defined(num_quantities, false);
+    if (pCellPopulation->Begin() != pCellPopulation->End())
+    {
+        std::vector<std::string> keys = (*pCellPopulation->Begin())->GetCellData()->GetKeys();
+        is_defined[0] = std::find(keys.begin(), keys.end(), "G") != keys.end();
+        is_defined[1] = std::find(keys.begin(), keys.end(), "volume") != keys.end();
+        is_defined[2] = std::find(keys.begin(), keys.end(), "target area") != keys.end();
+        is_defined[3] = hasPerimeters;
+    }
+
+    std::vector<RunningStatistics> statistics(num_quantities);
+    std::vector<FixedBinHistogram> histograms;
+    std::vector<std::vector<P2QuantileEstimator> > quantiles(num_quantities);
+    for (unsigned i=0; i<num_quantities; i++)
+    {
+        histograms.push_back(FixedBinHistogram(mHistogramMins[i], mHistogramMaxs[i], mHistogramNumBins[i]));
+        for (unsigned q=0; q<mQuantiles.size(); q++)
+        {
+            quantiles[i].push_back(P2QuantileEstimator(mQuantiles[q]));
+        }
+    }
+
+    // Single pass over the cells
+    std::vector<double> values(num_quantities);
+    for (typename POPULATION::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        boost::shared_ptr<CellData> p_cell_data = cell_iter->GetCellData();
+        values[0] = is_defined[0] ? p_cell_data->GetItem("G") : 0.0;
+        values[1] = is_defined[1] ? p_cell_data->GetItem("volume") : 0.0;
+        values[2] = is_defined[2] ? p_cell_data->GetItem("target area") : 0.0;
+        values[3] = is_defined[3] ? GetCellPerimeter(pCellPopulation, *cell_iter) : 0.0;
+
+        for (unsigned i=0; i<num_quantities; i++)
+        {
+            if (!is_defined[i])
+            {
+                continue;
+            }
+            statistics[i].Add(values[i]);
+            histograms[i].Add(values[i]);
+            for (unsigned q=0; q<quantiles[i].size(); q++)
+            {
+                quantiles[i][q].Add(values[i]);
+            }
+        }
+    }
+
+    // Undefined quantities keep their columns, with a count of 0 and NaN everywhere else
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (unsigned i=0; i<num_quantities; i++)
+    {
+        if (!is_defined[i])
+        {
+            *this->mpOutStream << ",0," << nan << "," << nan << "," << nan << "," << nan;
+            for (unsigned q=0; q<quantiles[i].size() + histograms[i].GetNumBins(); q++)
+            {
+                *this->mpOutStream << "," << nan;
+            }
+            continue;
+        }
+
+        *this->mpOutStream << "," << statistics[i].GetCount()
+                           << "," << statistics[i].GetMean()
+                           << "," << statistics[i].GetVariance()
+                           << "," << statistics[i].GetMin()
+                           << "," << statistics[i].GetMax();
+        for (unsigned q=0; q<quantiles[i].size(); q++)
+        {
+            *this->mpOutStream << "," << quantiles[i][q].GetQuantile();
+        }
+        const std::vector<unsigned>& r_counts = histograms[i].rGetCounts();
+        for (unsigned bin=0; bin<r_counts.size(); bin++)
+        {
+            *this->mpOutStream << "," << r_counts[bin];
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::VisitAnyPopulation(AbstractCellPopulation<SPACE_DIM, SPACE_DIM>* pCellPopulation)
+{
+    WriteStatistics(pCellPopulation, false);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    WriteStatistics(pCellPopulation, false);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void PopulationStatisticsWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(POPULATION_STATISTICS_WRITER);
+    GTPASE_PROFILE_COUNT(POPULATION_STATISTICS_WRITER, pCellPopulation->GetNumRealCells());
+
+    WriteStatistics(pCellPopulation, true);
+}
+
+// Explicit instantiation
+template class PopulationStatisticsWriter<1,1>;
+template class PopulationStatisticsWriter<1,2>;
+template class PopulationStatisticsWriter<2,2>;
+template class PopulationStatisticsWriter<1,3>;
+template class PopulationStatisticsWriter<2,3>;
+template class PopulationStatisticsWriter<3,3>;
+
+#include "SerializationExportWrapperForCpp.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(PopulationStatisticsWriter)
@@ -0,0 +1,154 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef POPULATIONSTATISTICSWRITER_HPP_
+#define POPULATIONSTATISTICSWRITER_HPP_
+
+#include "AbstractSampledPopulationWriter.hpp"
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <string>
+#include <vector>
+#include "RunningStatistics.hpp"
+#include "P2QuantileEstimator.hpp"
+#include "FixedBinHistogram.hpp"
+
+/**
+ * A class written using the visitor pattern for writing distribution statistics
+ * of G, area, target area and perimeter over the cell population.
+ *
+ * Each sample is computed in a single pass over the cells: count, mean and
+ * variance (Welford), min/max, P-squared estimates of the 5th, 25th, 50th, 75th
+ * and 95th percentiles, and a fixed-bin histogram per quantity.
+ *
+ * The output file is called population_statistics.csv by default.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class PopulationStatisticsWriter : public AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+        archive & mHistogramMins;
+        archive & mHistogramMaxs;
+        archive & mHistogramNumBins;
+    }
+
+    /** Names of the quantities summarised, in output order. */
+    std::vector<std::string> mQuantityNames;
+
+    /** Lower edge of the histogram of each quantity. */
+    std::vector<double> mHistogramMins;
+
+    /** Upper edge of the histogram of each quantity. */
+    std::vector<double> mHistogramMaxs;
+
+    /** Number of histogram bins of each quantity. */
+    std::vector<unsigned> mHistogramNumBins;
+
+    /** The quantiles estimated for each quantity. */
+    std::vector<double> mQuantiles;
+
+    /**
+     * Compute and write the statistics of one sample. G, area and target
+     * area are taken from the CellData items "G", "volume" and "target area"
+     * and the perimeter from the vertex mesh. The columns of quantities that
+     * are not defined for the population hold a count of 0 and NaN, so every
+     * row matches the header.
+     *
+     * @param pCellPopulation a pointer to the population
+     * @param hasPerimeters whether the cells have perimeters, i.e. the population is vertex based
+     */
+    template<class POPULATION>
+    void WriteStatistics(POPULATION* pCellPopulation, bool hasPerimeters);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    PopulationStatisticsWriter();
+
+    /**
+     * Write the column names, which depend on the histogram settings.
+     *
+     * @param pCellPopulation a pointer to the population
+     */
+    void WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Set the histogram range of one quantity.
+     *
+     * @param rQuantity one of "G", "area", "target_area" or "perimeter"
+     * @param min the lower edge of the first bin
+     * @param max the upper edge of the last bin
+     * @param numBins the number of bins
+     */
+    void SetHistogramRange(const std::string& rQuantity, double min, double max, unsigned numBins);
+
+    /**
+     * Visit the population and write the statistics, with NaN for the perimeter.
+     *
+     * @param pCellPopulation a pointer to the population to visit.
+     */
+    void VisitAnyPopulation(AbstractCellPopulation<SPACE_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the statistics, with NaN for the perimeter.
+     *
+     * @param pCellPopulation a pointer to the MeshBasedCellPopulation to visit.
+     */
+    virtual void Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the statistics, with NaN for the perimeter.
+     *
+     * @param pCellPopulation a pointer to the CaBasedCellPopulation to visit.
+     */
+    virtual void Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the statistics, with NaN for the perimeter.
+     *
+     * @param pCellPopulation a pointer to the NodeBasedCellPopulation to visit.
+     */
+    virtual void Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the statistics, with NaN for the perimeter.
+     *
+     * @param pCellPopulation a pointer to the PottsBasedCellPopulation to visit.
+     */
+    virtual void Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the statistics.
+     *
+     * For each of G, area, target area and perimeter, outputs
+     * [count],[mean],[variance],[min],[max],[q05],[q25],[q50],[q75],[q95],[bin 0],...,[bin n-1]
+     * appended to the time stamp written by AbstractCellBasedWriter.
+     *
+     * @param pCellPopulation a pointer to the VertexBasedCellPopulation to visit.
+     */
+    virtual void Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+};
+
+#include "SerializationExportWrapper.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(PopulationStatisticsWriter)
+
+#endif /* POPULATIONSTATISTICSWRITER_HPP_ */
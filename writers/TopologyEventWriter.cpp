@@ -0,0 +1,264 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#include "TopologyEventWriter.hpp"
+#include "GTPaseProfiler.hpp"
+#include "MemoryFootprint.hpp"
+#include "CheckpointStream.hpp"
+#include "AbstractCellPopulation.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "CaBasedCellPopulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "SimulationTime.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::TopologyEventWriter()
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("topology_events.dat"),
+      mHasWrittenInitialAdjacency(false)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(OutputFileHandler& rOutputFileHandler)
+{
+    AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(rOutputFileHandler);
+    mAdjacency.clear();
+    mHasWrittenInitialAdjacency = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+    *this->mpOutStream << "# time init cell neighbours... | time T1 a b c d | time remove_edge a b | time add_edge a b"
+                       << " | time remove_cell a | time add_cell a neighbours...\n";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(TOPOLOGY_EVENT_WRITER);
+    GTPASE_PROFILE_COUNT(TOPOLOGY_EVENT_WRITER, pCellPopulation->GetNumRealCells());
+
+    double time = SimulationTime::Instance()->GetTime();
+    typedef std::map<unsigned, std::set<unsigned> > Adjacency;
+
+    // Current adjacency by cell ID
+    Adjacency adjacency;
+    for (typename AbstractCellPopulation<SPACE_DIM>::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        std::set<unsigned>& r_neighbours = adjacency[cell_iter->GetCellId()];
+        std::set<unsigned> neighbour_indices = pCellPopulation->GetNeighbouringLocationIndices(*cell_iter);
+        for (std::set<unsigned>::iterator neighbour_iter = neighbour_indices.begin();
+             neighbour_iter != neighbour_indices.end();
+             ++neighbour_iter)
+        {
+            r_neighbours.insert(pCellPopulation->GetCellUsingLocationIndex(*neighbour_iter)->GetCellId());
+        }
+    }
+
+    if (!mHasWrittenInitialAdjacency)
+    {
+        for (Adjacency::iterator iter = adjacency.begin(); iter != adjacency.end(); ++iter)
+        {
+            *this->mpOutStream << time << " init " << iter->first;
+            for (std::set<unsigned>::iterator n_iter = iter->second.begin(); n_iter != iter->second.end(); ++n_iter)
+            {
+                *this->mpOutStream << " " << *n_iter;
+            }
+            *this->mpOutStream << "\n";
+        }
+        mAdjacency.swap(adjacency);
+        mHasWrittenInitialAdjacency = true;
+        return;
+    }
+
+    // Cells that have disappeared; their edges go with them
+    for (Adjacency::iterator iter = mAdjacency.begin(); iter != mAdjacency.end(); ++iter)
+    {
+        if (adjacency.find(iter->first) == adjacency.end())
+        {
+            *this->mpOutStream << time << " remove_cell " << iter->first << "\n";
+        }
+    }
+
+    // New cells, with all their edges
+    for (Adjacency::iterator iter = adjacency.begin(); iter != adjacency.end(); ++iter)
+    {
+        if (mAdjacency.find(iter->first) == mAdjacency.end())
+        {
+            *this->mpOutStream << time << " add_cell " << iter->first;
+            for (std::set<unsigned>::iterator n_iter = iter->second.begin(); n_iter != iter->second.end(); ++n_iter)
+            {
+                *this->mpOutStream << " " << *n_iter;
+            }
+            *this->mpOutStream << "\n";
+        }
+    }
+
+    // Edges gained and lost between cells present at both samples, each pair stored once as (smaller, larger)
+    std::vector<std::pair<unsigned, unsigned> > lost_edges;
+    std::vector<std::pair<unsigned, unsigned> > gained_edges;
+    for (Adjacency::iterator iter = adjacency.begin(); iter != adjacency.end(); ++iter)
+    {
+        Adjacency::iterator old_iter = mAdjacency.find(iter->first);
+        if (old_iter == mAdjacency.end())
+        {
+            continue;
+        }
+        for (std::set<unsigned>::iterator n_iter = iter->second.begin(); n_iter != iter->second.end(); ++n_iter)
+        {
+            if (*n_iter > iter->first && old_iter->second.count(*n_iter) == 0
+                && mAdjacency.find(*n_iter) != mAdjacency.end())
+            {
+                gained_edges.push_back(std::make_pair(iter->first, *n_iter));
+            }
+        }
+        for (std::set<unsigned>::iterator n_iter = old_iter->second.begin(); n_iter != old_iter->second.end(); ++n_iter)
+        {
+            if (*n_iter > iter->first && iter->second.count(*n_iter) == 0
+                && adjacency.find(*n_iter) != adjacency.end())
+            {
+                lost_edges.push_back(std::make_pair(iter->first, *n_iter));
+            }
+        }
+    }
+
+    // Pair each lost edge (a,b) with a gained edge (c,d) where c and d both used to touch a and b
+    std::vector<bool> gained_used(gained_edges.size(), false);
+    for (unsigned i=0; i<lost_edges.size(); i++)
+    {
+        unsigned a = lost_edges[i].first;
+        unsigned b = lost_edges[i].second;
+        const std::set<unsigned>& r_old_a = mAdjacency[a];
+        const std::set<unsigned>& r_old_b = mAdjacency[b];
+
+        bool is_swap = false;
+        for (unsigned j=0; j<gained_edges.size() && !is_swap; j++)
+        {
+            unsigned c = gained_edges[j].first;
+            unsigned d = gained_edges[j].second;
+            if (!gained_used[j]
+                && r_old_a.count(c) && r_old_a.count(d) && r_old_b.count(c) && r_old_b.count(d))
+            {
+                gained_used[j] = true;
+                is_swap = true;
+                *this->mpOutStream << time << " T1 " << a << " " << b << " " << c << " " << d << "\n";
+            }
+        }
+        if (!is_swap)
+        {
+            *this->mpOutStream << time << " remove_edge " << a << " " << b << "\n";
+        }
+    }
+    for (unsigned j=0; j<gained_edges.size(); j++)
+    {
+        if (!gained_used[j])
+        {
+            *this->mpOutStream << time << " add_edge " << gained_edges[j].first << " " << gained_edges[j].second << "\n";
+        }
+    }
+
+    mAdjacency.swap(adjacency);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned long TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes() const
+{
+    unsigned long num_bytes = AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes();
+    for (std::map<unsigned, std::set<unsigned> >::const_iterator iter = mAdjacency.begin();
+         iter != mAdjacency.end();
+         ++iter)
+    {
+        num_bytes += MemoryFootprint::TreeNodeBytes(sizeof(std::pair<const unsigned, std::set<unsigned> >))
+                     + iter->second.size()*MemoryFootprint::TreeNodeBytes(sizeof(unsigned));
+    }
+    return num_bytes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::SaveCheckpointState(std::ostream& rStream) const
+{
+    CheckpointStream::WriteValue(rStream, (unsigned char)mHasWrittenInitialAdjacency);
+    CheckpointStream::WriteValue(rStream, (boost::uint64_t)mAdjacency.size());
+    for (std::map<unsigned, std::set<unsigned> >::const_iterator iter = mAdjacency.begin();
+         iter != mAdjacency.end();
+         ++iter)
+    {
+        CheckpointStream::WriteValue(rStream, (boost::uint32_t)iter->first);
+        CheckpointStream::WriteArray(rStream, std::vector<unsigned>(iter->second.begin(), iter->second.end()));
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyEventWriter<ELEMENT_DIM, SPACE_DIM>::LoadCheckpointState(std::istream& rStream)
+{
+    unsigned char has_written_initial_adjacency;
+    CheckpointStream::ReadValue(rStream, has_written_initial_adjacency);
+    mHasWrittenInitialAdjacency = (has_written_initial_adjacency != 0);
+
+    boost::uint64_t num_cells;
+    CheckpointStream::ReadValue(rStream, num_cells);
+    mAdjacency.clear();
+    std::vector<unsigned> neighbours;
+    for (unsigned i=0; i<num_cells; i++)
+    {
+        boost::uint32_t cell_id;
+        CheckpointStream::ReadValue(rStream, cell_id);
+        CheckpointStream::ReadArray(rStream, neighbours);
+        mAdjacency[cell_id] = std::set<unsigned>(neighbours.begin(), neighbours.end());
+    }
+}
+
+// Explicit instantiation
+template class TopologyEventWriter<1,1>;
+template class TopologyEventWriter<1,2>;
+template class TopologyEventWriter<2,2>;
+template class TopologyEventWriter<1,3>;
+template class TopologyEventWriter<2,3>;
+template class TopologyEventWriter<3,3>;
+
+#include "SerializationExportWrapperForCpp.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(TopologyEventWriter)
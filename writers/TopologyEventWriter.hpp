@@ -0,0 +1,162 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#ifndef TOPOLOGYEVENTWRITER_HPP_
+#define TOPOLOGYEVENTWRITER_HPP_
+
+#include "AbstractSampledPopulationWriter.hpp"
+#include "AbstractCheckpointable.hpp"
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * A class written using the visitor pattern for writing the tissue topology as
+ * an event log rather than as per-frame neighbour lists.
+ *
+ * At the first sample the full adjacency (by cell ID) is written once. At each
+ * later sample the adjacency is compared with the previous one and only the
+ * differences are written, one event per line:
+ *
+ *     [time] init [cell] [neighbour] [neighbour] ...
+ *     [time] T1 [a] [b] [c] [d]          a and b stop touching, c and d start
+ *     [time] remove_edge [a] [b]
+ *     [time] add_edge [a] [b]
+ *     [time] remove_cell [a]             all edges of a are removed too
+ *     [time] add_cell [a] [neighbour] ...
+ *
+ * A lost edge (a,b) is reported as a T1 swap when it can be paired with a gained
+ * edge (c,d) such that c and d were both neighbours of a and b. Events are
+ * timestamped with the sample at which they were detected, so the writer's
+ * sampling multiple sets the time resolution; any sampled frame's adjacency can
+ * be rebuilt exactly with scripts/reconstruct_topology.py. The previous
+ * adjacency is checkpointed, so a resumed run only writes the events since
+ * the checkpoint and its log continues that of the interrupted run.
+ *
+ * The output file is called topology_events.dat by default.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class TopologyEventWriter : public AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>, public AbstractCheckpointable
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+    }
+
+    /** The adjacency at the previous sample, keyed by cell ID. Not archived, but checkpointed. */
+    std::map<unsigned, std::set<unsigned> > mAdjacency;
+
+    /** Whether the initial adjacency has been written. */
+    bool mHasWrittenInitialAdjacency;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    TopologyEventWriter();
+
+    /**
+     * Overridden OpenOutputFile() method, which also forgets any previous adjacency.
+     *
+     * @param rOutputFileHandler handler for the directory in which to open the file
+     */
+    void OpenOutputFile(OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Write the format description.
+     *
+     * @param pCellPopulation a pointer to the population
+     */
+    void WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Overridden WriteTimeStamp() method. Every event line carries its own time, so this does nothing.
+     */
+    void WriteTimeStamp();
+
+    /**
+     * Overridden WriteNewline() method. Every event line ends itself, so this does nothing.
+     */
+    void WriteNewline();
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the MeshBasedCellPopulation to visit.
+     */
+    virtual void Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the CaBasedCellPopulation to visit.
+     */
+    virtual void Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the NodeBasedCellPopulation to visit.
+     */
+    virtual void Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the PottsBasedCellPopulation to visit.
+     */
+    virtual void Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the topology events since the previous sample.
+     *
+     * @param pCellPopulation a pointer to the VertexBasedCellPopulation to visit.
+     */
+    virtual void Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Overridden GetBufferedBytes() method, which adds the adjacency kept
+     * from the previous sample.
+     *
+     * @return the heap bytes held by this writer between samples
+     */
+    unsigned long GetBufferedBytes() const;
+
+    /**
+     * Overridden SaveCheckpointState() method, which writes the adjacency at the previous sample.
+     *
+     * @param rStream the stream
+     */
+    void SaveCheckpointState(std::ostream& rStream) const;
+
+    /**
+     * Overridden LoadCheckpointState() method.
+     *
+     * @param rStream the stream
+     */
+    void LoadCheckpointState(std::istream& rStream);
+};
+
+#include "SerializationExportWrapper.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(TopologyEventWriter)
+
+#endif /* TOPOLOGYEVENTWRITER_HPP_ */
@@ -0,0 +1,212 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#include "TopologyWriter.hpp"
+#include "GTPaseProfiler.hpp"
+#include "AbstractCellPopulation.hpp"
+#include "AbstractCellPopulationWriter.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "CaBasedCellPopulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "VertexElement.hpp"
+#include "RunningStatistics.hpp"
+#include <cmath>
+#include <limits>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+TopologyWriter<ELEMENT_DIM, SPACE_DIM>::TopologyWriter()
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("topology_data.csv")
+{
+}
+
+/* Write CSV Header */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+    *this->mpOutStream << "# TimeStamp,Total_Number_Of_Cells,Edges(n:count),Neighbours(n:count),"
+                       << "Aboav_Weaire(n:mean_neighbour_sides:mean_neighbour_area),Sides_Neighbour_Area_Correlation\n";
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::WriteCountOnly(unsigned numCells)
+{
+    // Empty histograms and Aboav-Weaire column, and an undefined correlation
+    *this->mpOutStream << "," << numCells << ",,,," << std::numeric_limits<double>::quiet_NaN();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::VisitAnyPopulation(AbstractCellPopulation<SPACE_DIM, SPACE_DIM>* pCellPopulation)
+{
+    WriteCountOnly(pCellPopulation->GetNumRealCells());
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    WriteCountOnly(pCellPopulation->GetNumRealCells());
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    VisitAnyPopulation(pCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TopologyWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(TOPOLOGY_WRITER);
+    GTPASE_PROFILE_COUNT(TOPOLOGY_WRITER, pCellPopulation->GetNumRealCells());
+
+    // All of these are indexed directly by the number of edges or neighbours and grow on demand
+    std::vector<unsigned> edge_counts;
+    std::vector<unsigned> neighbour_counts;
+    std::vector<double> sum_neighbour_sides;
+    std::vector<double> sum_neighbour_area;
+    std::vector<unsigned> num_neighbour_samples;
+
+    // Side count and mean neighbour area, with their co-moment updated alongside
+    // Welford's means so that the correlation does not suffer from cancellation
+    RunningStatistics side_statistics;
+    RunningStatistics area_statistics;
+    double co_moment = 0.0;
+
+    for (typename AbstractCellPopulation<SPACE_DIM>::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        unsigned num_edges = pCellPopulation->GetElementCorrespondingToCell(*cell_iter)->GetNumNodes();
+        std::set<unsigned> neighbour_indices = pCellPopulation->GetNeighbouringLocationIndices(*cell_iter);
+        unsigned num_neighbours = neighbour_indices.size();
+
+        if (num_edges >= edge_counts.size())
+        {
+            edge_counts.resize(num_edges + 1, 0);
+            sum_neighbour_sides.resize(num_edges + 1, 0.0);
+            sum_neighbour_area.resize(num_edges + 1, 0.0);
+            num_neighbour_samples.resize(num_edges + 1, 0);
+        }
+        if (num_neighbours >= neighbour_counts.size())
+        {
+            neighbour_counts.resize(num_neighbours + 1, 0);
+        }
+        edge_counts[num_edges]++;
+        neighbour_counts[num_neighbours]++;
+
+        if (num_neighbours == 0)
+        {
+            continue;
+        }
+
+        double neighbour_sides = 0.0;
+        double neighbour_area = 0.0;
+        for (std::set<unsigned>::iterator neighbour_iter = neighbour_indices.begin();
+             neighbour_iter != neighbour_indices.end();
+             ++neighbour_iter)
+        {
+            neighbour_sides += pCellPopulation->GetElement(*neighbour_iter)->GetNumNodes();
+            neighbour_area += pCellPopulation->GetCellUsingLocationIndex(*neighbour_iter)->GetCellData()->GetItem("volume");
+        }
+        neighbour_sides /= num_neighbours;
+        neighbour_area /= num_neighbours;
+
+        sum_neighbour_sides[num_edges] += neighbour_sides;
+        sum_neighbour_area[num_edges] += neighbour_area;
+        num_neighbour_samples[num_edges]++;
+
+        double side_deviation = num_edges - side_statistics.GetMean();
+        side_statistics.Add(num_edges);
+        area_statistics.Add(neighbour_area);
+        co_moment += side_deviation*(neighbour_area - area_statistics.GetMean());
+    }
+
+    *this->mpOutStream << "," << pCellPopulation->GetNumRealCells() << ",";
+    for (unsigned n=0; n<edge_counts.size(); n++)
+    {
+        if (edge_counts[n] > 0)
+        {
+            *this->mpOutStream << " " << n << ":" << edge_counts[n];
+        }
+    }
+    *this->mpOutStream << ",";
+    for (unsigned n=0; n<neighbour_counts.size(); n++)
+    {
+        if (neighbour_counts[n] > 0)
+        {
+            *this->mpOutStream << " " << n << ":" << neighbour_counts[n];
+        }
+    }
+    *this->mpOutStream << ",";
+    for (unsigned n=0; n<num_neighbour_samples.size(); n++)
+    {
+        if (num_neighbour_samples[n] > 0)
+        {
+            *this->mpOutStream << " " << n << ":" << sum_neighbour_sides[n]/num_neighbour_samples[n]
+                               << ":" << sum_neighbour_area[n]/num_neighbour_samples[n];
+        }
+    }
+
+    // Undefined unless both quantities vary over at least two cells
+    double correlation = std::numeric_limits<double>::quiet_NaN();
+    double side_m2 = side_statistics.GetSumSquaredDeviations();
+    double area_m2 = area_statistics.GetSumSquaredDeviations();
+    if (side_statistics.GetCount() > 1 && side_m2 > 0.0 && area_m2 > 0.0)
+    {
+        correlation = co_moment/sqrt(side_m2*area_m2);
+    }
+    *this->mpOutStream << "," << correlation;
+}
+
+// Explicit instantiation
+template class TopologyWriter<1,1>;
+template class TopologyWriter<1,2>;
+template class TopologyWriter<2,2>;
+template class TopologyWriter<1,3>;
+template class TopologyWriter<2,3>;
+template class TopologyWriter<3,3>;
+
+#include "SerializationExportWrapperForCpp.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(TopologyWriter)
@@ -0,0 +1,129 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#ifndef TOPOLOGYWRITER_HPP_
+#define TOPOLOGYWRITER_HPP_
+
+#include "AbstractSampledPopulationWriter.hpp"
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+/**
+ * A class written using the visitor pattern for writing topology statistics
+ * of a vertex tissue, replacing the former ShapeWriter and NumNeighboursWriter.
+ *
+ * A single pass over the cells computes the polygon class (number of edges)
+ * histogram, the neighbour number histogram and, for each polygon class n,
+ * the mean number of sides and mean area of the neighbours of n-sided cells
+ * (Aboav-Weaire relation). All histograms grow as needed, so there is no upper
+ * limit on the number of edges or neighbours a cell may have.
+ *
+ * The output file is called topology_data.csv by default.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class TopologyWriter : public AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+    }
+
+    /**
+     * Write a row for a population without vertex topology: the number of
+     * cells, empty histogram and Aboav-Weaire columns and a NaN correlation.
+     *
+     * @param numCells the number of cells
+     */
+    void WriteCountOnly(unsigned numCells);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    TopologyWriter();
+
+    /**
+     * Write the column names.
+     *
+     * @param pCellPopulation a pointer to the population
+     */
+    void WriteHeader(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the number of cells, with the topology
+     * columns empty and the correlation NaN.
+     *
+     * @param pCellPopulation a pointer to the population to visit.
+     */
+    void VisitAnyPopulation(AbstractCellPopulation<SPACE_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the data. Not supported; writes the number of cells only,
+     * with the topology columns empty.
+     *
+     * @param pCellPopulation a pointer to the MeshBasedCellPopulation to visit.
+     */
+    virtual void Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the data. Not supported; writes the number of cells only,
+     * with the topology columns empty.
+     *
+     * @param pCellPopulation a pointer to the CaBasedCellPopulation to visit.
+     */
+    virtual void Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the data. Not supported; writes the number of cells only,
+     * with the topology columns empty.
+     *
+     * @param pCellPopulation a pointer to the NodeBasedCellPopulation to visit.
+     */
+    virtual void Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the data. Not supported; writes the number of cells only,
+     * with the topology columns empty.
+     *
+     * @param pCellPopulation a pointer to the PottsBasedCellPopulation to visit.
+     */
+    virtual void Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population and write the topology statistics.
+     *
+     * Outputs, after the time stamp written by AbstractCellBasedWriter,
+     * ,[number of cells],[polygon histogram],[neighbour histogram],[Aboav-Weaire],[correlation]
+     *
+     * where each histogram is a space-separated list of n:count pairs for the
+     * non-empty classes, the Aboav-Weaire column is a space-separated list of
+     * n:m(n):a(n) triples giving the mean number of sides m(n) and mean area a(n)
+     * of the neighbours of n-sided cells, and the last column is the Pearson
+     * correlation over cells between side count and mean neighbour area, or
+     * NaN when fewer than two cells have neighbours or either quantity is
+     * constant.
+     *
+     * @param pCellPopulation a pointer to the VertexBasedCellPopulation to visit.
+     */
+    virtual void Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+};
+
+#include "SerializationExportWrapper.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(TopologyWriter)
+
+#endif /* TOPOLOGYWRITER_HPP_ */
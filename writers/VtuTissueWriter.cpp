@@ -0,0 +1,312 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#include "VtuTissueWriter.hpp"
+#include "GTPaseProfiler.hpp"
+#include "CheckpointStream.hpp"
+#include "AbstractCellPopulation.hpp"
+#include "AbstractCellPopulationWriter.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "CaBasedCellPopulation.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "OutputFileHandler.hpp"
+#include "SimulationTime.hpp"
+#include "Exception.hpp"
+
+#include <boost/cstdint.hpp>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+/** VTK cell type of a polygon. */
+const unsigned char VTK_POLYGON = 7;
+
+/** @return whether this machine stores multi-byte values little endian first. */
+bool IsLittleEndian()
+{
+    boost::uint16_t test = 1;
+    return *reinterpret_cast<unsigned char*>(&test) == 1;
+}
+
+/**
+ * @param rData an array
+ * @return the size of the array's appended block: a UInt64 byte count followed by the raw values
+ */
+template<typename T>
+boost::uint64_t BlockSize(const std::vector<T>& rData)
+{
+    return sizeof(boost::uint64_t) + rData.size()*sizeof(T);
+}
+
+/**
+ * Write one appended block (byte count, then the raw values) to a binary stream.
+ *
+ * @param rFile the stream
+ * @param rData the array
+ */
+template<typename T>
+void WriteBlock(std::ofstream& rFile, const std::vector<T>& rData)
+{
+    boost::uint64_t num_bytes = rData.size()*sizeof(T);
+    rFile.write(reinterpret_cast<const char*>(&num_bytes), sizeof(num_bytes));
+    if (!rData.empty())
+    {
+        rFile.write(reinterpret_cast<const char*>(&rData[0]), num_bytes);
+    }
+}
+
+/**
+ * Write the XML description of one appended data array.
+ *
+ * @param rFile the stream
+ * @param rType the VTK type name
+ * @param rName the array name
+ * @param numComponents the number of components per tuple
+ * @param offset the offset of the array's block in the appended data
+ */
+void WriteDataArrayTag(std::ofstream& rFile, const std::string& rType, const std::string& rName,
+                       unsigned numComponents, boost::uint64_t offset)
+{
+    rFile << "        <DataArray type=\"" << rType << "\" Name=\"" << rName << "\"";
+    if (numComponents > 1)
+    {
+        rFile << " NumberOfComponents=\"" << numComponents << "\"";
+    }
+    rFile << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+}
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::VtuTissueWriter()
+    : AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>("vtu_index.dat"),
+      mDirectory(""),
+      mNumFrames(0),
+      mPvdFooterPosition(0)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(OutputFileHandler& rOutputFileHandler)
+{
+    AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(rOutputFileHandler);
+    mDirectory = rOutputFileHandler.GetOutputDirectoryFullPath();
+    mNumFrames = 0;
+
+    // The .pvd file is kept open for the whole run, as the population may reopen its writers' files for append
+    if (mPvdFile.is_open())
+    {
+        mPvdFile.close();
+    }
+    mPvdFile.open((mDirectory + "tissue.pvd").c_str(), std::ios::out | std::ios::trunc);
+    if (!mPvdFile.is_open())
+    {
+        EXCEPTION("Could not open " + mDirectory + "tissue.pvd");
+    }
+    mPvdFile << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"Collection\" version=\"0.1\">\n"
+             << "  <Collection>\n";
+    mPvdFooterPosition = mPvdFile.tellp();
+    WritePvdFooter();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::WritePvdFooter()
+{
+    mPvdFile << "  </Collection>\n"
+             << "</VTKFile>\n";
+    mPvdFile.flush();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation)
+{
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(VTU_WRITER);
+    GTPASE_PROFILE_COUNT(VTU_WRITER, pCellPopulation->GetNumRealCells());
+
+    if (SPACE_DIM != 2)
+    {
+        EXCEPTION("VtuTissueWriter only supports 2D vertex based simulations");
+    }
+    if (!mPvdFile.is_open())
+    {
+        EXCEPTION("VtuTissueWriter output file has not been opened");
+    }
+
+    MutableVertexMesh<SPACE_DIM, SPACE_DIM>& r_mesh = pCellPopulation->rGetMesh();
+
+    // Gather everything into contiguous arrays first
+    unsigned num_nodes = r_mesh.GetNumNodes();
+    std::vector<double> points(3*num_nodes, 0.0);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = r_mesh.GetNode(node_index)->rGetLocation();
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            points[3*node_index + i] = r_location[i];
+        }
+    }
+
+    unsigned num_cells = pCellPopulation->GetNumRealCells();
+    std::vector<boost::int64_t> connectivity;
+    connectivity.reserve(6*num_cells);
+    std::vector<boost::int64_t> offsets;
+    offsets.reserve(num_cells);
+    std::vector<double> areas, target_areas, gs, perimeters;
+    areas.reserve(num_cells);
+    target_areas.reserve(num_cells);
+    gs.reserve(num_cells);
+    perimeters.reserve(num_cells);
+    std::vector<boost::int32_t> num_neighbours;
+    num_neighbours.reserve(num_cells);
+    std::vector<boost::int64_t> cell_ids;
+    cell_ids.reserve(num_cells);
+
+    for (typename AbstractCellPopulation<SPACE_DIM>::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        unsigned elem_index = pCellPopulation->GetLocationIndexUsingCell(*cell_iter);
+        VertexElement<SPACE_DIM, SPACE_DIM>* p_element = r_mesh.GetElement(elem_index);
+        for (unsigned j=0; j<p_element->GetNumNodes(); j++)
+        {
+            connectivity.push_back(p_element->GetNodeGlobalIndex(j));
+        }
+        offsets.push_back(connectivity.size());
+
+        areas.push_back(cell_iter->GetCellData()->GetItem("volume"));
+        target_areas.push_back(cell_iter->GetCellData()->GetItem("target area"));
+        gs.push_back(cell_iter->GetCellData()->GetItem("G"));
+        perimeters.push_back(r_mesh.GetSurfaceAreaOfElement(elem_index));
+        num_neighbours.push_back(pCellPopulation->GetNeighbouringLocationIndices(*cell_iter).size());
+        cell_ids.push_back(cell_iter->GetCellId());
+    }
+    std::vector<unsigned char> types(offsets.size(), VTK_POLYGON);
+
+    // Offsets of each block in the appended data section
+    boost::uint64_t offset_points = 0;
+    boost::uint64_t offset_connectivity = offset_points + BlockSize(points);
+    boost::uint64_t offset_offsets = offset_connectivity + BlockSize(connectivity);
+    boost::uint64_t offset_types = offset_offsets + BlockSize(offsets);
+    boost::uint64_t offset_areas = offset_types + BlockSize(types);
+    boost::uint64_t offset_target_areas = offset_areas + BlockSize(areas);
+    boost::uint64_t offset_gs = offset_target_areas + BlockSize(target_areas);
+    boost::uint64_t offset_perimeters = offset_gs + BlockSize(gs);
+    boost::uint64_t offset_num_neighbours = offset_perimeters + BlockSize(perimeters);
+    boost::uint64_t offset_cell_ids = offset_num_neighbours + BlockSize(num_neighbours);
+
+    std::ostringstream file_name;
+    file_name << "tissue_" << mNumFrames << ".vtu";
+
+    std::ofstream vtu_file((mDirectory + file_name.str()).c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!vtu_file.is_open())
+    {
+        EXCEPTION("Could not open " + mDirectory + file_name.str());
+    }
+
+    vtu_file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+             << (IsLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\">\n"
+             << "  <UnstructuredGrid>\n"
+             << "    <Piece NumberOfPoints=\"" << num_nodes << "\" NumberOfCells=\"" << offsets.size() << "\">\n"
+             << "      <Points>\n";
+    WriteDataArrayTag(vtu_file, "Float64", "Points", 3, offset_points);
+    vtu_file << "      </Points>\n"
+             << "      <Cells>\n";
+    WriteDataArrayTag(vtu_file, "Int64", "connectivity", 1, offset_connectivity);
+    WriteDataArrayTag(vtu_file, "Int64", "offsets", 1, offset_offsets);
+    WriteDataArrayTag(vtu_file, "UInt8", "types", 1, offset_types);
+    vtu_file << "      </Cells>\n"
+             << "      <CellData Scalars=\"G\">\n";
+    WriteDataArrayTag(vtu_file, "Float64", "area", 1, offset_areas);
+    WriteDataArrayTag(vtu_file, "Float64", "target_area", 1, offset_target_areas);
+    WriteDataArrayTag(vtu_file, "Float64", "G", 1, offset_gs);
+    WriteDataArrayTag(vtu_file, "Float64", "perimeter", 1, offset_perimeters);
+    WriteDataArrayTag(vtu_file, "Int32", "num_neighbours", 1, offset_num_neighbours);
+    WriteDataArrayTag(vtu_file, "Int64", "cell_id", 1, offset_cell_ids);
+    vtu_file << "      </CellData>\n"
+             << "    </Piece>\n"
+             << "  </UnstructuredGrid>\n"
+             << "  <AppendedData encoding=\"raw\">\n"
+             << "_";
+    WriteBlock(vtu_file, points);
+    WriteBlock(vtu_file, connectivity);
+    WriteBlock(vtu_file, offsets);
+    WriteBlock(vtu_file, types);
+    WriteBlock(vtu_file, areas);
+    WriteBlock(vtu_file, target_areas);
+    WriteBlock(vtu_file, gs);
+    WriteBlock(vtu_file, perimeters);
+    WriteBlock(vtu_file, num_neighbours);
+    WriteBlock(vtu_file, cell_ids);
+    vtu_file << "\n  </AppendedData>\n"
+             << "</VTKFile>\n";
+    vtu_file.close();
+
+    // Overwrite the closing tags with the new entry, then put them back so the .pvd is always loadable
+    double time = SimulationTime::Instance()->GetTime();
+    mPvdFile.seekp(mPvdFooterPosition);
+    mPvdFile << "    <DataSet timestep=\"" << std::setprecision(12) << time
+             << "\" group=\"\" part=\"0\" file=\"" << file_name.str() << "\"/>\n";
+    mPvdFooterPosition = mPvdFile.tellp();
+    WritePvdFooter();
+
+    *this->mpOutStream << file_name.str();
+    mNumFrames++;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::SaveCheckpointState(std::ostream& rStream) const
+{
+    CheckpointStream::WriteValue(rStream, (boost::uint64_t)mNumFrames);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VtuTissueWriter<ELEMENT_DIM, SPACE_DIM>::LoadCheckpointState(std::istream& rStream)
+{
+    boost::uint64_t num_frames;
+    CheckpointStream::ReadValue(rStream, num_frames);
+    mNumFrames = num_frames;
+}
+
+// Explicit instantiation
+template class VtuTissueWriter<1,1>;
+template class VtuTissueWriter<1,2>;
+template class VtuTissueWriter<2,2>;
+template class VtuTissueWriter<1,3>;
+template class VtuTissueWriter<2,3>;
+template class VtuTissueWriter<3,3>;
+
+#include "SerializationExportWrapperForCpp.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(VtuTissueWriter)
@@ -0,0 +1,136 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ * Only supports vertex based simulations
+ */
+
+#ifndef VTUTISSUEWRITER_HPP_
+#define VTUTISSUEWRITER_HPP_
+
+#include "AbstractSampledPopulationWriter.hpp"
+#include "AbstractCheckpointable.hpp"
+#include "ChasteSerialization.hpp"
+#include <boost/serialization/base_object.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * A class written using the visitor pattern for writing the vertex tissue as
+ * binary VTK unstructured grid (.vtu) frames that ParaView can load directly.
+ *
+ * Each sample writes tissue_[frame].vtu containing the cell polygons and the
+ * cell fields area, target area, G, perimeter, number of neighbours and cell
+ * ID. All arrays are gathered into contiguous buffers and written as raw
+ * binary in the VTK appended-data section, so no value is formatted as text.
+ * The time series is indexed by tissue.pvd, which is kept valid after every
+ * frame, and by the plain text file vtu_index.dat (time, file name). The
+ * frame count is checkpointed, so a resumed run continues the numbering; its
+ * tissue.pvd only indexes the frames written since the resume.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VtuTissueWriter : public AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM>, public AbstractCheckpointable
+{
+private:
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Serialize the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & boost::serialization::base_object<AbstractSampledPopulationWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+    }
+
+    /** The full path of the output directory. */
+    std::string mDirectory;
+
+    /** The number of frames written so far. */
+    unsigned mNumFrames;
+
+    /** The .pvd collection file. */
+    std::ofstream mPvdFile;
+
+    /** Position in the .pvd file at which the next DataSet entry is written, overwriting the closing tags. */
+    std::streampos mPvdFooterPosition;
+
+    /** Write the closing tags of the .pvd file at the current position and flush. */
+    void WritePvdFooter();
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    VtuTissueWriter();
+
+    /**
+     * Overridden OpenOutputFile() method, which also records the output directory
+     * and starts a new .pvd collection.
+     *
+     * @param rOutputFileHandler handler for the directory in which to open the file
+     */
+    void OpenOutputFile(OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the MeshBasedCellPopulation to visit.
+     */
+    virtual void Visit(MeshBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the CaBasedCellPopulation to visit.
+     */
+    virtual void Visit(CaBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the NodeBasedCellPopulation to visit.
+     */
+    virtual void Visit(NodeBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population. Not supported.
+     *
+     * @param pCellPopulation a pointer to the PottsBasedCellPopulation to visit.
+     */
+    virtual void Visit(PottsBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Visit the population, write the next .vtu frame and add it to the .pvd collection.
+     *
+     * Outputs the name of the frame file after the time stamp written by AbstractCellBasedWriter.
+     *
+     * @param pCellPopulation a pointer to the VertexBasedCellPopulation to visit.
+     */
+    virtual void Visit(VertexBasedCellPopulation<SPACE_DIM>* pCellPopulation);
+
+    /**
+     * Overridden SaveCheckpointState() method, which writes the frame count.
+     *
+     * @param rStream the stream
+     */
+    void SaveCheckpointState(std::ostream& rStream) const;
+
+    /**
+     * Overridden LoadCheckpointState() method.
+     *
+     * @param rStream the stream
+     */
+    void LoadCheckpointState(std::istream& rStream);
+};
+
+#include "SerializationExportWrapper.hpp"
+// Declare identifier for the serializer
+EXPORT_TEMPLATE_CLASS_ALL_DIMS(VtuTissueWriter)
+
+#endif /* VTUTISSUEWRITER_HPP_ */
@@ -0,0 +1,48 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#include "WriterSamplingSchedule.hpp"
+#include <cfloat>
+#include "SimulationTime.hpp"
+#include "Exception.hpp"
+
+WriterSamplingSchedule::WriterSamplingSchedule()
+    : mSamplingTimestepMultiple(1),
+      mStartTime(-DBL_MAX),
+      mEndTime(DBL_MAX)
+{
+}
+
+void WriterSamplingSchedule::SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple)
+{
+    if (samplingTimestepMultiple == 0)
+    {
+        EXCEPTION("The sampling timestep multiple must be positive");
+    }
+    mSamplingTimestepMultiple = samplingTimestepMultiple;
+}
+
+void WriterSamplingSchedule::SetSamplingWindow(double startTime, double endTime)
+{
+    if (endTime < startTime)
+    {
+        EXCEPTION("The sampling window must end after it starts");
+    }
+    mStartTime = startTime;
+    mEndTime = endTime;
+}
+
+unsigned WriterSamplingSchedule::GetSamplingTimestepMultiple() const
+{
+    return mSamplingTimestepMultiple;
+}
+
+bool WriterSamplingSchedule::IsSamplingTime() const
+{
+    SimulationTime* p_time = SimulationTime::Instance();
+    double time = p_time->GetTime();
+    return (p_time->GetTimeStepsElapsed() % mSamplingTimestepMultiple == 0)
+           && (time >= mStartTime) && (time <= mEndTime);
+}
@@ -0,0 +1,78 @@
+/*
+ * Rho GTPase Simulation
+ * Do not reproduce this code without permission.
+ */
+
+#ifndef WRITERSAMPLINGSCHEDULE_HPP_
+#define WRITERSAMPLINGSCHEDULE_HPP_
+
+#include "ChasteSerialization.hpp"
+
+/**
+ * The output cadence of a single writer: a sampling timestep multiple and an
+ * optional time window [start, end].
+ *
+ * The simulator only offers writers the chance to write every
+ * SetSamplingTimestepMultiple() time steps, so a writer's own multiple should
+ * be a multiple of the simulator's; the simulator's multiple is then set to the
+ * finest cadence needed by any writer.
+ */
+class WriterSamplingSchedule
+{
+private:
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+    /**
+     * Archive the schedule.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & mSamplingTimestepMultiple;
+        archive & mStartTime;
+        archive & mEndTime;
+    }
+
+    /** The number of time steps between outputs. Defaults to 1, i.e. whenever the simulator samples. */
+    unsigned mSamplingTimestepMultiple;
+
+    /** No output is written before this time. Defaults to -DBL_MAX. */
+    double mStartTime;
+
+    /** No output is written after this time. Defaults to DBL_MAX. */
+    double mEndTime;
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    WriterSamplingSchedule();
+
+    /**
+     * Set mSamplingTimestepMultiple.
+     *
+     * @param samplingTimestepMultiple the number of time steps between outputs
+     */
+    void SetSamplingTimestepMultiple(unsigned samplingTimestepMultiple);
+
+    /**
+     * Restrict output to a time window.
+     *
+     * @param startTime the first time at which output may be written
+     * @param endTime the last time at which output may be written
+     */
+    void SetSamplingWindow(double startTime, double endTime);
+
+    /** @return mSamplingTimestepMultiple. */
+    unsigned GetSamplingTimestepMultiple() const;
+
+    /** @return whether output should be written at the current simulation time. */
+    bool IsSamplingTime() const;
+};
+
+#endif /*WRITERSAMPLINGSCHEDULE_HPP_*/
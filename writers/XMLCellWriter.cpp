@@ -8,105 +8,236 @@
 
 #include <boost/regex.hpp>
 #include "XMLCellWriter.hpp"
+#include "GTPaseProfiler.hpp"
+#include "MemoryFootprint.hpp"
+#include "CheckpointStream.hpp"
 #include "AbstractCellPopulation.hpp"
 #include "VertexBasedCellPopulation.hpp"
 #include "SimulationTime.hpp"
 #include "MutableVertexMesh.hpp"
 #include "VertexMesh.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::XMLCellWriter()
-    : AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>("cell_data.xml")
+    : AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>("cell_data.xml"),
+      mKeyframeInterval(0),
+      mDeltaTolerances(NUM_FIELDS, 0.0),
+      mOutputNeighbourIds(true),
+      mNumFramesWritten(0),
+      mIsKeyframe(true)
 {
-	this->mVtkCellDataName = "XML_dummy_attribute";
+	this->mVtkCellDataName = "G";
 };
 
 
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(OutputFileHandler& rOutputFileHandler)
 {
-    AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(rOutputFileHandler);
+    AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFile(rOutputFileHandler);
+    mLastWrittenRecords.clear();
+    mNumFramesWritten = 0;
 }
 
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::SetDeltaEncoding(unsigned keyframeInterval)
+{
+    mKeyframeInterval = keyframeInterval;
+}
+
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::SetDeltaTolerance(Field field, double tolerance)
+{
+    assert(field < NUM_FIELDS);
+    mDeltaTolerances[field] = tolerance;
+}
+
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::SetOutputNeighbourIds(bool outputNeighbourIds)
+{
+    mOutputNeighbourIds = outputNeighbourIds;
+}
 
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteNewline()
 {
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    if (mKeyframeInterval > 0)
+    {
+        // Forget, and report, the cells that were not visited in this frame
+        std::sort(mVisitedCellIds.begin(), mVisitedCellIds.end());
+        typename std::map<unsigned, CellRecord>::iterator record_iter = mLastWrittenRecords.begin();
+        while (record_iter != mLastWrittenRecords.end())
+        {
+            if (std::binary_search(mVisitedCellIds.begin(), mVisitedCellIds.end(), record_iter->first))
+            {
+                ++record_iter;
+            }
+            else
+            {
+                if (!mIsKeyframe)
+                {
+                    *this->mpOutStream << "<removed cell_id=\"" << record_iter->first << "\" />\n";
+                }
+                mLastWrittenRecords.erase(record_iter++);
+            }
+        }
+    }
+    mNumFramesWritten++;
+
     *this->mpOutStream << "</time>\n";
 }
 
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp()
 {
-    *this->mpOutStream << "<time t=\"" << SimulationTime::Instance()->GetTime() << "\" tau=\"" << SimulationTime::Instance()->GetTimeStepsElapsed() << "\">\n";
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    mIsKeyframe = (mKeyframeInterval == 0) || (mNumFramesWritten % mKeyframeInterval == 0);
+    mVisitedCellIds.clear();
+
+    *this->mpOutStream << "<time t=\"" << SimulationTime::Instance()->GetTime() << "\" tau=\"" << SimulationTime::Instance()->GetTimeStepsElapsed() << "\"";
+    if (mKeyframeInterval > 0)
+    {
+        *this->mpOutStream << " keyframe=\"" << (mIsKeyframe ? 1 : 0) << "\"";
+    }
+    *this->mpOutStream << ">\n";
+}
+
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::HasChanged(const CellRecord& rOld, const CellRecord& rNew) const
+{
+    if (rOld.mLabelled != rNew.mLabelled || rOld.mNumEdges != rNew.mNumEdges
+        || rOld.mNumNeighbours != rNew.mNumNeighbours || rOld.mNeighbourIds != rNew.mNeighbourIds)
+    {
+        return true;
+    }
+    for (unsigned field=0; field<NUM_FIELDS; field++)
+    {
+        if (fabs(rNew.mValues[field] - rOld.mValues[field]) > mDeltaTolerances[field])
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
-	// Cell ID
-        *this->mpOutStream << "<cell ";
+    if (!this->IsSamplingTime())
+    {
+        return;
+    }
+
+    GTPASE_PROFILE_SCOPE(XML_CELL_WRITER);
+    GTPASE_PROFILE_COUNT(XML_CELL_WRITER, 1);
+
 	unsigned cell_id = pCell->GetCellId();
-	*this->mpOutStream << "cell_id=\"" << cell_id << "\" ";
-	
+	CellRecord record;
+
 	// Centroid
         c_vector<double, SPACE_DIM> centre_location = pCellPopulation->GetLocationOfCellCentre(pCell);
-        *this->mpOutStream << "x=\"" << centre_location[0] << "\" ";
-        *this->mpOutStream << "y=\"" << centre_location[1] << "\" ";
+	record.mValues[X] = centre_location[0];
+	record.mValues[Y] = centre_location[1];
 
 	// Area
-	double volume = pCell->GetCellData()->GetItem("volume");
-	// Only write cells with finite volume (avoids a case for boundary cells in MeshBasedCellPopulation)
-        if (volume < DBL_MAX)   
-        {
-          *this->mpOutStream << "area=\"" << volume << "\" ";
-        }
-	
+	record.mValues[AREA] = pCell->GetCellData()->GetItem("volume");
+
 	// Label
-	if (pCell->HasCellProperty<CellLabel>()){
-		*this->mpOutStream << "CellLabel=\"" << 1 << "\" ";
-	}
-	
+	record.mLabelled = pCell->HasCellProperty<CellLabel>();
+
 	// Target Area
-	double target_area = pCell->GetCellData()->GetItem("target area");
-	*this->mpOutStream << "target_area=\"" << target_area << "\" ";
-	
+	record.mValues[TARGET_AREA] = pCell->GetCellData()->GetItem("target area");
+
 	// Area from ODE
-	double ODE_area = pCell->GetCellData()->GetItem("AREA");
-	*this->mpOutStream << "ODE_area=\"" << ODE_area << "\" ";
-	
+	record.mValues[ODE_AREA] = pCell->GetCellData()->GetItem("AREA");
+
 	// GTPase Concentration
-	double G = pCell->GetCellData()->GetItem("G");
-	*this->mpOutStream << "G=\"" << target_area << "\" ";
-	
+	record.mValues[G] = pCell->GetCellData()->GetItem("G");
+
 	// Perimeter
 	unsigned elem_index = pCellPopulation->GetLocationIndexUsingCell(pCell);
-        double perimeter = dynamic_cast<VertexBasedCellPopulation<ELEMENT_DIM>*>(pCellPopulation)->rGetMesh().GetSurfaceAreaOfElement(elem_index);
-        *this->mpOutStream << "perimeter=\"" << perimeter << "\" ";
+        record.mValues[PERIMETER] = dynamic_cast<VertexBasedCellPopulation<ELEMENT_DIM>*>(pCellPopulation)->rGetMesh().GetSurfaceAreaOfElement(elem_index);
 
 	// Neighbours
         std::set<unsigned> neighbours = pCellPopulation->GetNeighbouringLocationIndices(pCell);
-	
-	// Number of Neighbours
-	int num_neighbours = neighbours.size();
-	*this->mpOutStream << "num_neighbours=\"" << num_neighbours << "\" ";
-	
-	// List of Neighbouring Cell IDs
-	*this->mpOutStream << "neighbors=\"";
+	record.mNumNeighbours = neighbours.size();
+	if (mOutputNeighbourIds)
+	{
         for (std::set<unsigned>::iterator neighbour_iter = neighbours.begin();
             neighbour_iter != neighbours.end();
             ++neighbour_iter)
         {
-          *this->mpOutStream << " " << (pCellPopulation->GetCellUsingLocationIndex(*neighbour_iter))->GetCellId();
+          record.mNeighbourIds.push_back((pCellPopulation->GetCellUsingLocationIndex(*neighbour_iter))->GetCellId());
         }
-        *this->mpOutStream << "\" ";
-	
-	// Number of Edges	
+	}
+
+	// Number of Edges
 	VertexElement < ELEMENT_DIM, ELEMENT_DIM > *VertexElement = dynamic_cast<VertexBasedCellPopulation<ELEMENT_DIM>*>(pCellPopulation)->GetElementCorrespondingToCell(pCell);
-	int num_edges = VertexElement->GetNumNodes();
-	*this->mpOutStream << "num_edges=\"" << num_edges << "\" ";
-		
-	// End tag   
+	record.mNumEdges = VertexElement->GetNumNodes();
+
+	// In a delta frame, skip cells that have not moved beyond the tolerances since they were last written
+	if (mKeyframeInterval > 0)
+	{
+		mVisitedCellIds.push_back(cell_id);
+		typename std::map<unsigned, CellRecord>::iterator record_iter = mLastWrittenRecords.find(cell_id);
+		if (!mIsKeyframe && record_iter != mLastWrittenRecords.end() && !HasChanged(record_iter->second, record))
+		{
+			return;
+		}
+		mLastWrittenRecords[cell_id] = record;
+	}
+
+	// Cell ID
+        *this->mpOutStream << "<cell ";
+	*this->mpOutStream << "cell_id=\"" << cell_id << "\" ";
+
+	// Centroid
+        *this->mpOutStream << "x=\"" << record.mValues[X] << "\" ";
+        *this->mpOutStream << "y=\"" << record.mValues[Y] << "\" ";
+
+	// Only write cells with finite volume (avoids a case for boundary cells in MeshBasedCellPopulation)
+        if (record.mValues[AREA] < DBL_MAX)
+        {
+          *this->mpOutStream << "area=\"" << record.mValues[AREA] << "\" ";
+        }
+
+	if (record.mLabelled){
+		*this->mpOutStream << "CellLabel=\"" << 1 << "\" ";
+	}
+
+	*this->mpOutStream << "target_area=\"" << record.mValues[TARGET_AREA] << "\" ";
+	*this->mpOutStream << "ODE_area=\"" << record.mValues[ODE_AREA] << "\" ";
+	*this->mpOutStream << "G=\"" << record.mValues[G] << "\" ";
+        *this->mpOutStream << "perimeter=\"" << record.mValues[PERIMETER] << "\" ";
+
+	// Number of Neighbours
+	*this->mpOutStream << "num_neighbours=\"" << record.mNumNeighbours << "\" ";
+
+	// List of Neighbouring Cell IDs
+	if (mOutputNeighbourIds)
+	{
+	*this->mpOutStream << "neighbors=\"";
+        for (unsigned i=0; i<record.mNeighbourIds.size(); i++)
+        {
+          *this->mpOutStream << " " << record.mNeighbourIds[i];
+        }
+        *this->mpOutStream << "\" ";
+	}
+
+	*this->mpOutStream << "num_edges=\"" << record.mNumEdges << "\" ";
+
+	// End tag
         *this->mpOutStream << "/>\n";
 }
 
@@ -114,9 +245,78 @@ void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, AbstractCel
     template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
-    return 0.0;
+    return pCell->GetCellData()->GetItem("G");
+}
+
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned long XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes() const
+{
+    unsigned long num_bytes = AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>::GetBufferedBytes()
+                              + MemoryFootprint::VectorBytes(mVisitedCellIds.capacity(), sizeof(unsigned));
+    for (typename std::map<unsigned, CellRecord>::const_iterator iter = mLastWrittenRecords.begin();
+         iter != mLastWrittenRecords.end();
+         ++iter)
+    {
+        num_bytes += MemoryFootprint::TreeNodeBytes(sizeof(std::pair<const unsigned, CellRecord>))
+                     + MemoryFootprint::VectorBytes(iter->second.mNeighbourIds.capacity(), sizeof(unsigned));
+    }
+    return num_bytes;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::SaveCheckpointState(std::ostream& rStream) const
+{
+    CheckpointStream::WriteValue(rStream, (boost::uint64_t)mNumFramesWritten);
+    CheckpointStream::WriteValue(rStream, (boost::uint64_t)mLastWrittenRecords.size());
+    for (typename std::map<unsigned, CellRecord>::const_iterator iter = mLastWrittenRecords.begin();
+         iter != mLastWrittenRecords.end();
+         ++iter)
+    {
+        const CellRecord& r_record = iter->second;
+        CheckpointStream::WriteValue(rStream, (boost::uint32_t)iter->first);
+        for (unsigned field=0; field<NUM_FIELDS; field++)
+        {
+            CheckpointStream::WriteValue(rStream, r_record.mValues[field]);
+        }
+        CheckpointStream::WriteValue(rStream, (unsigned char)r_record.mLabelled);
+        CheckpointStream::WriteValue(rStream, (boost::uint32_t)r_record.mNumEdges);
+        CheckpointStream::WriteValue(rStream, (boost::uint32_t)r_record.mNumNeighbours);
+        CheckpointStream::WriteArray(rStream, r_record.mNeighbourIds);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void XMLCellWriter<ELEMENT_DIM, SPACE_DIM>::LoadCheckpointState(std::istream& rStream)
+{
+    boost::uint64_t num_frames_written;
+    CheckpointStream::ReadValue(rStream, num_frames_written);
+    mNumFramesWritten = num_frames_written;
+
+    boost::uint64_t num_records;
+    CheckpointStream::ReadValue(rStream, num_records);
+    mLastWrittenRecords.clear();
+    for (unsigned i=0; i<num_records; i++)
+    {
+        boost::uint32_t cell_id;
+        CheckpointStream::ReadValue(rStream, cell_id);
+        CellRecord& r_record = mLastWrittenRecords[cell_id];
+        for (unsigned field=0; field<NUM_FIELDS; field++)
+        {
+            CheckpointStream::ReadValue(rStream, r_record.mValues[field]);
+        }
+        unsigned char labelled;
+        CheckpointStream::ReadValue(rStream, labelled);
+        r_record.mLabelled = (labelled != 0);
+        boost::uint32_t num_edges;
+        CheckpointStream::ReadValue(rStream, num_edges);
+        r_record.mNumEdges = num_edges;
+        boost::uint32_t num_neighbours;
+        CheckpointStream::ReadValue(rStream, num_neighbours);
+        r_record.mNumNeighbours = num_neighbours;
+        CheckpointStream::ReadArray(rStream, r_record.mNeighbourIds);
+    }
+}
 
 // Explicit instantiation
 template class XMLCellWriter<1,1>;
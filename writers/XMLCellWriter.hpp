@@ -10,13 +10,43 @@
  */
 
 #include <string>
+#include <map>
+#include <vector>
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
-#include "AbstractCellWriter.hpp"
+#include <boost/serialization/vector.hpp>
+#include "AbstractSampledCellWriter.hpp"
+#include "AbstractCheckpointable.hpp"
 
+/**
+ * Writes one <cell> element per cell per sample to cell_data.xml.
+ *
+ * By default every frame is a full frame. With SetDeltaEncoding(n), every n-th
+ * frame is a keyframe containing all cells and the frames in between only
+ * contain the cells whose fields moved beyond the per-field tolerances (or
+ * whose label, neighbours or number of edges changed) since they were last
+ * written, plus a <removed> element for each cell that has disappeared.
+ * scripts/reconstruct_cell_data.py rebuilds full frames from such a file.
+ * The last written records and the frame count are checkpointed, so a resumed
+ * run continues the keyframe schedule and delta baseline.
+ */
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-class XMLCellWriter : public AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>
+class XMLCellWriter : public AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM>, public AbstractCheckpointable
 {
+    public:
+        /** The continuous fields of a cell record, used to index the delta tolerances. */
+        enum Field
+        {
+            X = 0,
+            Y,
+            AREA,
+            TARGET_AREA,
+            ODE_AREA,
+            G,
+            PERIMETER,
+            NUM_FIELDS
+        };
+
     private:
         std::string mSimulationType;
         std::string mTypeList;
@@ -24,6 +54,42 @@ class XMLCellWriter : public AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>
         std::string mCellCycleModel;
         std::string mExtraSimInfo;
 
+        /** The values of one cell as last written. */
+        struct CellRecord
+        {
+            /** The continuous fields, indexed by Field. */
+            double mValues[NUM_FIELDS];
+            /** Whether the cell is labelled. */
+            bool mLabelled;
+            /** The number of edges of the cell's element. */
+            unsigned mNumEdges;
+            /** The number of neighbouring cells, kept even when their IDs are not written. */
+            unsigned mNumNeighbours;
+            /** The IDs of the neighbouring cells, in increasing location index order. */
+            std::vector<unsigned> mNeighbourIds;
+        };
+
+        /** Number of frames between keyframes, or 0 if every frame is a full frame. */
+        unsigned mKeyframeInterval;
+
+        /** Per-field tolerances for delta frames, indexed by Field. */
+        std::vector<double> mDeltaTolerances;
+
+        /** Whether to write the list of neighbouring cell IDs. Defaults to true. */
+        bool mOutputNeighbourIds;
+
+        /** The number of frames written so far. */
+        unsigned mNumFramesWritten;
+
+        /** Whether the current frame is a keyframe. */
+        bool mIsKeyframe;
+
+        /** The last written record of each cell, keyed by cell ID. Not archived, but checkpointed. */
+        std::map<unsigned, CellRecord> mLastWrittenRecords;
+
+        /** The IDs of the cells visited in the current frame. */
+        std::vector<unsigned> mVisitedCellIds;
+
         /** Needed for serialization. */
         friend class boost::serialization::access;
         /**
@@ -35,9 +101,19 @@ class XMLCellWriter : public AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>
         template<class Archive>
             void serialize(Archive & archive, const unsigned int version)
             {
-                archive & boost::serialization::base_object<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+                archive & boost::serialization::base_object<AbstractSampledCellWriter<ELEMENT_DIM, SPACE_DIM> >(*this);
+                archive & mKeyframeInterval;
+                archive & mDeltaTolerances;
+                archive & mOutputNeighbourIds;
             }
 
+        /**
+         * @param rOld the last written record of a cell
+         * @param rNew the current record of the cell
+         * @return whether the cell has changed enough to be written in a delta frame
+         */
+        bool HasChanged(const CellRecord& rOld, const CellRecord& rNew) const;
+
     public:
         XMLCellWriter();
 
@@ -51,9 +127,55 @@ class XMLCellWriter : public AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>
 
         double GetCellDataForVtkOutput(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
 
+        /**
+         * Switch on keyframe + delta output.
+         *
+         * @param keyframeInterval the number of frames between keyframes (1 writes only keyframes, 0 switches delta output off)
+         */
+        void SetDeltaEncoding(unsigned keyframeInterval);
+
+        /**
+         * Set the tolerance below which a change in one field does not cause a cell to be written in a delta frame.
+         *
+         * @param field the field
+         * @param tolerance the absolute tolerance
+         */
+        void SetDeltaTolerance(Field field, double tolerance);
+
+        /**
+         * Set whether to write each cell's list of neighbouring cell IDs. When the
+         * topology is recorded by TopologyEventWriter the lists are redundant and
+         * can be switched off; the number of neighbours is still written.
+         *
+         * @param outputNeighbourIds whether to write the neighbour lists
+         */
+        void SetOutputNeighbourIds(bool outputNeighbourIds);
+
+        /**
+         * Overridden GetBufferedBytes() method, which adds the last written
+         * record of each cell kept for delta frames.
+         *
+         * @return the heap bytes held by this writer between samples
+         */
+        unsigned long GetBufferedBytes() const;
+
+        /**
+         * Overridden SaveCheckpointState() method, which writes the frame count
+         * and the last written record of each cell.
+         *
+         * @param rStream the stream
+         */
+        void SaveCheckpointState(std::ostream& rStream) const;
+
+        /**
+         * Overridden LoadCheckpointState() method.
+         *
+         * @param rStream the stream
+         */
+        void LoadCheckpointState(std::istream& rStream);
 };
 
 #include "SerializationExportWrapper.hpp"
 EXPORT_TEMPLATE_CLASS_ALL_DIMS(XMLCellWriter)
 
-#endif
\ No newline at end of file
+#endif